@@ -52,6 +52,7 @@
 // 20240213 Added PM1.0 to Air Quality (Particulate Matter) Sensor decoder
 // 20240716 Fixed output of invalid battery state with 6-in-1 decoder
 // 20250127 Added Globe Thermometer Temperature (8-in-1 Weather Sensor)
+// 20261016 Accept DECODE_OK_CORRECTED
 //
 // ToDo: 
 // - 
@@ -92,7 +93,7 @@ void loop()
     // Timeout occurs after a small multiple of expected time-on-air.
     int decode_status = ws.getMessage();
 
-    if (decode_status == DECODE_OK) {
+    if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED)) {
         char batt_ok[] = "OK ";
         char batt_low[] = "Low";
         char batt_inv[] = "---";
@@ -236,6 +237,6 @@ void loop()
 
       }
     
-    } // if (decode_status == DECODE_OK)
+    } // if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED))
     delay(100);
 } // loop()
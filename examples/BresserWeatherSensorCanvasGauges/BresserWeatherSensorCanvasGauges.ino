@@ -59,6 +59,7 @@
 // History:
 // 20251003 Created
 // 20251128 Changed mDNS to work in both WiFi STA and WiFi AP mode
+// 20261016 Invalidate cached UTC offset of rain gauge after setting the time zone
 //
 // To Do:
 // - Improved page layout
@@ -303,6 +304,7 @@ void setup()
 
   setenv("TZ", tz, 1); // Set the time zone
   tzset();             // Apply the time zone
+  rainGauge.timezoneChanged(); // Invalidate cached UTC offset
 
 #ifndef WIFI_AP_MODE
   // Configure time with NTP
@@ -79,6 +79,7 @@
 // 20250712 Removed TLS fingerprint option (insecure)
 //          Improved MQTT "offline" status message handling (avoid inadvertent LWT message)
 // 20260221 Unified MQTT topic management using struct, hostname handling, and code style with other sketches
+// 20261016 Invalidate cached UTC offset of rain gauge after setting the time zone
 //
 // ToDo:
 //
@@ -483,6 +484,7 @@ void setup()
     // Set time zone
     setenv("TZ", TZ_INFO, 1);
     tzset();
+    rainGauge.timezoneChanged();
 
 #ifdef LED_EN
     // Configure LED output pins
@@ -57,6 +57,8 @@
 // History:
 //
 // 20260210 Created
+// 20261016 Accept DECODE_OK_CORRECTED
+//          Use WeatherSensor::sweepFrequency() - retune without begin(), adaptive dwell time
 //
 // ToDo: 
 // - 
@@ -72,21 +74,14 @@
 #define SCAN_START_OFFSET_KHZ  -250    // Start scanning at -250 kHz from base frequency
 #define SCAN_END_OFFSET_KHZ     250    // End scanning at +250 kHz from base frequency
 #define SCAN_STEP_KHZ           25     // Scan in 25 kHz steps
-#define SCAN_TIME_PER_FREQ_MS   60000  // Wait 60 seconds at each frequency for messages
-
-// Structure to store results for each frequency tested
-struct FreqTestResult {
-    double offset_mhz;      // Frequency offset in MHz
-    int message_count;      // Number of messages received
-    float max_rssi;         // Maximum RSSI value observed
-    float avg_rssi;         // Average RSSI value
-};
+#define SCAN_TIME_PER_FREQ_MS   60000  // Wait max. 60 seconds at each frequency for messages
+#define SCAN_MIN_DECODED        3      // Select next frequency after 3 decoded messages
 
 WeatherSensor ws;
 
 // Array to store scan results
 #define MAX_SCAN_POINTS ((SCAN_END_OFFSET_KHZ - SCAN_START_OFFSET_KHZ) / SCAN_STEP_KHZ + 1)
-FreqTestResult scanResults[MAX_SCAN_POINTS];
+WeatherSensor::SweepResult scanResults[MAX_SCAN_POINTS];
 int scanResultCount = 0;
 
 void setup() {
@@ -108,7 +103,7 @@ void setup() {
                   868.3 + (SCAN_START_OFFSET_KHZ/1000.0), 
                   868.3 + (SCAN_END_OFFSET_KHZ/1000.0));
     Serial.printf("Scan step: %d kHz\n", SCAN_STEP_KHZ);
-    Serial.printf("Time per frequency: %d seconds\n", SCAN_TIME_PER_FREQ_MS / 1000);
+    Serial.printf("Time per frequency: max. %d seconds or %d messages\n", SCAN_TIME_PER_FREQ_MS / 1000, SCAN_MIN_DECODED);
     Serial.println();
     Serial.println("Make sure your weather sensor is transmitting!");
     Serial.println("Most sensors transmit every 30-60 seconds.");
@@ -132,73 +127,18 @@ void performFrequencyScan() {
     Serial.println("========================================");
     Serial.println();
     
-    int currentResult = 0;
-    
-    for (int offset_khz = SCAN_START_OFFSET_KHZ; 
-         offset_khz <= SCAN_END_OFFSET_KHZ; 
-         offset_khz += SCAN_STEP_KHZ) {
-        
-        double offset_mhz = offset_khz / 1000.0;
-        
-        Serial.printf("Testing frequency offset: %+7d kHz (%.3f MHz) ... ",
-                      offset_khz, 868.3 + offset_mhz);
-        
-        // Initialize receiver with current frequency offset
-        // Use MAX_SENSORS_DEFAULT to support multiple sensors during calibration
-        if (ws.begin(MAX_SENSORS_DEFAULT, true, offset_mhz) != RADIOLIB_ERR_NONE) {
-            Serial.println("Failed to initialize receiver!");
-            continue;  // Skip to next frequency
-        }
-        
-        // Clear any previous sensor data
-        ws.clearSlots();
-        
-        // Statistics for this frequency
-        int msg_count = 0;
-        float rssi_sum = 0.0;
-        float max_rssi = -200.0;
-        
-        // Wait and collect messages at this frequency
-        unsigned long start_time = millis();
-        while (millis() - start_time < SCAN_TIME_PER_FREQ_MS) {
-            int decode_status = ws.getMessage();
-            
-            if (decode_status == DECODE_OK) {
-                msg_count++;
-                float rssi = ws.rssi;  // Use last packet RSSI instead of assuming sensor[0]
-                rssi_sum += rssi;
-                if (rssi > max_rssi) {
-                    max_rssi = rssi;
-                }
-                
-                // Show progress indicator
-                Serial.print(".");
-            }
-            
-            delay(10);  // Small delay to prevent tight loop
-        }
-        
-        // Store results
-        scanResults[currentResult].offset_mhz = offset_mhz;
-        scanResults[currentResult].message_count = msg_count;
-        scanResults[currentResult].max_rssi = max_rssi;
-        scanResults[currentResult].avg_rssi = (msg_count > 0) ? (rssi_sum / msg_count) : -200.0;
-        
-        // Display results for this frequency
-        if (msg_count > 0) {
-            Serial.printf(" Received: %2d messages, RSSI: max=%.1f dBm, avg=%.1f dBm\n",
-                          msg_count, max_rssi, scanResults[currentResult].avg_rssi);
-        } else {
-            Serial.println(" No messages received");
-        }
-        
-        currentResult++;
-        scanResultCount = currentResult;
-        
-        // Put radio to sleep before reinitializing
-        ws.sleep();
-        delay(100);
+    // Initialize receiver once - the sweep only changes the frequency
+    // Use MAX_SENSORS_DEFAULT to support multiple sensors during calibration
+    if (ws.begin(MAX_SENSORS_DEFAULT, true, 0.0) != RADIOLIB_ERR_NONE) {
+        Serial.println("Failed to initialize receiver!");
+        return;
     }
+    ws.clearSlots();
+    
+    scanResultCount = ws.sweepFrequency(scanResults, MAX_SCAN_POINTS,
+                                        SCAN_START_OFFSET_KHZ, SCAN_END_OFFSET_KHZ, SCAN_STEP_KHZ,
+                                        SCAN_TIME_PER_FREQ_MS, SCAN_MIN_DECODED);
+    ws.sleep();
     
     Serial.println();
 }
@@ -209,48 +149,35 @@ void analyzeResults() {
     Serial.println("========================================");
     Serial.println();
     
-    // Find best frequency based on message count and RSSI
-    int best_idx = -1;
-    int max_messages = 0;
-    float best_rssi = -200.0;
-    
-    Serial.println("Offset (kHz) | Frequency (MHz) | Messages | Max RSSI (dBm) | Avg RSSI (dBm)");
-    Serial.println("-------------|-----------------|----------|----------------|----------------");
+    Serial.println("Offset (kHz) | Frequency (MHz) | Messages | Errors | Max RSSI (dBm) | Avg RSSI (dBm) | Time (s)");
+    Serial.println("-------------|-----------------|----------|--------|----------------|----------------|---------");
     
     for (int i = 0; i < scanResultCount; i++) {
-        Serial.printf("%+7d      | %11.3f     | %8d | %14.1f | %14.1f\n",
-                      (int)(scanResults[i].offset_mhz * 1000),
-                      868.3 + scanResults[i].offset_mhz,
-                      scanResults[i].message_count,
-                      scanResults[i].max_rssi,
-                      scanResults[i].avg_rssi);
-        
-        // Determine best frequency
-        // Prioritize message count, then RSSI
-        if (scanResults[i].message_count > max_messages) {
-            max_messages = scanResults[i].message_count;
-            best_rssi = scanResults[i].avg_rssi;
-            best_idx = i;
-        } else if (scanResults[i].message_count == max_messages && 
-                   scanResults[i].avg_rssi > best_rssi) {
-            best_rssi = scanResults[i].avg_rssi;
-            best_idx = i;
-        }
+        Serial.printf("%+7d      | %11.3f     | %8d | %6d | %14.1f | %14.1f | %7lu\n",
+                      scanResults[i].offset_khz,
+                      868.3 + scanResults[i].offset_khz / 1000.0,
+                      scanResults[i].decoded,
+                      scanResults[i].errors,
+                      scanResults[i].rssi_max,
+                      scanResults[i].rssi_avg,
+                      (unsigned long)(scanResults[i].dwell_ms / 1000));
     }
     
+    // Center of the frequency range with successful reception
+    int best_offset_khz;
+    bool found = WeatherSensor::sweepBest(scanResults, scanResultCount, best_offset_khz);
+    
     Serial.println();
     Serial.println("========================================");
     Serial.println("Recommendation");
     Serial.println("========================================");
     Serial.println();
     
-    if (best_idx >= 0 && max_messages > 0) {
-        double best_offset = scanResults[best_idx].offset_mhz;
+    if (found) {
+        double best_offset = best_offset_khz / 1000.0;
         Serial.println("Based on the scan results:");
         Serial.printf("  Optimal frequency offset: %.3f MHz\n", best_offset);
         Serial.printf("  Optimal frequency: %.3f MHz\n", 868.3 + best_offset);
-        Serial.printf("  Messages received: %d\n", scanResults[best_idx].message_count);
-        Serial.printf("  Average RSSI: %.1f dBm\n", scanResults[best_idx].avg_rssi);
         Serial.println();
         Serial.println("To use this frequency offset in your sketch:");
         Serial.printf("  ws.begin(1, true, %.3f);\n", best_offset);
@@ -39,6 +39,7 @@
 // 20240325 Fake missing degree sign with small 'o', print only weather sensor data on LCD
 // 20240504 Added board initialization
 // 20241103 Added logging to SD card
+// 20261016 Accept DECODE_OK_CORRECTED
 //
 // Notes:
 // - The character set does not provide a degrees sign
@@ -177,7 +178,7 @@ void loop()
     int decode_status = ws.getData(RX_TIMEOUT, RX_FLAGS, 0, nullptr);
     uint8_t y = 10;
 
-    if (decode_status == DECODE_OK)
+    if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED))
     {
         if ((ws.sensor[i].s_type == SENSOR_TYPE_WEATHER0) || (ws.sensor[i].s_type == SENSOR_TYPE_WEATHER1) || (ws.sensor[i].s_type == SENSOR_TYPE_WEATHER3) || (ws.sensor[i].s_type == SENSOR_TYPE_WEATHER8))
         {
@@ -488,6 +489,6 @@ void loop()
                 setLed(false);
             }
         } // if time to log
-    } // if (decode_status == DECODE_OK)
+    } // if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED))
     delay(100);
 } // loop()
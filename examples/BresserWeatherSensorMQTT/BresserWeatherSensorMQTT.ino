@@ -134,6 +134,7 @@
 //          Improved MQTT "offline" status message handling (avoid inadvertent LWT message)
 // 20260221 Refactored MQTT topic declarations using MQTTTopics struct for cleaner
 //          organization and maintainability (replaces 13 individual declarations)
+// 20261016 Invalidate cached UTC offset of rain gauge/lightning after setting the time zone
 //
 // ToDo:
 //
@@ -523,6 +524,8 @@ void setup()
     // Set time zone
     setenv("TZ", TZ_INFO, 1);
     tzset();
+    rainGauge.timezoneChanged();
+    lightning.timezoneChanged();
     printDateTime();
 
 #ifdef LED_EN
@@ -118,6 +118,7 @@
 //          and add yield() to clientLoopWrapper to avoid WD-Resets when it takes longer
 // 20250712 Removed TLS fingerprint option (insecure)
 //          Improved MQTT "offline" status message handling (avoid inadvertent LWT message)
+// 20261016 Invalidate cached UTC offset of rain gauge/lightning after setting the time zone
 //
 // ToDo:
 //
@@ -732,6 +733,8 @@ void setup()
     // Set time zone
     setenv("TZ", TZ_INFO, 1);
     tzset();
+    rainGauge.timezoneChanged();
+    lightning.timezoneChanged();
     printDateTime();
 
 #ifdef LED_EN
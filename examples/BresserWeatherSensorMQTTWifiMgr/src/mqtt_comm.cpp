@@ -66,6 +66,8 @@
 // 20260510 Fixed HA device identifier collision: multiple sensors of the same type now each
 //          get a unique identifier derived from sensor_id.
 //          Added display_name to sensor_info: HA device name now uses sensor_map name when set.
+// 20261016 publishRadio(): Added decode error counters and per-sensor link quality statistics
+//          publishRadio(): Added noise floor and interference statistics
 //
 // ToDo:
 // -
@@ -423,15 +425,62 @@ void publishWeatherdata(bool complete, bool retain)
 
 // Publish radio receiver info as JSON string via MQTT
 // - RSSI: Received Signal Strength Indication
+// - Decode errors: parity, checksum, digest, not attributed to a sensor, during interference
+// - Noise floor and interference bursts (if supported by the transceiver)
+// - Link quality statistics per sensor (see WeatherSensor::getLinkStats())
 void publishRadio(void)
 {
     JsonDocument payload;
-    char mqtt_payload[32]; // {"rssi":-XXX.X} fits comfortably in 32 bytes
+    char mqtt_payload[PAYLOAD_SIZE];
     char mqtt_topic[256];  // same size as used in publishWeatherdata()
 
     snprintf(mqtt_topic, sizeof(mqtt_topic), "%s/%s", Hostname.c_str(), mqttTopics.pubRadio);
     payload["rssi"] = weatherSensor.rssi;
-    serializeJson(payload, mqtt_payload, sizeof(mqtt_payload));
+
+    JsonObject err = payload["err"].to<JsonObject>();
+    err["par"] = weatherSensor.errStats.par;
+    err["chk"] = weatherSensor.errStats.chk;
+    err["dig"] = weatherSensor.errStats.dig;
+    err["unk"] = weatherSensor.errStats.unattributed;
+    err["intf"] = weatherSensor.errStats.interference;
+
+    NoiseStats noise = weatherSensor.getNoiseStats();
+    if (noise.samples > 0)
+    {
+        JsonObject nf = payload["noise"].to<JsonObject>();
+        nf["floor"] = noise.floor_dbm;
+        nf["p90"] = noise.p90_dbm;
+        nf["bursts"] = noise.bursts;
+        nf["burst_ms"] = noise.burst_ms;
+    }
+
+    for (size_t i = 0; i < weatherSensor.sensor.size(); i++)
+    {
+        if (!weatherSensor.sensor[i].valid)
+            continue;
+
+        const LinkStats *stats = weatherSensor.getLinkStats(weatherSensor.sensor[i].sensor_id);
+        if (!stats)
+            continue;
+
+        char sensor_str[32];
+        sensorName(weatherSensor.sensor[i].sensor_id, sensor_str, sizeof(sensor_str));
+        JsonObject link = payload["link"][sensor_str].to<JsonObject>();
+        link["rssi_avg"] = roundf(stats->rssi_mean * 10) / 10;
+        link["rssi_std"] = roundf(stats->rssiStd() * 10) / 10;
+        link["rx"] = stats->received;
+        link["exp"] = stats->expected;
+        link["loss"] = roundf(stats->loss() * 10) / 10;
+        link["par"] = stats->par_err;
+        link["chk"] = stats->chk_err;
+        link["dig"] = stats->dig_err;
+    }
+
+    size_t payload_size = serializeJson(payload, mqtt_payload, sizeof(mqtt_payload));
+    if (payload_size >= sizeof(mqtt_payload) - 1)
+    {
+        log_e("mqtt_payload (%zu) >= sizeof(mqtt_payload) (%zu). Payload truncated!", payload_size, sizeof(mqtt_payload));
+    }
     log_i("%s: %s\n", mqtt_topic, mqtt_payload);
     client.publish(mqtt_topic, mqtt_payload, false, 0);
 }
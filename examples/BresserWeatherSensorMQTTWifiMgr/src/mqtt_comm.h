@@ -124,7 +124,9 @@ void publishWeatherdata(bool complete = false, bool retain = false);
 /*!
  * \brief Publish radio receiver info as JSON string via MQTT
  *
- * Publish RSSI: Received Signal Strength Indication
+ * Publish RSSI: Received Signal Strength Indication, decode error counters,
+ * noise floor statistics (see WeatherSensor::getNoiseStats()) and link quality
+ * statistics of each sensor (see WeatherSensor::getLinkStats())
  */
 void publishRadio(void);
 
@@ -46,6 +46,7 @@
 // 20240504 Added board initialization
 // 20250127 Added 8-in-1 Weather Sensor sample data
 // 20260224 Added High Precision Thermo Hygro Sensor (P/N 7009971) sample data
+// 20261016 Accept DECODE_OK_CORRECTED
 //
 // ToDo: 
 // - 
@@ -140,7 +141,7 @@ void loop()
     idx = (idx == 12) ? 0 : idx+1;
     Serial.printf("testData[%d]\n", idx);
 
-    if (decode_status == DECODE_OK) {
+    if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED)) {
         Serial.printf("Id: [%8X] Typ: [%X] Ch: [%d] St: [%d] Bat: [%-3s] RSSI: [%6.1fdBm] ",
             (unsigned int)ws.sensor[i].sensor_id,
             ws.sensor[i].s_type,
@@ -264,6 +265,6 @@ void loop()
             #endif
             Serial.printf("\n");
         }
-    } // if (decode_status == DECODE_OK)
+    } // if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED))
     delay(1000);
 } // loop()
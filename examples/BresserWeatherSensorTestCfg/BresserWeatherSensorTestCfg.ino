@@ -38,6 +38,8 @@
 //
 // 20240417 Created
 // 20240504 Added board initialization
+// 20261016 Changed buffer size to MAX_SENSOR_IDS and size to uint16_t,
+//          buffer is allocated on the heap
 //
 // ToDo: 
 // - 
@@ -52,7 +54,7 @@
 
 WeatherSensor ws;
 
-void printBuf(uint8_t *buf, uint8_t size) {
+void printBuf(uint8_t *buf, uint16_t size) {
         for (size_t i=0; i < size; i+=4) {
         Serial.printf("0x%08X\n", 
             (buf[i] << 24) |
@@ -78,23 +80,23 @@ void setup() {
     cfgPrefs.clear();
     cfgPrefs.end();
     cfgPrefs.begin("BWS-CFG", false);
-    uint8_t buf[48];
-    uint8_t size;
-    size = ws.getSensorsInc(buf);
-    printBuf(buf, size);
+    std::vector<uint8_t> buf(MAX_SENSOR_IDS * 4);
+    uint16_t size;
+    size = ws.getSensorsInc(buf.data());
+    printBuf(buf.data(), size);
     
     uint8_t id1[] = {0xDE, 0xAD, 0xBE, 0xEF};
     ws.setSensorsInc(id1, 4);
-    size = ws.getSensorsInc(buf);
-    printBuf(buf, size);
+    size = ws.getSensorsInc(buf.data());
+    printBuf(buf.data(), size);
 
-    size = ws.getSensorsExc(buf);
-    printBuf(buf, size);
+    size = ws.getSensorsExc(buf.data());
+    printBuf(buf.data(), size);
     
     uint8_t id2[] = {0xC0, 0xFF, 0xEE, 0x11};
     ws.setSensorsExc(id2, 4);
-    size = ws.getSensorsExc(buf);
-    printBuf(buf, size);
+    size = ws.getSensorsExc(buf.data());
+    printBuf(buf.data(), size);
     cfgPrefs.clear();
     cfgPrefs.end();
 
@@ -53,6 +53,7 @@
 // History:
 //
 // 20240306 Created
+// 20261016 Accept DECODE_OK_CORRECTED
 //
 // ToDo: 
 // - 
@@ -130,7 +131,7 @@ void loop()
     // Timeout occurs after a small multiple of expected time-on-air.
     int decode_status = ws.getMessage();
 
-    if (decode_status == DECODE_OK) {
+    if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED)) {
         char buf[44];
         Serial.printf("Heading: [%3.0f°] Id: [%8X] Typ: [%X] Ch: [%d] St: [%d] Bat: [%-3s] RSSI: [%6.1fdBm]\n",
             heading,
@@ -161,6 +162,6 @@ void loop()
         display.setTextSize(2);              // Draw 2X-scale text
         display.println(buf);
         display.display();
-    } // if (decode_status == DECODE_OK)
+    } // if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED))
     delay(100);
 } // loop()
@@ -0,0 +1,264 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ArrivalPredictor.h
+//
+// Prediction of sensor transmission times from observed arrivals
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _ARRIVALPREDICTOR_H
+#define _ARRIVALPREDICTOR_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * \class ArrivalPredictor
+ *
+ * \brief Learns the transmit interval of each sensor and predicts its next transmission
+ *
+ * For each sensor ID, the time of the last transmission, an interval estimate and the
+ * jitter (mean absolute deviation) are tracked. Missed transmissions are recognized as
+ * multiples of the interval. Arrivals within 'burst' ms of the last one belong to the
+ * same transmission and are ignored. A new interval is only derived from two receptions
+ * at most 'max_interval' ms apart, because a longer gap could be any multiple of it.
+ *
+ * The class has no constructor - an all-zero object is empty - so it can be placed in
+ * memory which is retained during deep sleep (e.g. RTC_DATA_ATTR) as long as the time
+ * base continues running.
+ *
+ * \tparam N    number of sensors tracked (least recently seen sensor is replaced)
+ */
+template <unsigned N>
+class ArrivalPredictor
+{
+public:
+    /**
+     * \struct Entry
+     *
+     * \brief Arrival statistics of one sensor
+     */
+    struct Entry
+    {
+        uint32_t id;        //!< sensor ID
+        uint32_t last;      //!< time of last transmission in ms
+        uint32_t interval;  //!< interval estimate in ms (0: unknown)
+        uint32_t jitter;    //!< mean absolute deviation from interval in ms
+        uint16_t count;     //!< number of transmissions received (0: entry unused)
+        uint16_t missed;    //!< number of transmissions missed
+        uint8_t type;       //!< sensor type
+        uint8_t lost;       //!< consecutive receive windows without reception (see miss())
+    };
+
+    /**
+     * \brief Remove all entries
+     */
+    void clear(void)
+    {
+        memset(entry, 0, sizeof(entry));
+    }
+
+    /**
+     * \brief Update statistics with received transmission
+     *
+     * \param id        sensor ID
+     * \param type      sensor type
+     * \param now       time of reception in ms
+     * \param burst     time window in ms for repetitions of the same transmission
+     * \param max_interval  maximum time in ms between two receptions to derive a new interval
+     */
+    void update(uint32_t id, uint8_t type, uint32_t now, uint32_t burst = 2000, uint32_t max_interval = 120000)
+    {
+        Entry *e = nullptr;
+        Entry *victim = &entry[0];
+        for (unsigned i = 0; i < N; i++)
+        {
+            if (entry[i].count && (entry[i].id == id))
+            {
+                e = &entry[i];
+                break;
+            }
+            if (victim->count && (!entry[i].count || (static_cast<int32_t>(entry[i].last - victim->last) < 0)))
+                victim = &entry[i];
+        }
+
+        if (!e)
+        {
+            memset(victim, 0, sizeof(*victim));
+            victim->id = id;
+            victim->type = type;
+            victim->last = now;
+            victim->count = 1;
+            return;
+        }
+
+        uint32_t delta = now - e->last;
+        if (delta < burst)
+            return;
+
+        e->lost = 0;
+        e->type = type;
+        e->last = now;
+        if (e->count < 0xFFFF)
+            e->count++;
+
+        // First interval or significantly shorter interval than estimated
+        // (e.g. previous estimate was a multiple of the real interval)
+        if ((e->interval == 0) || (delta < e->interval - e->interval / 4))
+        {
+            if (delta > max_interval)
+                return;
+            e->interval = delta;
+            e->jitter = 0;
+            return;
+        }
+
+        // Number of intervals since last reception
+        uint32_t k = (delta + e->interval / 2) / e->interval;
+        if (k > 1)
+        {
+            uint32_t missed = e->missed + k - 1;
+            e->missed = (missed < 0xFFFF) ? missed : 0xFFFF;
+        }
+
+        int32_t err = static_cast<int32_t>(delta / k) - static_cast<int32_t>(e->interval);
+        uint32_t abs_err = (err < 0) ? -err : err;
+        e->interval += err / 4;
+        e->jitter = e->jitter + (static_cast<int32_t>(abs_err) - static_cast<int32_t>(e->jitter)) / 4;
+    }
+
+    /**
+     * \brief Report that a transmission was not received in its predicted receive window
+     *
+     * After 'max_lost' consecutive misses, the prediction is considered wrong (e.g. the
+     * sensor's transmit time has shifted) and the sensor's entry is removed, i.e. its
+     * interval has to be learned again.
+     *
+     * \param id        sensor ID
+     * \param max_lost  maximum number of consecutive misses
+     */
+    void miss(uint32_t id, uint8_t max_lost = 2)
+    {
+        for (unsigned i = 0; i < N; i++)
+        {
+            Entry &e = entry[i];
+            if (!e.count || (e.id != id))
+                continue;
+
+            // Forget sensor - treated as new sensor on next reception
+            if (++e.lost >= max_lost)
+                memset(&e, 0, sizeof(e));
+            return;
+        }
+    }
+
+    /**
+     * \brief Find entry by sensor ID
+     *
+     * \param id    sensor ID
+     *
+     * \returns entry or nullptr if not found
+     */
+    const Entry *find(uint32_t id) const
+    {
+        for (unsigned i = 0; i < N; i++)
+        {
+            if (entry[i].count && (entry[i].id == id))
+                return &entry[i];
+        }
+        return nullptr;
+    }
+
+    /**
+     * \brief Predict next transmission
+     *
+     * The guard time around the predicted arrival grows with the jitter and the number
+     * of intervals since the last reception (limited to half an interval).
+     * If the window around the previous predicted transmission is still open, this
+     * transmission is returned.
+     *
+     * \param e         entry
+     * \param now       current time in ms
+     * \param min_guard minimum guard time in ms
+     * \param next      time of next transmission in ms
+     * \param guard     guard time in ms (window: next - guard ... next + guard)
+     *
+     * \returns false if there is no interval estimate yet
+     */
+    static bool predict(const Entry &e, uint32_t now, uint32_t min_guard, uint32_t &next, uint32_t &guard)
+    {
+        if ((e.count < 2) || (e.interval == 0))
+            return false;
+
+        uint32_t k = (now - e.last) / e.interval + 1;
+        guard = windowGuard(e, k, min_guard);
+        if ((k > 1) && ((now - e.last) < (k - 1) * e.interval + windowGuard(e, k - 1, min_guard)))
+        {
+            k--;
+            guard = windowGuard(e, k, min_guard);
+        }
+        next = e.last + k * e.interval;
+        return true;
+    }
+
+    /**
+     * \brief Number of entries
+     */
+    unsigned size(void) const
+    {
+        return N;
+    }
+
+    /**
+     * \brief Entry by index (unused if count == 0)
+     */
+    const Entry &operator[](unsigned i) const
+    {
+        return entry[i];
+    }
+
+private:
+    static uint32_t windowGuard(const Entry &e, uint32_t k, uint32_t min_guard)
+    {
+        uint32_t guard = min_guard + (2 + k) * e.jitter;
+        return (guard < e.interval / 2) ? guard : e.interval / 2;
+    }
+
+    Entry entry[N];
+};
+
+#endif // _ARRIVALPREDICTOR_H
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BcdUtils.h
+//
+// Packed BCD field extraction, validation and conversion for Bresser sensor messages
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BCDUTILS_H
+#define _BCDUTILS_H
+
+#include <stdint.h>
+
+// A packed BCD word holds up to 8 digits, least significant digit in bits 3..0.
+// All operations work on the complete word at once (SWAR - SIMD within a register).
+
+/**
+ * \brief Extract a run of consecutive BCD digits from a message
+ *
+ * Digits are read most significant first, starting at nibble index 'pos'
+ * (nibble 0 is the high nibble of msg[0], nibble 1 its low nibble).
+ * Each message byte is XORed with 'xorMask' while reading, i.e. inverted (0xff)
+ * or whitened (0xaa) data can be extracted without a de-whitening pass.
+ *
+ * Restriction: (pos & 1) + digits <= 8
+ *
+ * \param msg       message buffer
+ * \param pos       nibble index of most significant digit
+ * \param digits    number of digits
+ * \param xorMask   mask applied to each message byte
+ *
+ * \returns packed BCD word
+ */
+constexpr uint32_t bcd_field(const uint8_t *msg, unsigned pos, unsigned digits, uint8_t xorMask = 0)
+{
+    uint32_t w = 0;
+    unsigned end = pos + digits;
+    for (unsigned i = pos >> 1; i < ((end + 1) >> 1); i++)
+    {
+        w = (w << 8) | static_cast<uint8_t>(msg[i] ^ xorMask);
+    }
+    if (end & 1)
+    {
+        w >>= 4;
+    }
+    return (digits < 8) ? (w & ((static_cast<uint32_t>(1) << (4 * digits)) - 1)) : w;
+}
+
+/**
+ * \brief Check if all digits of a packed BCD word are in the range 0..9
+ *
+ * A nibble is > 9 if bit 3 and bit 2 or bit 1 are set.
+ * Unused (zero) digits are always valid.
+ *
+ * \param w     packed BCD word
+ *
+ * \returns true if all digits are valid
+ */
+constexpr bool bcd_valid(uint32_t w)
+{
+    return (w & ((w << 1) | (w << 2)) & 0x88888888UL) == 0;
+}
+
+/**
+ * \brief Convert packed BCD word to binary
+ *
+ * Digits are combined pairwise (x10), then in groups of four (x100) and finally
+ * in groups of eight (x10000). The result is sum(digit[i] * 10^i) even for
+ * digits > 9, i.e. identical to the usual expression
+ * (msg[n] >> 4) * 100 + (msg[n] & 0x0f) * 10 + ...
+ *
+ * \param w     packed BCD word
+ *
+ * \returns binary value
+ */
+constexpr uint32_t bcd_value(uint32_t w)
+{
+    w = (w & 0x0F0F0F0FUL) + ((w >> 4) & 0x0F0F0F0FUL) * 10;    // 4 x 0..165
+    w = (w & 0x00FF00FFUL) + ((w >> 8) & 0x00FF00FFUL) * 100;   // 2 x 0..16665
+    return (w & 0xFFFFUL) + (w >> 16) * 10000;
+}
+
+/**
+ * \brief Extract a run of consecutive BCD digits from a message and convert it to binary
+ *
+ * See bcd_field() and bcd_value().
+ *
+ * \param msg       message buffer
+ * \param pos       nibble index of most significant digit
+ * \param digits    number of digits
+ * \param xorMask   mask applied to each message byte
+ *
+ * \returns binary value
+ */
+constexpr uint32_t bcd_decode(const uint8_t *msg, unsigned pos, unsigned digits, uint8_t xorMask = 0)
+{
+    return bcd_value(bcd_field(msg, pos, digits, xorMask));
+}
+
+#endif // _BCDUTILS_H
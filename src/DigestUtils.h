@@ -0,0 +1,619 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// DigestUtils.h
+//
+// Data integrity check functions for Bresser sensor messages
+// (LFSR-16 digest, CRC16, inverted copy parity, bit count checksum)
+// and error correction by LFSR-16 digest syndromes
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+// Based on:
+// ---------
+// rtl433 by Benjamin Larsson (https://github.com/merbanan/rtl_433)
+//     - https://github.com/merbanan/rtl_433/blob/master/src/util.c
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created from WeatherSensor::lfsr_digest16() and WeatherSensor::crc16()
+//          Added nibble-wise lookup tables generated at compile time
+//          Added inverted_copy_check() and count_bits() (5-in-1)
+//          Added Lfsr16Syndrome (error correction)
+//          Added inverted_copy_errors() and repair_inverted_copy()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DIGESTUTILS_H
+#define _DIGESTUTILS_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * \brief Linear Feedback Shift Register - Digest16, bit-by-bit reference implementation
+ *
+ * From rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/util.c
+ *
+ * \param message   message buffer
+ * \param bytes     number of bytes
+ * \param gen       generator polynomial
+ * \param key       initial key
+ *
+ * \returns digest
+ */
+inline uint16_t lfsr_digest16_bitwise(uint8_t const message[], unsigned bytes, uint16_t gen, uint16_t key)
+{
+    uint16_t sum = 0;
+    for (unsigned k = 0; k < bytes; ++k)
+    {
+        uint8_t data = message[k];
+        for (int i = 7; i >= 0; --i)
+        {
+            // if data bit is set then xor with key
+            if ((data >> i) & 1)
+                sum ^= key;
+
+            // roll the key right (actually the lsb is dropped here)
+            // and apply the gen (needs to include the dropped lsb as msb)
+            if (key & 1)
+                key = (key >> 1) ^ gen;
+            else
+                key = (key >> 1);
+        }
+    }
+    return sum;
+}
+
+/**
+ * \brief CRC16 (MSB first), bit-by-bit reference implementation
+ *
+ * From rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/util.c
+ *
+ * \param message       message buffer
+ * \param nBytes        number of bytes
+ * \param polynomial    polynomial
+ * \param init          initial value
+ *
+ * \returns CRC16
+ */
+inline uint16_t crc16_bitwise(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init)
+{
+    uint16_t remainder = init;
+
+    for (unsigned byte = 0; byte < nBytes; ++byte)
+    {
+        remainder ^= message[byte] << 8;
+        for (unsigned bit = 0; bit < 8; ++bit)
+        {
+            if (remainder & 0x8000)
+            {
+                remainder = (remainder << 1) ^ polynomial;
+            }
+            else
+            {
+                remainder = (remainder << 1);
+            }
+        }
+    }
+    return remainder;
+}
+
+/**
+ * \class Lfsr16Table
+ *
+ * \brief Table driven LFSR-16 digest for a fixed generator and key
+ *
+ * The digest is the XOR of the key states k_i for all set message bits d_i:
+ *
+ *   sum = d_0 * k_0 ^ d_1 * k_1 ^ ... with k_(i+1) = A(k_i)
+ *
+ * A() (roll right and apply gen) is linear, so the sum can be evaluated with
+ * Horner's scheme from the last message bit towards the first:
+ *
+ *   v = A(v) ^ d_i * key
+ *
+ * This has the same structure as a (reflected) CRC. Processing one nibble at a time:
+ *
+ *   v = A^4(v) ^ keyTab[nibble]
+ *   A^4(v) = (v >> 4) ^ shiftTab[v & 0xF]
+ *
+ * Both tables (16 entries each) are generated at compile time. The message is
+ * processed from the last byte to the first, low nibble before high nibble.
+ *
+ * \tparam Gen  generator polynomial
+ * \tparam Key  initial key
+ */
+template <uint16_t Gen, uint16_t Key>
+class Lfsr16Table
+{
+public:
+    /**
+     * \brief Calculate digest
+     *
+     * Result is identical to lfsr_digest16_bitwise(message, bytes, Gen, Key).
+     *
+     * \param message   message buffer
+     * \param bytes     number of bytes
+     *
+     * \returns digest
+     */
+    static uint16_t digest(uint8_t const message[], unsigned bytes)
+    {
+        uint16_t v = 0;
+        while (bytes--)
+        {
+            uint8_t data = message[bytes];
+            v = (v >> 4) ^ tab.shift[v & 0xF] ^ tab.key[data & 0xF];
+            v = (v >> 4) ^ tab.shift[v & 0xF] ^ tab.key[data >> 4];
+        }
+        return v;
+    }
+
+private:
+    // Roll key right by one bit and apply generator
+    static constexpr uint16_t roll(uint16_t k)
+    {
+        return (k & 1) ? ((k >> 1) ^ Gen) : (k >> 1);
+    }
+
+    struct Tables
+    {
+        uint16_t shift[16]; //!< A^4() applied to the low nibble
+        uint16_t key[16];   //!< digest of a single nibble (MSB first) with key 'Key'
+
+        constexpr Tables() : shift(), key()
+        {
+            for (unsigned n = 0; n < 16; n++)
+            {
+                uint16_t s = n;
+                for (int i = 0; i < 4; i++)
+                    s = roll(s);
+                shift[n] = s;
+
+                uint16_t k = Key;
+                uint16_t sum = 0;
+                for (int i = 3; i >= 0; i--)
+                {
+                    if ((n >> i) & 1)
+                        sum ^= k;
+                    k = roll(k);
+                }
+                key[n] = sum;
+            }
+        }
+    };
+
+    static constexpr Tables tab{};
+};
+
+template <uint16_t Gen, uint16_t Key>
+constexpr typename Lfsr16Table<Gen, Key>::Tables Lfsr16Table<Gen, Key>::tab;
+
+/**
+ * \class Lfsr16Syndrome
+ *
+ * \brief Bit error correction for frames protected by an LFSR-16 digest
+ *
+ * The frame consists of the 16-bit check word (MSB first) followed by 'Bytes' data bytes.
+ * Since the digest is linear, a received frame with error pattern e yields the syndrome
+ *
+ *   check ^ digest(data) [^ final xor] = digest(e_data) ^ e_check
+ *
+ * A single bit error at data bit i results in the key state k_i, a single bit error in
+ * the check word in the flipped bit itself. A table of these syndromes, sorted for binary
+ * search, is generated at compile time. Two bit errors are located by searching the
+ * partner of each table entry. Syndromes which match more than one error pattern are
+ * not corrected.
+ *
+ * The corrected frame must be validated by other means (checksum, plausibility) since
+ * any frame with a matching syndrome will be "corrected".
+ *
+ * \tparam Gen      generator polynomial
+ * \tparam Key      initial key
+ * \tparam Bytes    number of data bytes covered by the digest
+ */
+template <uint16_t Gen, uint16_t Key, unsigned Bytes>
+class Lfsr16Syndrome
+{
+public:
+    static constexpr unsigned BITS = 16 + Bytes * 8; //!< number of bit positions in frame
+
+    /**
+     * \brief Locate and correct bit errors
+     *
+     * \param frame     check word (2 bytes) followed by data (modified in place)
+     * \param syndrome  received check word XOR calculated digest (and final XOR value, if any)
+     * \param maxBits   maximum number of bit errors to be corrected (1 or 2)
+     *
+     * \returns number of bits corrected, 0 if not correctable
+     */
+    static unsigned correct(uint8_t frame[], uint16_t syndrome, unsigned maxBits)
+    {
+        if ((syndrome == 0) || (maxBits == 0))
+            return 0;
+
+        int pos = find(syndrome);
+        if (pos >= 0)
+        {
+            flip(frame, pos);
+            return 1;
+        }
+        if ((pos == AMBIGUOUS) || (maxBits < 2))
+            return 0;
+
+        // Two bit errors: syndrome = s_a ^ s_b, pattern must be unique
+        int pa = -1;
+        int pb = -1;
+        for (unsigned i = 0; i < BITS; i++)
+        {
+            int j = find(syndrome ^ tab.e[i].syndrome);
+            if (j == AMBIGUOUS)
+                return 0;
+            if (j > tab.e[i].pos)
+            {
+                if (pa >= 0)
+                    return 0;
+                pa = tab.e[i].pos;
+                pb = j;
+            }
+        }
+        if (pa < 0)
+            return 0;
+        flip(frame, pa);
+        flip(frame, pb);
+        return 2;
+    }
+
+private:
+    static constexpr int NOT_FOUND = -1;
+    static constexpr int AMBIGUOUS = -2;
+
+    static_assert(BITS <= 256, "Bit position must fit into uint8_t");
+
+    static void flip(uint8_t frame[], unsigned pos)
+    {
+        frame[pos >> 3] ^= 0x80 >> (pos & 7);
+    }
+
+    // Binary search for syndrome, returns bit position, NOT_FOUND or AMBIGUOUS
+    static int find(uint16_t syndrome)
+    {
+        unsigned lo = 0;
+        unsigned hi = BITS;
+        while (lo < hi)
+        {
+            unsigned mid = (lo + hi) / 2;
+            if (tab.e[mid].syndrome < syndrome)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if ((lo == BITS) || (tab.e[lo].syndrome != syndrome))
+            return NOT_FOUND;
+        if ((lo + 1 < BITS) && (tab.e[lo + 1].syndrome == syndrome))
+            return AMBIGUOUS;
+        return tab.e[lo].pos;
+    }
+
+    struct Entry
+    {
+        uint16_t syndrome;
+        uint8_t pos;
+    };
+
+    struct Tables
+    {
+        Entry e[BITS]; //!< syndromes of single bit errors, sorted
+
+        constexpr Tables() : e()
+        {
+            // Check word
+            for (unsigned i = 0; i < 16; i++)
+            {
+                e[i].syndrome = 0x8000 >> i;
+                e[i].pos = i;
+            }
+            // Data
+            uint16_t k = Key;
+            for (unsigned i = 16; i < BITS; i++)
+            {
+                e[i].syndrome = k;
+                e[i].pos = i;
+                k = (k & 1) ? ((k >> 1) ^ Gen) : (k >> 1);
+            }
+            // Insertion sort
+            for (unsigned i = 1; i < BITS; i++)
+            {
+                Entry x = e[i];
+                unsigned j = i;
+                while ((j > 0) && (e[j - 1].syndrome > x.syndrome))
+                {
+                    e[j] = e[j - 1];
+                    j--;
+                }
+                e[j] = x;
+            }
+        }
+    };
+
+    static constexpr Tables tab{};
+};
+
+template <uint16_t Gen, uint16_t Key, unsigned Bytes>
+constexpr typename Lfsr16Syndrome<Gen, Key, Bytes>::Tables Lfsr16Syndrome<Gen, Key, Bytes>::tab;
+
+/**
+ * \class Crc16Table
+ *
+ * \brief Table driven CRC16 (MSB first) for a fixed polynomial
+ *
+ * Processes one nibble per step using a 16-entry table generated at compile time.
+ *
+ * \tparam Poly polynomial
+ */
+template <uint16_t Poly>
+class Crc16Table
+{
+public:
+    /**
+     * \brief Calculate CRC16
+     *
+     * Result is identical to crc16_bitwise(message, nBytes, Poly, init).
+     *
+     * \param message   message buffer
+     * \param nBytes    number of bytes
+     * \param init      initial value
+     *
+     * \returns CRC16
+     */
+    static uint16_t crc(uint8_t const message[], unsigned nBytes, uint16_t init)
+    {
+        uint16_t remainder = init;
+        for (unsigned i = 0; i < nBytes; i++)
+        {
+            uint8_t data = message[i];
+            remainder = (remainder << 4) ^ tab.v[(remainder >> 12) ^ (data >> 4)];
+            remainder = (remainder << 4) ^ tab.v[(remainder >> 12) ^ (data & 0xF)];
+        }
+        return remainder;
+    }
+
+private:
+    struct Tables
+    {
+        uint16_t v[16]; //!< remainder of upper nibble
+
+        constexpr Tables() : v()
+        {
+            for (unsigned n = 0; n < 16; n++)
+            {
+                uint16_t r = n << 12;
+                for (int i = 0; i < 4; i++)
+                    r = (r & 0x8000) ? ((r << 1) ^ Poly) : (r << 1);
+                v[n] = r;
+            }
+        }
+    };
+
+    static constexpr Tables tab{};
+};
+
+template <uint16_t Poly>
+constexpr typename Crc16Table<Poly>::Tables Crc16Table<Poly>::tab;
+
+/**
+ * \brief Count bits set in a 32-bit word
+ *
+ * Uses the popcount instruction if available, SWAR bit counting otherwise
+ * (none of the supported MCUs provides a popcount instruction).
+ *
+ * \param v     value
+ *
+ * \returns number of bits set
+ */
+inline unsigned popcount32(uint32_t v)
+{
+#if defined(__GNUC__) && defined(__POPCNT__)
+    return __builtin_popcount(v);
+#else
+    v = v - ((v >> 1) & 0x55555555UL);
+    v = (v & 0x33333333UL) + ((v >> 2) & 0x33333333UL);
+    v = (v + (v >> 4)) & 0x0F0F0F0FUL;
+    return static_cast<uint32_t>(v * 0x01010101UL) >> 24;
+#endif
+}
+
+/**
+ * \brief Count bits set in a message (e.g. 5-in-1 checksum)
+ *
+ * Processes 32-bit words, remaining bytes are handled separately.
+ *
+ * \param message   message buffer
+ * \param nBytes    number of bytes
+ *
+ * \returns number of bits set
+ */
+inline unsigned count_bits(uint8_t const message[], unsigned nBytes)
+{
+    unsigned bits = 0;
+    unsigned i = 0;
+    for (; i + 4 <= nBytes; i += 4)
+    {
+        uint32_t w;
+        memcpy(&w, &message[i], 4);
+        bits += popcount32(w);
+    }
+    if (i < nBytes)
+    {
+        uint32_t w = 0;
+        memcpy(&w, &message[i], nBytes - i);
+        bits += popcount32(w);
+    }
+    return bits;
+}
+
+/**
+ * \brief Check that the first 'n' bytes of a message are the inverse of the following 'n' bytes
+ *
+ * The halves are compared as 32-bit words; the byte-wise comparison is only used
+ * to locate the first mismatch. Messages from other sensors mostly fail at the
+ * first byte, which is therefore checked up front.
+ *
+ * \param message   message buffer (2 * n bytes)
+ * \param n         number of bytes per half
+ *
+ * \returns -1 if o.k., otherwise index of first mismatching byte
+ */
+inline int inverted_copy_check(uint8_t const message[], unsigned n)
+{
+    if ((n > 0) && ((message[0] ^ message[n]) != 0xff))
+        return 0;
+
+    unsigned i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32_t a, b;
+        memcpy(&a, &message[i], 4);
+        memcpy(&b, &message[i + n], 4);
+        if ((a ^ b) != 0xFFFFFFFFUL)
+            break;
+    }
+    for (; i < n; i++)
+    {
+        if ((message[i] ^ message[i + n]) != 0xff)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * \brief Count bytes in the first half of a message which are not the inverse of the second half
+ *
+ * \param message   message buffer (2 * n bytes)
+ * \param n         number of bytes per half
+ * \param limit     stop counting after limit + 1 errors
+ *
+ * \returns number of mismatching bytes (at most limit + 1)
+ */
+inline unsigned inverted_copy_errors(uint8_t const message[], unsigned n, unsigned limit)
+{
+    unsigned errors = 0;
+    for (unsigned i = 0; (i < n) && (errors <= limit); i++)
+    {
+        if ((message[i] ^ message[i + n]) != 0xff)
+            errors++;
+    }
+    return errors;
+}
+
+/**
+ * \brief Repair a message consisting of data and its inverted copy
+ *
+ * For each mismatching column (message[i] vs. message[i + n]), either copy may be the
+ * correct one. All combinations are tried; the message is repaired if exactly one of
+ * them is accepted by 'valid' (e.g. checksum and plausibility check).
+ *
+ * \param message   message buffer (2 * n bytes), modified in place if repaired
+ * \param n         number of bytes per half
+ * \param maxCols   maximum number of mismatching columns (<= 8)
+ * \param valid     function object, bool valid(const uint8_t *message)
+ *
+ * \returns number of repaired columns or -1 if not repairable
+ */
+template <typename F>
+int repair_inverted_copy(uint8_t message[], unsigned n, unsigned maxCols, F valid)
+{
+    unsigned cols[8];
+    uint8_t first[8];
+    unsigned m = 0;
+
+    if (maxCols > 8)
+        maxCols = 8;
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        if ((message[i] ^ message[i + n]) != 0xff)
+        {
+            if (m == maxCols)
+                return -1;
+            cols[m] = i;
+            first[m] = message[i];
+            m++;
+        }
+    }
+    if (m == 0)
+        return 0;
+
+    // Bit k of 'sel' set: first half of column k is correct, otherwise second half
+    uint8_t second[8];
+    for (unsigned k = 0; k < m; k++)
+        second[k] = message[cols[k] + n];
+
+    int found = -1;
+    for (unsigned sel = 0; sel < (1U << m); sel++)
+    {
+        for (unsigned k = 0; k < m; k++)
+        {
+            uint8_t v = ((sel >> k) & 1) ? first[k] : static_cast<uint8_t>(~second[k]);
+            message[cols[k]] = v;
+            message[cols[k] + n] = ~v;
+        }
+        if (valid(static_cast<const uint8_t *>(message)))
+        {
+            if (found >= 0)
+            {
+                found = -2;
+                break;
+            }
+            found = sel;
+        }
+    }
+
+    if (found < 0)
+    {
+        // Not repairable or ambiguous - restore message
+        for (unsigned k = 0; k < m; k++)
+        {
+            message[cols[k]] = first[k];
+            message[cols[k] + n] = second[k];
+        }
+        return -1;
+    }
+
+    for (unsigned k = 0; k < m; k++)
+    {
+        uint8_t v = ((found >> k) & 1) ? first[k] : static_cast<uint8_t>(~second[k]);
+        message[cols[k]] = v;
+        message[cols[k] + n] = ~v;
+    }
+    return m;
+}
+
+#endif // _DIGESTUTILS_H
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FrameCache.h
+//
+// Cache of recently decoded frames for suppression of repeated transmissions
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FRAMECACHE_H
+#define _FRAMECACHE_H
+
+#include <stdint.h>
+
+/**
+ * \class FrameCache
+ *
+ * \brief Cache of recently decoded frames
+ *
+ * Bresser sensors send bursts of identical frames. The hashes of frames which have
+ * been decoded successfully are kept for a short time together with the index of the
+ * sensor data slot they were stored to, so identical repetitions can be recognized
+ * without decoding them again.
+ *
+ * Frames are compared by a 32-bit FNV-1a hash; with a few entries and a short time window,
+ * the probability of a false match is negligible.
+ *
+ * \tparam Depth    number of cached frames
+ */
+template <unsigned Depth = 8>
+class FrameCache
+{
+public:
+    /**
+     * \brief Constructor
+     *
+     * \param window_ms     maximum age of cached frames in ms
+     */
+    FrameCache(uint32_t window_ms = 1000) : window(window_ms)
+    {
+        clear();
+    }
+
+    /**
+     * \brief Remove all cached frames
+     */
+    void clear(void)
+    {
+        for (unsigned i = 0; i < Depth; i++)
+            entry[i].slot = -1;
+    }
+
+    /**
+     * \brief Calculate frame hash (32-bit FNV-1a)
+     *
+     * \param frame     frame buffer
+     * \param len       frame length in bytes
+     *
+     * \returns hash
+     */
+    static uint32_t hash(const uint8_t *frame, unsigned len)
+    {
+        uint32_t h = 2166136261UL;
+        for (unsigned i = 0; i < len; i++)
+        {
+            h ^= frame[i];
+            h *= 16777619UL;
+        }
+        return h;
+    }
+
+    /**
+     * \brief Look up frame in cache
+     *
+     * \param h         frame hash
+     * \param now       current time in ms
+     * \param id        sensor ID stored with frame (only valid if found)
+     *
+     * \returns sensor data slot stored with frame or -1 if not found
+     */
+    int find(uint32_t h, uint32_t now, uint32_t &id)
+    {
+        for (unsigned i = 0; i < Depth; i++)
+        {
+            Entry &e = entry[i];
+            if (e.slot < 0)
+                continue;
+            if ((now - e.time) > window)
+            {
+                e.slot = -1;
+                continue;
+            }
+            if (e.hash == h)
+            {
+                id = e.id;
+                return e.slot;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * \brief Insert frame into cache (replaces oldest entry if full)
+     *
+     * \param h         frame hash
+     * \param now       current time in ms
+     * \param slot      sensor data slot
+     * \param id        sensor ID
+     */
+    void insert(uint32_t h, uint32_t now, int slot, uint32_t id)
+    {
+        unsigned victim = 0;
+        for (unsigned i = 0; i < Depth; i++)
+        {
+            if (entry[i].slot < 0)
+            {
+                victim = i;
+                break;
+            }
+            if (static_cast<int32_t>(entry[i].time - entry[victim].time) < 0)
+                victim = i;
+        }
+        entry[victim].hash = h;
+        entry[victim].time = now;
+        entry[victim].slot = slot;
+        entry[victim].id = id;
+    }
+
+private:
+    struct Entry
+    {
+        uint32_t hash;
+        uint32_t time;
+        uint32_t id;
+        int slot;
+    };
+
+    Entry entry[Depth];
+    uint32_t window;
+};
+
+#endif // _FRAMECACHE_H
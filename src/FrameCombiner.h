@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FrameCombiner.h
+//
+// Bitwise majority-vote combining of repeated transmissions which could not be decoded
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FRAMECOMBINER_H
+#define _FRAMECOMBINER_H
+
+#include <stdint.h>
+#include <string.h>
+#include "DigestUtils.h"
+
+/**
+ * \class FrameCombiner
+ *
+ * \brief Combines damaged copies of the same transmission
+ *
+ * Bresser sensors send bursts of identical frames. Frames which could not be decoded
+ * are kept for a short time. A new damaged frame is combined with stored frames of the
+ * same length which arrived within the time window and differ from it by only a few bits
+ * (i.e. are probably copies of the same transmission):
+ *
+ * - three copies: bitwise majority vote
+ * - two copies:   no majority - the differing bits are returned as a mask; the caller
+ *                 can try the combinations of these bits (see candidate())
+ *
+ * \tparam Size     maximum frame size in bytes
+ * \tparam Depth    number of stored frames
+ */
+template <unsigned Size, unsigned Depth = 3>
+class FrameCombiner
+{
+public:
+    /**
+     * \brief Constructor
+     *
+     * \param window_ms     maximum age of stored frames in ms
+     * \param max_distance  maximum number of differing bits between copies
+     */
+    FrameCombiner(uint32_t window_ms = 500, unsigned max_distance = 24)
+        : window(window_ms), maxDistance(max_distance)
+    {
+        clear();
+    }
+
+    /**
+     * \brief Remove all stored frames
+     */
+    void clear(void)
+    {
+        for (unsigned i = 0; i < Depth; i++)
+            entry[i].len = 0;
+    }
+
+    /**
+     * \brief Add a frame which could not be decoded and combine it with stored copies
+     *
+     * \param frame     frame buffer
+     * \param len       frame length in bytes (<= Size)
+     * \param rssi      RSSI of frame
+     * \param now       current time in ms
+     * \param out       combined frame (3 copies) or copy with higher RSSI (2 copies), len bytes
+     * \param diff      differing bits (2 copies) or all zero (3 copies), len bytes
+     *
+     * \returns number of copies combined (2 or 3), 0 if no copy is available
+     */
+    unsigned add(const uint8_t *frame, unsigned len, float rssi, uint32_t now, uint8_t *out, uint8_t *diff)
+    {
+        if ((len == 0) || (len > Size))
+            return 0;
+
+        // Find the two most recent matching copies and the slot to be replaced (free or oldest)
+        int copy[2] = {-1, -1};
+        int victim = -1;
+        for (unsigned i = 0; i < Depth; i++)
+        {
+            Entry &e = entry[i];
+            if ((e.len != 0) && ((now - e.time) > window))
+                e.len = 0;
+
+            if (e.len == 0)
+            {
+                victim = i;
+                continue;
+            }
+            if ((victim < 0) || ((entry[victim].len != 0) && older(e, entry[victim])))
+                victim = i;
+
+            if ((e.len != len) || (distance(e.data, frame, len) > maxDistance))
+                continue;
+
+            if ((copy[0] < 0) || older(entry[copy[0]], e))
+            {
+                copy[1] = copy[0];
+                copy[0] = i;
+            }
+            else if ((copy[1] < 0) || older(entry[copy[1]], e))
+            {
+                copy[1] = i;
+            }
+        }
+
+        unsigned copies = 0;
+        if (copy[1] >= 0)
+        {
+            const uint8_t *a = entry[copy[0]].data;
+            const uint8_t *b = entry[copy[1]].data;
+            for (unsigned j = 0; j < len; j++)
+            {
+                out[j] = (a[j] & b[j]) | (a[j] & frame[j]) | (b[j] & frame[j]);
+                diff[j] = 0;
+            }
+            copies = 3;
+        }
+        else if (copy[0] >= 0)
+        {
+            const Entry &a = entry[copy[0]];
+            const uint8_t *strong = (rssi >= a.rssi) ? frame : a.data;
+            for (unsigned j = 0; j < len; j++)
+            {
+                out[j] = strong[j];
+                diff[j] = frame[j] ^ a.data[j];
+            }
+            copies = 2;
+        }
+
+        // Store new frame
+        Entry &e = entry[victim];
+        memcpy(e.data, frame, len);
+        e.len = len;
+        e.rssi = rssi;
+        e.time = now;
+
+        return copies;
+    }
+
+    /**
+     * \brief Generate a candidate frame from a base frame and a mask of uncertain bits
+     *
+     * Bit i of 'index' selects whether the i-th set bit of 'diff' (MSB of diff[0] first)
+     * is flipped in 'base'.
+     *
+     * \param base      base frame
+     * \param diff      uncertain bits
+     * \param len       frame length in bytes
+     * \param index     candidate index (0 ... 2^count_bits(diff) - 1)
+     * \param out       candidate frame
+     */
+    static void candidate(const uint8_t *base, const uint8_t *diff, unsigned len, uint32_t index, uint8_t *out)
+    {
+        unsigned k = 0;
+        for (unsigned j = 0; j < len; j++)
+        {
+            uint8_t flip = 0;
+            for (uint8_t m = 0x80; m != 0; m >>= 1)
+            {
+                if (diff[j] & m)
+                {
+                    if ((k < 32) && ((index >> k) & 1))
+                        flip |= m;
+                    k++;
+                }
+            }
+            out[j] = base[j] ^ flip;
+        }
+    }
+
+private:
+    struct Entry
+    {
+        uint8_t data[Size];
+        unsigned len;
+        float rssi;
+        uint32_t time;
+    };
+
+    // a received before b (millis() wrap-around safe)
+    static bool older(const Entry &a, const Entry &b)
+    {
+        return static_cast<int32_t>(a.time - b.time) < 0;
+    }
+
+    // Hamming distance
+    static unsigned distance(const uint8_t *a, const uint8_t *b, unsigned len)
+    {
+        unsigned bits = 0;
+        for (unsigned j = 0; j < len; j++)
+            bits += popcount32(a[j] ^ b[j]);
+        return bits;
+    }
+
+    Entry entry[Depth];
+    uint32_t window;
+    unsigned maxDistance;
+};
+
+#endif // _FRAMECOMBINER_H
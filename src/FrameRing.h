@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FrameRing.h
+//
+// Lock-free single-producer/single-consumer ring buffer of received frames
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FRAMERING_H
+#define _FRAMERING_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <atomic>
+
+/**
+ * \class FrameRing
+ *
+ * \brief Lock-free single-producer/single-consumer ring buffer of received frames
+ *
+ * The producer (receive interrupt handler or task) stores each frame together with
+ * its RSSI and capture time and re-arms the receiver immediately; the consumer
+ * (decoder) drains the buffer at its own pace. If the buffer is full, the new frame
+ * is dropped and counted as overrun.
+ *
+ * Only the producer modifies 'head', only the consumer modifies 'tail'.
+ *
+ * \tparam Capacity number of frames (power of two)
+ * \tparam Size     frame size in bytes
+ */
+template <unsigned Capacity, unsigned Size>
+class FrameRing
+{
+    static_assert((Capacity > 0) && ((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of two");
+
+public:
+    /**
+     * \struct Entry
+     *
+     * \brief Received frame
+     */
+    struct Entry
+    {
+        uint8_t data[Size]; //!< frame data
+        float rssi;         //!< RSSI in dBm
+        uint32_t time;      //!< capture time (millis())
+        float freqError;    //!< frequency error in kHz (NAN if not available)
+        uint8_t radio;      //!< index of receiving transceiver
+    };
+
+    /**
+     * \brief Get entry to be filled by the producer
+     *
+     * \returns entry or nullptr if the buffer is full (overrun counted)
+     */
+    Entry *reserve(void)
+    {
+        unsigned h = head.load(std::memory_order_relaxed);
+        if ((h - tail.load(std::memory_order_acquire)) >= Capacity)
+        {
+            overrun.store(overrun.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &entry[h & (Capacity - 1)];
+    }
+
+    /**
+     * \brief Publish entry obtained by reserve() to the consumer
+     */
+    void commit(void)
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * \brief Store frame (producer)
+     *
+     * \param frame     frame data (Size bytes)
+     * \param rssi      RSSI in dBm
+     * \param time      capture time
+     * \param freq_error frequency error in kHz (NAN if not available)
+     * \param radio     index of receiving transceiver
+     *
+     * \returns false if the buffer is full
+     */
+    bool push(const uint8_t *frame, float rssi, uint32_t time, float freq_error = NAN, uint8_t radio = 0)
+    {
+        Entry *e = reserve();
+        if (!e)
+            return false;
+        memcpy(e->data, frame, Size);
+        e->rssi = rssi;
+        e->time = time;
+        e->freqError = freq_error;
+        e->radio = radio;
+        commit();
+        return true;
+    }
+
+    /**
+     * \brief Get oldest entry (consumer)
+     *
+     * \returns entry or nullptr if the buffer is empty
+     */
+    const Entry *peek(void) const
+    {
+        unsigned t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+            return nullptr;
+        return &entry[t & (Capacity - 1)];
+    }
+
+    /**
+     * \brief Release oldest entry obtained by peek() (consumer)
+     */
+    void pop(void)
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * \brief Number of frames available to the consumer
+     */
+    unsigned available(void) const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Number of frames dropped because the buffer was full
+     */
+    uint32_t overruns(void) const
+    {
+        return overrun.load(std::memory_order_relaxed);
+    }
+
+private:
+    Entry entry[Capacity];
+    std::atomic<unsigned> head{0};
+    std::atomic<unsigned> tail{0};
+    std::atomic<uint32_t> overrun{0};
+};
+
+#endif // _FRAMERING_H
@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FreqTracker.h
+//
+// Tracking of the transceiver frequency offset from the frequency error of received frames
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FREQTRACKER_H
+#define _FREQTRACKER_H
+
+/**
+ * \class FreqTracker
+ *
+ * \brief Learns a frequency correction from the frequency error of received frames
+ *
+ * The frequency error (received carrier - receiver frequency) of each successfully
+ * decoded frame is averaged (EWMA, weight 1/8). If the average exceeds 'threshold',
+ * the correction is changed by at most 'step' - small steps avoid losing frames
+ * because of a single bad estimate. After a retune, the average is reduced by the
+ * applied step, because subsequent errors are expected to be smaller by this amount,
+ * and at least 'min_samples' new frames are required before the next retune.
+ *
+ * All values in kHz.
+ */
+class FreqTracker
+{
+public:
+    /**
+     * \brief Constructor
+     *
+     * \param threshold_khz   average error which causes a retune
+     * \param step_khz        max. change of correction per retune
+     * \param max_khz         max. absolute correction
+     * \param min_samples     min. number of frames before (next) retune
+     */
+    FreqTracker(float threshold_khz = 10, float step_khz = 5, float max_khz = 50, unsigned min_samples = 4)
+        : threshold(threshold_khz), step(step_khz), maxCorrection(max_khz), minSamples(min_samples)
+    {
+        begin(0);
+    }
+
+    /**
+     * \brief Restart tracking
+     *
+     * \param correction_khz  current correction (e.g. restored from non-volatile memory)
+     */
+    void begin(float correction_khz)
+    {
+        correction = clamp(correction_khz, maxCorrection);
+        error = 0;
+        samples = 0;
+        retunes = 0;
+        started = false;
+    }
+
+    /**
+     * \brief Add frequency error of a received frame
+     *
+     * \param error_khz   frequency error in kHz
+     *
+     * \returns true if the correction has been changed (retune required)
+     */
+    bool update(float error_khz)
+    {
+        error = started ? error + (error_khz - error) / 8 : error_khz;
+        started = true;
+        if (samples < minSamples)
+            samples++;
+
+        if ((samples < minSamples) || ((error < threshold) && (error > -threshold)))
+            return false;
+
+        float prev = correction;
+        correction = clamp(correction + clamp(error, step), maxCorrection);
+        if (correction == prev)
+            return false;
+
+        error -= correction - prev;
+        samples = 0;
+        retunes++;
+        return true;
+    }
+
+    /**
+     * \brief Get correction in kHz
+     */
+    float getCorrection(void) const
+    {
+        return correction;
+    }
+
+    /**
+     * \brief Get average frequency error in kHz (relative to the current correction)
+     */
+    float getError(void) const
+    {
+        return error;
+    }
+
+    /**
+     * \brief Get number of retunes since begin()
+     */
+    unsigned getRetunes(void) const
+    {
+        return retunes;
+    }
+
+private:
+    static float clamp(float value, float limit)
+    {
+        return (value > limit) ? limit : (value < -limit) ? -limit : value;
+    }
+
+    float threshold;
+    float step;
+    float maxCorrection;
+    unsigned minSamples;
+    float correction;
+    float error;
+    unsigned samples;
+    unsigned retunes;
+    bool started;
+};
+
+#endif // _FREQTRACKER_H
@@ -65,6 +65,12 @@
 //          pastHour(): modified parameters
 // 20260211 Refactored to use RollingCounter base class
 // 20260221 Improved RollingCounter generalization, documentation, and code deduplication
+// 20261016 Using Preferences: nvLightning stored as single versioned, CRC-protected record,
+//          loaded once and written only if modified; conversion from previous layout
+//          reset() result is stored
+//          Added running sums of history buffer and pastMinutes()
+//          lastCycle() returns -1 if an update was ignored
+//          Flush interval is also checked if an update was ignored
 //
 // ToDo:
 // -
@@ -97,6 +103,7 @@ RTC_DATA_ATTR nvLightning_t nvLightning = {
 void
 Lightning::reset(void)
 {
+    nvLoad();
     nvLightning.lastUpdate = 0;
     nvLightning.startupPrev = false;
     nvLightning.preStCount = 0;
@@ -106,20 +113,94 @@ Lightning::reset(void)
     nvLightning.distance = 0;
     nvLightning.timestamp = 0;
     deltaEvents = -1;
+    nvModified();
+    flush();
 }
 
 void
 Lightning::hist_init(int16_t count)
 {
+    nvLoad();
     for (int i=0; i<LIGHTNING_HIST_SIZE; i++) {
         nvLightning.hist[i] = count;
     }
+    hourSums.valid = false;
+    nvModified();
 }
 
-#if defined(LIGHTNING_USE_PREFS)  && !defined(INSIDE_UNITTEST)
+void
+Lightning::nvLoad(void)
+{
+#if defined(LIGHTNING_USE_PREFS)
+    if (!nvLoaded) {
+        prefs_load();
+    }
+#endif
+}
+
+void
+Lightning::nvModified(void)
+{
+#if defined(LIGHTNING_USE_PREFS)
+    nvDirty = true;
+#endif
+}
+
+void
+Lightning::nvCommit(time_t timestamp)
+{
+    nvModified();
+#if defined(LIGHTNING_USE_PREFS)
+    // Write if flush interval has expired (or time has been set back)
+    if ((timestamp - nvFlushed >= static_cast<time_t>(flushInterval)) || (timestamp < nvFlushed)) {
+        flush();
+    }
+#endif
+}
+
+void
+Lightning::flush(void)
+{
+#if defined(LIGHTNING_USE_PREFS)
+    if (nvDirty) {
+        prefs_save();
+    }
+#endif
+}
+
+#if defined(LIGHTNING_USE_PREFS)
+static const char *const PREFS_NAMESPACE = "BWS-LGT";
+static const char *const PREFS_KEY = "nvLightning";
+
 void Lightning::prefs_load(void)
 {
-    preferences.begin("BWS-LGT", false);
+    preferences.begin(PREFS_NAMESPACE, false);
+    PrefsBlob<nvLightning_t>::Status status = PrefsBlob<nvLightning_t>::load(preferences, PREFS_KEY, LIGHTNING_NVDATA_VERSION, nvLightning);
+    if (status != PrefsBlob<nvLightning_t>::BLOB_OK) {
+        if (status == PrefsBlob<nvLightning_t>::BLOB_INVALID) {
+            log_w("Invalid lightning data in Preferences - discarded");
+        }
+        // Initial values as with previous layout
+        nvLightning.events = -1;
+
+        if (preferences.isKey("prevCount")) {
+            prefs_migrate();
+        }
+    }
+    preferences.end();
+    nvLoaded = true;
+    nvFlushed = nvLightning.lastUpdate;
+    hourSums.valid = false;
+
+    log_d("lastUpdate   =%lld", static_cast<long long>(nvLightning.lastUpdate));
+    log_d("prevCount    =%d", nvLightning.prevCount);
+    log_d("events       =%d", nvLightning.events);
+    log_d("timestamp    =%lld", static_cast<long long>(nvLightning.timestamp));
+}
+
+void Lightning::prefs_migrate(void)
+{
+    // Previous layout: one key per member of nvLightning_t
     nvLightning.lastUpdate   = preferences.getULong64("lastUpdate", 0);
     nvLightning.startupPrev  = preferences.getBool("startupPrev", false);
     nvLightning.preStCount   = preferences.getShort("preStCount", 0);
@@ -129,52 +210,47 @@ void Lightning::prefs_load(void)
     nvLightning.distance     = preferences.getUChar("distance", 0);
     nvLightning.timestamp    = preferences.getULong64("timestamp", 0);
     nvLightning.updateRate   = preferences.getUChar("updateRate", LIGHTNING_UPD_RATE);
-    //preferences.getBytes("hist", nvLightning.hist, sizeof(nvLightning.hist));
-    // Optimization: Reduces number of Flash writes
     for (int i=0; i<LIGHTNING_HIST_SIZE; i++) {
         char buf[7];
         sprintf(buf, "hist%02d", i);
         nvLightning.hist[i] = preferences.getShort(buf, -1);
     }
-    log_d("lastUpdate   =%s", String(nvLightning.lastUpdate).c_str());
-    log_d("startupPrev  =%d", nvLightning.startupPrev);
-    log_d("preStCount   =%d", nvLightning.preStCount);
-    log_d("accCount     =%u", nvLightning.accCount);
-    log_d("prevCount    =%d", nvLightning.prevCount);
-    log_d("events       =%d", nvLightning.events);
-    log_d("distance     =%d", nvLightning.distance);
-    log_d("timestamp    =%s", String(nvLightning.timestamp).c_str());
-    preferences.end();
-}
 
-void Lightning::prefs_save(void)
-{
-    preferences.begin("BWS-LGT", false);
-    preferences.putULong64("lastUpdate", nvLightning.lastUpdate);
-    preferences.putBool("startupPrev", nvLightning.startupPrev);
-    preferences.putShort("preStCount", nvLightning.preStCount);
-    preferences.putUInt("accCount", nvLightning.accCount);
-    preferences.putUShort("prevCount", nvLightning.prevCount);
-    preferences.putUShort("events", nvLightning.events);
-    preferences.putUChar("distance", nvLightning.distance);
-    preferences.putULong64("timestamp", nvLightning.timestamp);
-    //preferences.putBytes("hist", nvLightning.hist, sizeof(nvLightning.hist));
-    // Optimization: Reduces number of Flash writes
+    // Write new record before the old keys are removed
+    if (!PrefsBlob<nvLightning_t>::save(preferences, PREFS_KEY, LIGHTNING_NVDATA_VERSION, nvLightning)) {
+        log_w("Conversion of lightning data in Preferences failed");
+        return;
+    }
+    static const char *const keys[] = {
+        "lastUpdate", "startupPrev", "preStCount", "accCount", "prevCount",
+        "events", "distance", "timestamp", "updateRate"
+    };
+    for (size_t i=0; i<sizeof(keys)/sizeof(keys[0]); i++) {
+        preferences.remove(keys[i]);
+    }
     for (int i=0; i<LIGHTNING_HIST_SIZE; i++) {
         char buf[7];
         sprintf(buf, "hist%02d", i);
-        preferences.putShort(buf, nvLightning.hist[i]);
+        preferences.remove(buf);
+    }
+    log_i("Lightning data in Preferences converted to single record");
+}
+
+void Lightning::prefs_save(void)
+{
+    preferences.begin(PREFS_NAMESPACE, false);
+    if (PrefsBlob<nvLightning_t>::save(preferences, PREFS_KEY, LIGHTNING_NVDATA_VERSION, nvLightning)) {
+        nvDirty = false;
     }
     preferences.end();
+    nvFlushed = nvLightning.lastUpdate;
 }
 #endif
 
 void
 Lightning::update(time_t timestamp, int16_t count, uint8_t distance, bool startup)
 {
-    #if defined(LIGHTNING_USE_PREFS)  && !defined(INSIDE_UNITTEST)
-        prefs_load();
-    #endif
+    nvLoad();
 
     if (nvLightning.lastUpdate == 0) {
         // Initialize history
@@ -186,10 +262,6 @@ Lightning::update(time_t timestamp, int16_t count, uint8_t distance, bool startu
         nvLightning.prevCount = count;
         nvLightning.lastUpdate = timestamp;
         lastUpdate = timestamp;
-
-        #if defined(LIGHTNING_USE_PREFS)  && !defined(INSIDE_UNITTEST)
-            prefs_save();
-        #endif
     }
     
     currCount = nvLightning.accCount + count;
@@ -248,7 +320,9 @@ Lightning::update(time_t timestamp, int16_t count, uint8_t distance, bool startu
     // t_delta < 0: something is wrong, e.g. RTC was not set correctly
     if (t_delta < 0) {
         log_w("Negative time span since last update!?");
-        return; 
+        deltaEvents = -1;
+        nvCommit(timestamp);
+        return;
     }
 
 
@@ -269,7 +343,7 @@ Lightning::update(time_t timestamp, int16_t count, uint8_t distance, bool startu
 
     // Update history buffer using generalized base class method
     updateHistoryBuffer(nvLightning.hist, LIGHTNING_HIST_SIZE, idx, delta,
-                       t_delta, timestamp, nvLightning.lastUpdate, nvLightning.updateRate);
+                       t_delta, timestamp, nvLightning.lastUpdate, nvLightning.updateRate, &hourSums);
     
     #if CORE_DEBUG_LEVEL == ARDUHAL_LOG_LEVEL_DEBUG
         String buf;
@@ -286,9 +360,7 @@ Lightning::update(time_t timestamp, int16_t count, uint8_t distance, bool startu
     updateRate = nvLightning.updateRate;
     nvLightning.prevCount = currCount;
 
-    #if defined(LIGHTNING_USE_PREFS)  && !defined(INSIDE_UNITTEST)
-        prefs_save();
-    #endif
+    nvCommit(timestamp);
 }
 
 int 
@@ -300,6 +372,7 @@ Lightning::lastCycle(void)
 bool
 Lightning::lastEvent(time_t &timestamp, int &events, uint8_t &distance)
 {
+    nvLoad();
     if (nvLightning.events == -1) {
         events = -1;
         return false;
@@ -315,10 +388,32 @@ Lightning::lastEvent(time_t &timestamp, int &events, uint8_t &distance)
 int
 Lightning::pastHour(bool *valid, int *nbins, float *quality)
 {
+    nvLoad();
     History hourHist = {
         .hist = nvLightning.hist,
         .size = LIGHTNING_HIST_SIZE,
-        .updateRate = nvLightning.updateRate
+        .updateRate = nvLightning.updateRate,
+        .sums = &hourSums
     };
     return static_cast<int>(sumHistory(hourHist, valid, nbins, quality, 1.0));
 }
+
+int
+Lightning::pastMinutes(unsigned minutes, bool *valid, int *nbins, float *quality)
+{
+    nvLoad();
+    if ((nvLightning.lastUpdate == 0) || (minutes == 0) || (minutes > 60)) {
+        setQuality(0, 0, valid, nbins, quality);
+        return 0;
+    }
+
+    History hourHist = {
+        .hist = nvLightning.hist,
+        .size = LIGHTNING_HIST_SIZE,
+        .updateRate = nvLightning.updateRate,
+        .sums = &hourSums
+    };
+    size_t bins = (minutes + nvLightning.updateRate - 1) / nvLightning.updateRate;
+    int newest = calculateIndex(nvLightning.lastUpdate, nvLightning.updateRate);
+    return static_cast<int>(sumRecent(hourHist, bins, newest, valid, nbins, quality, 1.0));
+}
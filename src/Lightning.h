@@ -63,6 +63,10 @@
 //          pastHour(): modified parameters
 // 20260211 Refactored to use RollingCounter base class
 // 20260221 Improved RollingCounter generalization, documentation, and code deduplication
+// 20261016 Using RTC RAM: storage can be passed to the constructor (multiple instances)
+//          Using Preferences: nvLightning stored as single versioned, CRC-protected record,
+//          loaded once and written only if modified (see flush(), setFlushInterval())
+//          Added running sums of history buffer and pastMinutes()
 //
 // ToDo:
 // -
@@ -81,6 +85,7 @@
 
 #if defined(LIGHTNING_USE_PREFS)
 #include <Preferences.h>
+#include "PrefsBlob.h"
 #endif
 
 
@@ -106,6 +111,23 @@
  */
 #define LIGHTNING_HIST_SIZE 10
 
+/**
+ * \def LIGHTNING_NVDATA_VERSION
+ *
+ * Version of nvLightning_t stored in Preferences - increment when nvLightning_t is modified
+ */
+#define LIGHTNING_NVDATA_VERSION 1
+
+/**
+ * \def LIGHTNING_FLUSH_INTERVAL
+ *
+ * Minimum interval [s] between writes of modified data to Preferences
+ * (0: write after each update(); see Lightning::setFlushInterval())
+ */
+#if !defined(LIGHTNING_FLUSH_INTERVAL)
+#define LIGHTNING_FLUSH_INTERVAL 0
+#endif
+
 /**
  * \typedef nvLightning_t
  *
@@ -134,6 +156,13 @@ typedef struct {
     uint8_t updateRate;     //!< expected update rate for pastHour() calculation
 } nvLightning_t;
 
+#if !defined(LIGHTNING_USE_PREFS) && !defined(INSIDE_UNITTEST)
+/**
+ * \brief Default storage in RTC RAM (used if no storage is passed to the constructor)
+ */
+extern nvLightning_t nvLightning;
+#endif
+
 
 /**
  * \class Lightning
@@ -146,6 +175,7 @@ class Lightning : public RollingCounter {
 private:
     int currCount;
     int deltaEvents = -1;
+    HistorySums hourSums; //!< running sums of nvLightning.hist
 
     #if defined(LIGHTNING_USE_PREFS) || defined(INSIDE_UNITTEST)
     nvLightning_t nvLightning = {
@@ -162,8 +192,15 @@ private:
     };
     #endif
     
-    #if defined(LIGHTNING_USE_PREFS) && !defined(INSIDE_UNITTEST)
+    #if defined(LIGHTNING_USE_PREFS)
     Preferences preferences;
+    bool        nvLoaded = false;   //!< nvLightning has been loaded from Preferences
+    bool        nvDirty = false;    //!< nvLightning has been modified since last write
+    time_t      nvFlushed = 0;      //!< timestamp of last write
+    uint32_t    flushInterval = LIGHTNING_FLUSH_INTERVAL;
+    #endif
+    #if !defined(LIGHTNING_USE_PREFS) && !defined(INSIDE_UNITTEST)
+    nvLightning_t &nvLightning;
     #endif
 
 public:
@@ -171,10 +208,27 @@ public:
      * Constructor
      *
      * \param quality_threshold fraction of valid hist entries required for valid pastHour() result
+     * \param nv_data           storage in RTC RAM (RTC_DATA_ATTR) - required for each additional instance;
+     *                          ignored with LIGHTNING_USE_PREFS (default: ::nvLightning)
      */
-    Lightning(const float quality_threshold = DEFAULT_QUALITY_THRESHOLD) :
+    Lightning(const float quality_threshold = DEFAULT_QUALITY_THRESHOLD, nvLightning_t *nv_data = nullptr) :
         RollingCounter(quality_threshold)
-    {};
+    #if !defined(LIGHTNING_USE_PREFS) && !defined(INSIDE_UNITTEST)
+        , nvLightning(nv_data ? *nv_data : ::nvLightning)
+    #endif
+    {
+        (void)nv_data;
+    };
+
+    #if defined(LIGHTNING_USE_PREFS)
+    /**
+     * Destructor - writes modified data to Preferences
+     */
+    ~Lightning()
+    {
+        flush();
+    }
+    #endif
     
 
     /**
@@ -221,22 +275,46 @@ public:
             return false;
         }
         
-        #if !defined(INSIDE_UNITTEST)
-        preferences.begin("BWS-LGT", false);
-        uint8_t updateRatePrev = preferences.getUChar("updateRate", LIGHTNING_UPD_RATE);
-        preferences.putUChar("updateRate", rate);
-        preferences.end();
-        #else
-        static uint8_t updateRatePrev = LIGHTNING_UPD_RATE;
-        updateRatePrev = nvLightning.updateRate;
-        #endif
-        nvLightning.updateRate = rate;
-        if (nvLightning.updateRate != updateRatePrev) {
+        nvLoad();
+        if (nvLightning.updateRate != rate) {
+            nvLightning.updateRate = rate;
             hist_init();
+            nvModified();
+            flush();
         }
         return true;
     }
 
+    /**
+     * \brief Set minimum interval between writes of modified data to Preferences
+     *
+     * With LIGHTNING_USE_PREFS, nvLightning is loaded once and written as a single record
+     * only if it has been modified. By default (interval 0), it is written after each
+     * update(). During a thunderstorm, update() may be called for each received message;
+     * a longer interval reduces the flash writes accordingly. In this case flush() must
+     * be called before the data would be lost (e.g. before deep sleep).
+     *
+     * Without LIGHTNING_USE_PREFS (RTC RAM), this function has no effect.
+     *
+     * \param interval  interval in seconds (timestamps passed to update())
+     */
+    void setFlushInterval(uint32_t interval)
+    {
+        #if defined(LIGHTNING_USE_PREFS)
+        flushInterval = interval;
+        #else
+        (void)interval;
+        #endif
+    }
+
+    /**
+     * \brief Write modified data to Preferences
+     *
+     * Call before deep sleep or power down if a flush interval has been set.
+     * Without LIGHTNING_USE_PREFS (RTC RAM), this function has no effect.
+     */
+    void flush(void);
+
 
     /**
      * Initialize/reset non-volatile data
@@ -251,8 +329,17 @@ public:
      */
     void hist_init(int16_t count = -1) override;
     
-    #if defined(LIGHTNING_USE_PREFS)  && !defined(INSIDE_UNITTEST)
+    #if defined(LIGHTNING_USE_PREFS)
+    /**
+     * Load nvLightning from Preferences
+     *
+     * Data stored in the previous layout (one key per member) is converted.
+     */
     void prefs_load(void);
+
+    /**
+     * Write nvLightning to Preferences
+     */
     void prefs_save(void);
     #endif
 
@@ -285,12 +372,30 @@ public:
      */
     int pastHour(bool *valid = nullptr, int *nbins = nullptr, float *quality = nullptr);
 
+    /**
+     * \fn pastMinutes
+     *
+     * \brief Get number of lightning events during past minutes
+     *
+     * Sum of the most recent history bins covering the given time span (rounded up
+     * to full bins, resolution: update rate) up to the last update
+     *
+     * \param minutes   time span in minutes (1...60)
+     * \param valid     number of valid bins >= qualityThreshold * number of bins
+     * \param nbins     number of valid bins
+     * \param quality   fraction of valid bins (0..1)
+     *
+     * \return number of events during past minutes
+     */
+    int pastMinutes(unsigned minutes, bool *valid = nullptr, int *nbins = nullptr, float *quality = nullptr);
+
     /*
      * \fn lastCycle
      * 
      * \brief Get number of events during last update cycle
      * 
-     * \return number of lightning events
+     * \return number of lightning events (-1: no update since reset / start
+     *         or last update ignored, e.g. due to negative time span)
      */
     int lastCycle(void);
 
@@ -306,5 +411,27 @@ public:
      * \return true if valid    
      */
     bool lastEvent(time_t &timestamp, int &events, uint8_t &distance);
+
+private:
+    /**
+     * Load nvLightning from Preferences if not done yet
+     */
+    void nvLoad(void);
+
+    /**
+     * Mark nvLightning as modified
+     */
+    void nvModified(void);
+
+    /**
+     * Mark nvLightning as modified and write it if the flush interval has expired
+     *
+     * \param timestamp    time of update
+     */
+    void nvCommit(time_t timestamp);
+
+    #if defined(LIGHTNING_USE_PREFS)
+    void prefs_migrate(void);
+    #endif
 };
 #endif // _LIGHTNING_H
\ No newline at end of file
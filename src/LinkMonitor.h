@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LinkMonitor.h
+//
+// Per-sensor link quality statistics
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _LINKMONITOR_H
+#define _LINKMONITOR_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * \struct LinkStats
+ *
+ * \brief Link quality statistics of one sensor
+ *
+ * A transmission may consist of several repeated frames; frames received within
+ * 'burst' ms of the previous one belong to the same transmission.
+ */
+struct LinkStats
+{
+    /**
+     * \brief Error classes (see LinkMonitor::error())
+     */
+    enum Error
+    {
+        ERR_PARITY,
+        ERR_CHECKSUM,
+        ERR_DIGEST
+    };
+
+    uint32_t id;        //!< sensor ID
+    uint32_t last;      //!< time of last transmission in ms
+    float rssi_mean;    //!< RSSI mean (EWMA) in dBm
+    float rssi_var;     //!< RSSI variance (EWMA) in dB^2
+    uint32_t frames;    //!< frames decoded (including repetitions)
+    uint32_t received;  //!< transmissions received (0: entry unused)
+    uint32_t expected;  //!< transmissions expected from the transmit interval
+    uint16_t par_err;   //!< frames with parity error
+    uint16_t chk_err;   //!< frames with checksum error
+    uint16_t dig_err;   //!< frames with digest error
+
+    /**
+     * \brief Estimated packet loss in percent
+     */
+    float loss(void) const
+    {
+        return (expected > received) ? 100.0f * (expected - received) / expected : 0.0f;
+    }
+
+    /**
+     * \brief RSSI standard deviation in dB
+     */
+    float rssiStd(void) const
+    {
+        return sqrtf(rssi_var);
+    }
+};
+
+/**
+ * \class LinkMonitor
+ *
+ * \brief Collects link quality statistics per sensor ID
+ *
+ * The RSSI of each decoded frame is averaged with an exponentially weighted moving
+ * average and variance (weight 'alpha'). The number of expected transmissions is derived
+ * from the time between received transmissions and the sensor's transmit interval
+ * (e.g. learned by ArrivalPredictor); if the interval is unknown, each received
+ * transmission counts as expected. Frames which could not be decoded are attributed
+ * to a sensor if its ID could be recovered (see error()).
+ *
+ * \tparam N    number of sensors (least recently seen sensor is replaced)
+ */
+template <unsigned N>
+class LinkMonitor
+{
+public:
+    /**
+     * \brief Constructor
+     *
+     * \param alpha     weight of new RSSI samples
+     */
+    LinkMonitor(float alpha = 0.125f) : alpha(alpha)
+    {
+        clear();
+    }
+
+    /**
+     * \brief Remove all entries
+     */
+    void clear(void)
+    {
+        memset(entry, 0, sizeof(entry));
+    }
+
+    /**
+     * \brief Update statistics with decoded frame
+     *
+     * \param id        sensor ID
+     * \param rssi      RSSI of frame in dBm
+     * \param now       time of reception in ms
+     * \param interval  transmit interval in ms (0: unknown)
+     * \param burst     time window in ms for repetitions of the same transmission
+     */
+    void update(uint32_t id, float rssi, uint32_t now, uint32_t interval = 0, uint32_t burst = 2000)
+    {
+        LinkStats *e = lookup(id);
+        if (!e)
+        {
+            e = victim();
+            memset(e, 0, sizeof(*e));
+            e->id = id;
+            e->last = now;
+            e->rssi_mean = rssi;
+            e->frames = 1;
+            e->received = 1;
+            e->expected = 1;
+            return;
+        }
+
+        e->frames++;
+        float diff = rssi - e->rssi_mean;
+        float incr = alpha * diff;
+        e->rssi_mean += incr;
+        e->rssi_var = (1.0f - alpha) * (e->rssi_var + diff * incr);
+
+        uint32_t delta = now - e->last;
+        if (delta < burst)
+            return;
+
+        e->last = now;
+        e->received++;
+
+        // Number of intervals since last transmission
+        uint32_t k = (interval > 0) ? (delta + interval / 2) / interval : 1;
+        e->expected += (k > 0) ? k : 1;
+    }
+
+    /**
+     * \brief Count frame which could not be decoded
+     *
+     * Only sensors which already have an entry are considered - the ID of a
+     * damaged frame is not trusted to create a new one.
+     *
+     * \param id        sensor ID
+     * \param err       error class
+     *
+     * \returns true if the error has been attributed to a sensor
+     */
+    bool error(uint32_t id, LinkStats::Error err)
+    {
+        LinkStats *e = lookup(id);
+        if (!e)
+            return false;
+
+        uint16_t &cnt = (err == LinkStats::ERR_PARITY) ? e->par_err : (err == LinkStats::ERR_CHECKSUM) ? e->chk_err : e->dig_err;
+        if (cnt < 0xFFFF)
+            cnt++;
+        return true;
+    }
+
+    /**
+     * \brief Find entry by sensor ID
+     *
+     * \param id    sensor ID
+     *
+     * \returns entry or nullptr if not found
+     */
+    const LinkStats *find(uint32_t id) const
+    {
+        for (unsigned i = 0; i < N; i++)
+        {
+            if (entry[i].received && (entry[i].id == id))
+                return &entry[i];
+        }
+        return nullptr;
+    }
+
+    /**
+     * \brief Number of entries
+     */
+    unsigned size(void) const
+    {
+        return N;
+    }
+
+    /**
+     * \brief Entry by index (unused if received == 0)
+     */
+    const LinkStats &operator[](unsigned i) const
+    {
+        return entry[i];
+    }
+
+private:
+    LinkStats *lookup(uint32_t id)
+    {
+        return const_cast<LinkStats *>(find(id));
+    }
+
+    // Free entry or least recently seen sensor
+    LinkStats *victim(void)
+    {
+        LinkStats *v = &entry[0];
+        for (unsigned i = 0; i < N; i++)
+        {
+            if (!entry[i].received)
+                return &entry[i];
+            if (static_cast<int32_t>(entry[i].last - v->last) < 0)
+                v = &entry[i];
+        }
+        return v;
+    }
+
+    float alpha;
+    LinkStats entry[N];
+};
+
+#endif // _LINKMONITOR_H
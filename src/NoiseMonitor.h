@@ -0,0 +1,265 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// NoiseMonitor.h
+//
+// Noise floor histogram and detection of interference bursts
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _NOISEMONITOR_H
+#define _NOISEMONITOR_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * \struct NoiseStats
+ *
+ * \brief Noise floor and interference statistics (see NoiseMonitor::getStats())
+ */
+struct NoiseStats
+{
+    int8_t floor_dbm;       //!< noise floor (25th percentile) in dBm (-128: unknown)
+    int8_t p90_dbm;         //!< 90th percentile in dBm (-128: unknown)
+    int8_t peak_dbm;        //!< max. level of interference bursts in dBm (-128: none)
+    bool interference;      //!< interference burst in progress
+    uint16_t bursts;        //!< number of interference bursts
+    uint32_t burst_ms;      //!< total duration of interference bursts in ms
+    uint32_t samples;       //!< number of samples
+};
+
+/**
+ * \class NoiseMonitor
+ *
+ * \brief Builds a rolling histogram of RSSI samples taken while no frame is received
+ *
+ * The histogram (2 dB bins, -140...-60 dBm) covers the current and the previous time
+ * window ('window' ms each), i.e. old samples age out. The noise floor is the 25th
+ * percentile, so short interference does not raise it.
+ *
+ * A sample 'threshold' dB or more above the noise floor starts an interference burst,
+ * the next sample below (with a hysteresis of one bin) ends it.
+ *
+ * A sample may have been taken while a frame was already in flight (before the packet
+ * received interrupt). Therefore each sample is held back; it is discarded if a frame
+ * is received within 'airtime' ms (see frame()).
+ */
+class NoiseMonitor
+{
+public:
+    static const int MIN_DBM = -140;   //!< lower limit of histogram in dBm
+    static const int BIN_DB = 2;       //!< bin width in dB
+    static const unsigned BINS = 40;   //!< number of bins
+    static const unsigned MIN_SAMPLES = 16;  //!< samples required for noise floor estimate
+
+    /**
+     * \brief Constructor
+     *
+     * \param threshold_db  level above noise floor for interference in dB
+     * \param window_ms     histogram time window in ms
+     * \param airtime_ms    max. time between start of a frame and packet received interrupt in ms
+     */
+    NoiseMonitor(uint8_t threshold_db = 10, uint32_t window_ms = 600000, uint32_t airtime_ms = 50)
+        : threshold(threshold_db), window(window_ms), airtime(airtime_ms)
+    {
+        clear();
+    }
+
+    /**
+     * \brief Remove all samples and statistics
+     */
+    void clear(void)
+    {
+        memset(hist, 0, sizeof(hist));
+        cur = 0;
+        started = false;
+        windowStart = 0;
+        pending = false;
+        pendingRssi = 0;
+        pendingTime = 0;
+        inBurst = false;
+        burstStart = 0;
+        burstEnd = 0;
+        stats.floor_dbm = -128;
+        stats.p90_dbm = -128;
+        stats.peak_dbm = -128;
+        stats.interference = false;
+        stats.bursts = 0;
+        stats.burst_ms = 0;
+        stats.samples = 0;
+    }
+
+    /**
+     * \brief Add RSSI sample (taken in receive mode without pending frame)
+     *
+     * \param rssi  RSSI in dBm
+     * \param now   time in ms
+     */
+    void sample(float rssi, uint32_t now)
+    {
+        if (pending)
+            commit();
+        pendingRssi = rssi;
+        pendingTime = now;
+        pending = true;
+    }
+
+    /**
+     * \brief Report received frame - discards a sample which was probably taken during the frame
+     *
+     * \param now   time in ms
+     */
+    void frame(uint32_t now)
+    {
+        if (pending && ((now - pendingTime) <= airtime))
+            pending = false;
+    }
+
+    /**
+     * \brief Check if interference was present
+     *
+     * \param now       time in ms
+     * \param hold_ms   time after the end of a burst which is still considered
+     *
+     * \returns true if an interference burst is in progress or ended within hold_ms
+     */
+    bool interference(uint32_t now, uint32_t hold_ms = 1000) const
+    {
+        return inBurst || ((stats.bursts > 0) && ((now - burstEnd) <= hold_ms));
+    }
+
+    /**
+     * \brief Get statistics
+     */
+    const NoiseStats &getStats(void) const
+    {
+        return stats;
+    }
+
+private:
+    void commit(void)
+    {
+        pending = false;
+
+        // Rotate time windows
+        if (!started || ((pendingTime - windowStart) >= window))
+        {
+            unsigned prev = cur ^ 1;
+            if (started && ((pendingTime - windowStart) >= 2 * window))
+                memset(hist[cur], 0, sizeof(hist[cur]));
+            memset(hist[prev], 0, sizeof(hist[prev]));
+            cur = prev;
+            windowStart = pendingTime;
+            started = true;
+        }
+
+        int bin = (static_cast<int>(pendingRssi) - MIN_DBM) / BIN_DB;
+        bin = (bin < 0) ? 0 : (bin >= static_cast<int>(BINS)) ? BINS - 1 : bin;
+        if (hist[cur][bin] < 0xFFFF)
+            hist[cur][bin]++;
+        stats.samples++;
+
+        stats.floor_dbm = percentile(25);
+        stats.p90_dbm = percentile(90);
+        if (stats.floor_dbm == -128)
+            return;
+
+        // Interference bursts
+        if (pendingRssi >= stats.floor_dbm + threshold)
+        {
+            if (!inBurst)
+            {
+                inBurst = true;
+                burstStart = pendingTime;
+                stats.bursts++;
+            }
+            if (pendingRssi > stats.peak_dbm)
+                stats.peak_dbm = static_cast<int8_t>(pendingRssi);
+        }
+        else if (inBurst && (pendingRssi < stats.floor_dbm + threshold - BIN_DB))
+        {
+            inBurst = false;
+            burstEnd = pendingTime;
+            stats.burst_ms += pendingTime - burstStart;
+        }
+        stats.interference = inBurst;
+    }
+
+    // Percentile of both time windows in dBm (bin center), -128 if too few samples
+    int8_t percentile(unsigned p) const
+    {
+        uint32_t total = 0;
+        for (unsigned i = 0; i < BINS; i++)
+            total += hist[0][i] + hist[1][i];
+        if (total < MIN_SAMPLES)
+            return -128;
+
+        uint32_t rank = (total * p + 99) / 100;
+        uint32_t sum = 0;
+        for (unsigned i = 0; i < BINS; i++)
+        {
+            sum += hist[0][i] + hist[1][i];
+            if (sum >= rank)
+                return binLevel(i);
+        }
+        return binLevel(BINS - 1);
+    }
+
+    // Center of bin in dBm
+    static int8_t binLevel(unsigned bin)
+    {
+        return static_cast<int8_t>(MIN_DBM + static_cast<int>(bin) * BIN_DB + BIN_DB / 2);
+    }
+
+    uint8_t threshold;
+    uint32_t window;
+    uint32_t airtime;
+    uint16_t hist[2][BINS];
+    unsigned cur;
+    bool started;
+    uint32_t windowStart;
+    bool pending;
+    float pendingRssi;
+    uint32_t pendingTime;
+    bool inBurst;
+    uint32_t burstStart;
+    uint32_t burstEnd;
+    NoiseStats stats;
+};
+
+#endif // _NOISEMONITOR_H
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PrefsBlob.h
+//
+// Versioned, CRC-protected storage of a data structure as a single Preferences entry
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//          Using table driven CRC16 (Crc16Table)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _PREFSBLOB_H
+#define _PREFSBLOB_H
+
+#include <stdint.h>
+#include <string.h>
+#include "DigestUtils.h"
+
+/**
+ * \class PrefsBlob
+ *
+ * \brief Stores a data structure as one versioned, CRC-protected Preferences entry
+ *
+ * Record layout (little endian):
+ *
+ *   | version (1) | reserved (1) | size (2) | data (sizeof(T)) | CRC16 (2) |
+ *
+ * The CRC (CRC-16/CCITT, init 0xFFFF) covers the header and the data.
+ * A record is only accepted if version, size and CRC match; a change of the
+ * data structure therefore requires a new version number.
+ *
+ * The Preferences type is a template parameter of load()/save(), so the
+ * class can be used with the ESP32 Preferences library as well as with
+ * compatible implementations (e.g. vshymanskyy/Preferences, test mocks).
+ *
+ * \tparam T    data structure (trivially copyable)
+ */
+template <typename T>
+class PrefsBlob
+{
+public:
+    /**
+     * \enum Status
+     *
+     * \brief Result of load()
+     */
+    enum Status
+    {
+        BLOB_OK,      //!< record loaded
+        BLOB_MISSING, //!< no record with this key
+        BLOB_INVALID  //!< record found, but wrong size, version or CRC
+    };
+
+    static const unsigned HEADER_SIZE = 4;
+    static const unsigned RECORD_SIZE = HEADER_SIZE + sizeof(T) + 2;
+
+    /**
+     * \brief Load record
+     *
+     * \param prefs     Preferences (namespace already opened)
+     * \param key       key
+     * \param version   expected data structure version
+     * \param data      data (only modified if BLOB_OK is returned)
+     *
+     * \returns status
+     */
+    template <typename Prefs>
+    static Status load(Prefs &prefs, const char *key, uint8_t version, T &data)
+    {
+        if (!prefs.isKey(key))
+            return BLOB_MISSING;
+
+        uint8_t buf[RECORD_SIZE];
+        if ((prefs.getBytesLength(key) != RECORD_SIZE) ||
+            (prefs.getBytes(key, buf, RECORD_SIZE) != RECORD_SIZE))
+            return BLOB_INVALID;
+
+        uint16_t crc = buf[RECORD_SIZE - 2] | (buf[RECORD_SIZE - 1] << 8);
+        uint16_t size = buf[2] | (buf[3] << 8);
+        if ((buf[0] != version) || (size != sizeof(T)) ||
+            (crc != Crc16Table<0x1021>::crc(buf, RECORD_SIZE - 2, 0xFFFF)))
+            return BLOB_INVALID;
+
+        memcpy(&data, &buf[HEADER_SIZE], sizeof(T));
+        return BLOB_OK;
+    }
+
+    /**
+     * \brief Save record
+     *
+     * \param prefs     Preferences (namespace already opened, read/write)
+     * \param key       key
+     * \param version   data structure version
+     * \param data      data
+     *
+     * \returns true if the record was written
+     */
+    template <typename Prefs>
+    static bool save(Prefs &prefs, const char *key, uint8_t version, const T &data)
+    {
+        uint8_t buf[RECORD_SIZE];
+        buf[0] = version;
+        buf[1] = 0;
+        buf[2] = sizeof(T) & 0xFF;
+        buf[3] = sizeof(T) >> 8;
+        memcpy(&buf[HEADER_SIZE], &data, sizeof(T));
+        uint16_t crc = Crc16Table<0x1021>::crc(buf, RECORD_SIZE - 2, 0xFFFF);
+        buf[RECORD_SIZE - 2] = crc & 0xFF;
+        buf[RECORD_SIZE - 1] = crc >> 8;
+        return prefs.putBytes(key, buf, RECORD_SIZE) == RECORD_SIZE;
+    }
+};
+
+#endif // _PREFSBLOB_H
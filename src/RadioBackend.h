@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RadioBackend.h
+//
+// Radio transceiver interface used by WeatherSensor
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _RADIOBACKEND_H
+#define _RADIOBACKEND_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Status codes are RadioLib's - definitions for builds without RadioLib (e.g. host)
+#if !defined(RADIOLIB_ERR_NONE)
+#define RADIOLIB_ERR_NONE (0)
+#define RADIOLIB_ERR_UNKNOWN (-1)
+#define RADIOLIB_ERR_RX_TIMEOUT (-6)
+#endif
+#if !defined(RADIOLIB_ERR_UNSUPPORTED)
+#define RADIOLIB_ERR_UNSUPPORTED (-901)
+#endif
+
+/**
+ * \class RadioBackend
+ *
+ * \brief Radio transceiver as used by WeatherSensor
+ *
+ * Implementations:
+ * - RadioLibBackend: RadioLib transceiver (CC1101, SX1262, SX1276, LR1121), default
+ * - ReplayRadio: replay of recorded frames (e.g. for host tests)
+ *
+ * All functions return RadioLib status codes (RADIOLIB_ERR_NONE on success).
+ */
+class RadioBackend
+{
+public:
+    virtual ~RadioBackend() {}
+
+    /**
+     * \brief Initialize transceiver for reception of Bresser sensors
+     *
+     * FSK, 8.21 kbps, fixed packet length, sync word 0x2DD4; the last sync byte (0xD4)
+     * is received as first byte of each frame.
+     *
+     * \param frequency   frequency in MHz
+     */
+    virtual int16_t begin(double frequency) = 0;
+
+    /**
+     * \brief Start reception, the packet received callback is called for each frame
+     */
+    virtual int16_t startReceive(void) = 0;
+
+    /**
+     * \brief Read received frame
+     *
+     * \param data    frame buffer
+     * \param len     frame length in bytes
+     */
+    virtual int16_t readData(uint8_t *data, size_t len) = 0;
+
+    /**
+     * \brief Get RSSI of last received frame in dBm
+     */
+    virtual float getRSSI(void) = 0;
+
+    /**
+     * \brief Set transceiver to standby mode
+     */
+    virtual int16_t standby(void) = 0;
+
+    /**
+     * \brief Set transceiver to sleep mode
+     */
+    virtual int16_t sleep(void) = 0;
+
+    /**
+     * \brief Set packet received callback (may be called from interrupt context)
+     */
+    virtual void setPacketReceivedAction(void (*func)(void)) = 0;
+
+    /**
+     * \brief Reset transceiver
+     */
+    virtual void reset(void) {}
+
+    /**
+     * \brief Change frequency (receive mode has to be restarted afterwards)
+     *
+     * \param frequency   frequency in MHz
+     */
+    virtual int16_t setFrequency(double frequency)
+    {
+        (void)frequency;
+        return RADIOLIB_ERR_UNSUPPORTED;
+    }
+
+    /**
+     * \brief Get frequency error of last received frame (received carrier - receiver frequency)
+     *
+     * Has to be called after readData() and before startReceive().
+     *
+     * \param error_hz    frequency error in Hz
+     */
+    virtual int16_t getFrequencyError(float &error_hz)
+    {
+        (void)error_hz;
+        return RADIOLIB_ERR_UNSUPPORTED;
+    }
+
+    /**
+     * \brief Get current RSSI in receive mode (e.g. noise level while no frame is received)
+     *
+     * \param rssi    RSSI in dBm
+     */
+    virtual int16_t getInstantRSSI(float &rssi)
+    {
+        (void)rssi;
+        return RADIOLIB_ERR_UNSUPPORTED;
+    }
+};
+
+#endif // _RADIOBACKEND_H
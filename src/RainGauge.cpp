@@ -58,6 +58,13 @@
 // 20260211 Added past24Hours() algorithm
 //          Refactored to use RollingCounter base class
 // 20260221 Improved RollingCounter generalization, documentation, and code deduplication
+// 20261016 Using Preferences: nvData stored as single versioned, CRC-protected record,
+//          loaded once and written only if modified; conversion from previous layout
+//          Stored data is loaded by query functions, too
+//          Added running sums of history buffers and pastMinutes()
+//          Added lastCycle()
+//          lastCycle() returns -1 if an update was ignored
+//          Flush interval is also checked if an update was ignored
 //
 // ToDo: 
 // -
@@ -97,56 +104,8 @@ RTC_DATA_ATTR nvData_t nvData = {
 void
 RainGauge::reset(uint8_t flags)
 {
-#if defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
-    preferences.begin("BWS-RAIN", false);
-    if (flags & RESET_RAIN_H) {
-        hist_init();
-        for (int i=0; i<RAIN_HIST_SIZE; i++) {
-            char buf[7];
-            sprintf(buf, "hist%02d", i);
-            preferences.putShort(buf, nvData.hist[i]);
-        }
-    }
-    if (flags & RESET_RAIN_24H) {
-        hist24h_init();
-        for (int i=0; i<RAIN_HIST_SIZE_24H; i++) {
-            char buf[10];
-            sprintf(buf, "h24h%02d", i);
-            preferences.putShort(buf, nvData.hist24h[i]);
-        }
-    }
-    if (flags & RESET_RAIN_D) {
-        nvData.tsDayBegin     = 0xFF;
-        nvData.rainDayBegin   = 0;
-        preferences.putUChar("tsDayBegin", nvData.tsDayBegin);
-        preferences.putFloat("rainDayBegin", nvData.rainDayBegin);
-    }
-    if (flags & RESET_RAIN_W) {
-        nvData.tsWeekBegin    = 0xFF;
-        nvData.rainWeekBegin  = 0;
-        preferences.putUChar("tsWeekBegin", nvData.tsWeekBegin);
-        preferences.putFloat("rainWeekBegin", nvData.rainWeekBegin);
-    }
-    if (flags & RESET_RAIN_M) {
-        nvData.tsMonthBegin   = 0xFF;
-        nvData.rainMonthBegin = 0;
-        preferences.putUChar("tsMonthBegin", nvData.tsMonthBegin);
-        preferences.putFloat("rainMonthBegin", nvData.rainMonthBegin);
-    }
+    nvLoad();
 
-    if ((flags & (RESET_RAIN_H | RESET_RAIN_D | RESET_RAIN_W | RESET_RAIN_M | RESET_RAIN_24H)) == (RESET_RAIN_H | RESET_RAIN_D | RESET_RAIN_W | RESET_RAIN_M | RESET_RAIN_24H)) {
-        nvData.startupPrev       = false;
-        nvData.rainPreStartup    = 0;
-        nvData.rainPrev          = -1;
-        nvData.rainAcc           = 0;
-        rainCurr                 = 0;
-        preferences.putBool("startupPrev", nvData.startupPrev);
-        preferences.putFloat("rainPreStartup", nvData.rainPreStartup);
-        preferences.putFloat("rainPrev", nvData.rainPrev);
-        preferences.putFloat("rainAcc", nvData.rainAcc);
-    }    
-    preferences.end();
-#else
     if (flags & RESET_RAIN_H) {
         hist_init();
     }
@@ -172,34 +131,110 @@ RainGauge::reset(uint8_t flags)
         nvData.rainPrev          = -1;
         nvData.rainAcc           = 0;
         rainCurr                 = 0;
+        deltaRain                = -1;
     }
-#endif
+    nvModified();
+    flush();
 }
 
 void
 RainGauge::hist_init(int16_t rain)
 {
+    nvLoad();
     for (int i=0; i<RAIN_HIST_SIZE; i++) {
         nvData.hist[i] = rain;
     }
+    hourSums.valid = false;
+    nvModified();
 }
 
 void
 RainGauge::hist24h_init(int16_t rain)
 {
+    nvLoad();
     for (int i=0; i<RAIN_HIST_SIZE_24H; i++) {
         nvData.hist24h[i] = rain;
     }
+    daySums.valid = false;
+    nvModified();
+}
+
+void
+RainGauge::nvLoad(void)
+{
+#if defined(RAINGAUGE_USE_PREFS)
+    if (!nvLoaded) {
+        prefs_load();
+    }
+#endif
+}
+
+void
+RainGauge::nvModified(void)
+{
+#if defined(RAINGAUGE_USE_PREFS)
+    nvDirty = true;
+#endif
+}
+
+void
+RainGauge::nvCommit(time_t timestamp)
+{
+    nvModified();
+#if defined(RAINGAUGE_USE_PREFS)
+    // Write if flush interval has expired (or time has been set back)
+    if ((timestamp - nvFlushed >= static_cast<time_t>(flushInterval)) || (timestamp < nvFlushed)) {
+        flush();
+    }
+#endif
+}
+
+void
+RainGauge::flush(void)
+{
+#if defined(RAINGAUGE_USE_PREFS)
+    if (nvDirty) {
+        prefs_save();
+    }
+#endif
 }
 
-#if defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
+#if defined(RAINGAUGE_USE_PREFS)
+static const char *const PREFS_NAMESPACE = "BWS-RAIN";
+static const char *const PREFS_KEY = "nvData";
+
 void
 RainGauge::prefs_load(void)
 {
-    preferences.begin("BWS-RAIN", false);
+    preferences.begin(PREFS_NAMESPACE, false);
+    PrefsBlob<nvData_t>::Status status = PrefsBlob<nvData_t>::load(preferences, PREFS_KEY, RAINGAUGE_NVDATA_VERSION, nvData);
+    if (status != PrefsBlob<nvData_t>::BLOB_OK) {
+        if (status == PrefsBlob<nvData_t>::BLOB_INVALID) {
+            log_w("Invalid rain gauge data in Preferences - discarded");
+        }
+        // Initial values as with previous layout
+        nvData.rainPrev = -1;
+
+        if (preferences.isKey("rainPrev")) {
+            prefs_migrate();
+        }
+    }
+    preferences.end();
+    nvLoaded = true;
+    nvFlushed = nvData.lastUpdate;
+    hourSums.valid = false;
+    daySums.valid = false;
+
+    log_d("lastUpdate        =%lld", static_cast<long long>(nvData.lastUpdate));
+    log_d("rainPrev          =%f", nvData.rainPrev);
+    log_d("rainAcc           =%f", nvData.rainAcc);
+}
+
+void
+RainGauge::prefs_migrate(void)
+{
+    // Previous layout: one key per member of nvData_t
     nvData.lastUpdate     = preferences.getULong64("lastUpdate", 0);
-    // Optimization: Reduces number of Flash writes
-    // preferences.getBytes("hist", nvData.hist, sizeof(nvData.hist));
     for (int i=0; i<RAIN_HIST_SIZE; i++) {
         char buf[7];
         sprintf(buf, "hist%02d", i);
@@ -223,50 +258,41 @@ RainGauge::prefs_load(void)
     nvData.rainAcc           = preferences.getFloat("rainAcc", 0);
     nvData.updateRate        = preferences.getUChar("updateRate", RAINGAUGE_UPD_RATE);
 
-    log_d("lastUpdate        =%s", String(nvData.lastUpdate).c_str());
-    log_d("startupPrev       =%d", nvData.startupPrev);
-    log_d("rainPreStartup    =%f", nvData.rainPreStartup);
-    log_d("tsDayBegin        =%d", nvData.tsDayBegin);
-    log_d("rainDayBegin      =%f", nvData.rainDayBegin);
-    log_d("tsWeekBegin       =%d", nvData.tsWeekBegin);
-    log_d("rainWeekBegin     =%f", nvData.rainWeekBegin);
-    log_d("wdayPrev          =%d", nvData.wdayPrev);
-    log_d("tsMonthBegin      =%d", nvData.tsMonthBegin);
-    log_d("rainMonthBegin    =%f", nvData.rainMonthBegin);
-    log_d("rainPrev          =%f", nvData.rainPrev);
-    log_d("rainAcc           =%f", nvData.rainAcc);
-    preferences.end();
-}
-
-void
-RainGauge::prefs_save(void)
-{
-    preferences.begin("BWS-RAIN", false);
-    preferences.putULong64("lastUpdate", nvData.lastUpdate);
-    // Optimization: Reduces number of Flash writes
-    // preferences.putBytes("hist", nvData.hist, sizeof(nvData.hist));
+    // Write new record before the old keys are removed
+    if (!PrefsBlob<nvData_t>::save(preferences, PREFS_KEY, RAINGAUGE_NVDATA_VERSION, nvData)) {
+        log_w("Conversion of rain gauge data in Preferences failed");
+        return;
+    }
+    static const char *const keys[] = {
+        "lastUpdate", "startupPrev", "rainPreStartup", "tsDayBegin", "rainDayBegin",
+        "tsWeekBegin", "rainWeekBegin", "wdayPrev", "tsMonthBegin", "rainMonthBegin",
+        "rainPrev", "rainAcc", "updateRate"
+    };
+    for (size_t i=0; i<sizeof(keys)/sizeof(keys[0]); i++) {
+        preferences.remove(keys[i]);
+    }
     for (int i=0; i<RAIN_HIST_SIZE; i++) {
         char buf[7];
         sprintf(buf, "hist%02d", i);
-        preferences.putShort(buf, nvData.hist[i]);
+        preferences.remove(buf);
     }
     for (int i=0; i<RAIN_HIST_SIZE_24H; i++) {
         char buf[10];
         sprintf(buf, "h24h%02d", i);
-        preferences.putShort(buf, nvData.hist24h[i]);
+        preferences.remove(buf);
+    }
+    log_i("Rain gauge data in Preferences converted to single record");
+}
+
+void
+RainGauge::prefs_save(void)
+{
+    preferences.begin(PREFS_NAMESPACE, false);
+    if (PrefsBlob<nvData_t>::save(preferences, PREFS_KEY, RAINGAUGE_NVDATA_VERSION, nvData)) {
+        nvDirty = false;
     }
-    preferences.putBool("startupPrev", nvData.startupPrev);
-    preferences.putFloat("rainPreStartup", nvData.rainPreStartup);
-    preferences.putUChar("tsDayBegin", nvData.tsDayBegin);
-    preferences.putFloat("rainDayBegin", nvData.rainDayBegin);
-    preferences.putUChar("tsWeekBegin", nvData.tsWeekBegin);
-    preferences.putFloat("rainWeekBegin", nvData.rainWeekBegin);
-    preferences.putUChar("wdayPrev", nvData.wdayPrev);
-    preferences.putUChar("tsMonthBegin", nvData.tsMonthBegin);
-    preferences.putFloat("rainMonthBegin", nvData.rainMonthBegin);
-    preferences.putFloat("rainPrev", nvData.rainPrev);
-    preferences.putFloat("rainAcc", nvData.rainAcc);
     preferences.end();
+    nvFlushed = nvData.lastUpdate;
 }
 #endif
 
@@ -274,10 +300,8 @@ RainGauge::prefs_save(void)
 void
 RainGauge::update(time_t timestamp, float rain, bool startup)
 {
-    #if defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
-        prefs_load();
-    #endif
-    
+    nvLoad();
+
     struct tm t;
     localtime_r(&timestamp, &t);
 
@@ -292,10 +316,6 @@ RainGauge::update(time_t timestamp, float rain, bool startup)
         nvData.rainPrev = rain;
         nvData.lastUpdate = timestamp;
         lastUpdate = timestamp;
-        
-        #if defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
-            prefs_save();
-        #endif
     }
 
     rainCurr = nvData.rainAcc + rain;
@@ -366,8 +386,11 @@ RainGauge::update(time_t timestamp, float rain, bool startup)
     // t_delta < 0: something is wrong, e.g. RTC was not set correctly
     if (t_delta < 0) {
         log_w("Negative time span since last update!?");
-        return; 
+        deltaRain = -1;
+        nvCommit(timestamp);
+        return;
     }
+    deltaRain = rainDelta;
 
 
     int idx = t.tm_min / nvData.updateRate;
@@ -376,7 +399,7 @@ RainGauge::update(time_t timestamp, float rain, bool startup)
     // Note: rainDelta is scaled by 100 for storage precision
     updateHistoryBuffer(nvData.hist, RAIN_HIST_SIZE, idx, 
                        static_cast<int16_t>(rainDelta * 100),
-                       t_delta, timestamp, nvData.lastUpdate, nvData.updateRate);
+                       t_delta, timestamp, nvData.lastUpdate, nvData.updateRate, &hourSums);
 
 
     #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
@@ -398,7 +421,7 @@ RainGauge::update(time_t timestamp, float rain, bool startup)
     // Note: rainDelta is scaled by 100 for storage precision
     UpdateResult result24h = updateHistoryBufferCore(nvData.hist24h, RAIN_HIST_SIZE_24H, idx24h,
                                                      static_cast<int16_t>(rainDelta * 100),
-                                                     t_delta, timestamp, nvData.lastUpdate, 60);
+                                                     t_delta, timestamp, nvData.lastUpdate, 60, &daySums);
     if (result24h == UPDATE_EXPIRED) {
         hist24h_init();
     }
@@ -446,18 +469,18 @@ RainGauge::update(time_t timestamp, float rain, bool startup)
     updateRate = nvData.updateRate;
     nvData.rainPrev = rainCurr;
 
-    #if defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
-        prefs_save();
-    #endif
+    nvCommit(timestamp);
 }
 
 float
 RainGauge::pastHour(bool *valid, int *nbins, float *quality)
 {
+    nvLoad();
     History hourHist = {
         .hist = nvData.hist,
         .size = RAIN_HIST_SIZE,
-        .updateRate = nvData.updateRate
+        .updateRate = nvData.updateRate,
+        .sums = &hourSums
     };
     return sumHistory(hourHist, valid, nbins, quality, 0.01);
 }
@@ -465,17 +488,58 @@ RainGauge::pastHour(bool *valid, int *nbins, float *quality)
 float
 RainGauge::past24Hours(bool *valid, int *nbins, float *quality)
 {
+    nvLoad();
     History dayHist = {
         .hist = nvData.hist24h,
         .size = RAIN_HIST_SIZE_24H,
-        .updateRate = 60
+        .updateRate = 60,
+        .sums = &daySums
     };
     return sumHistory(dayHist, valid, nbins, quality, 0.01);
 }
 
+float
+RainGauge::lastCycle(void)
+{
+    return deltaRain;
+}
+
+float
+RainGauge::pastMinutes(unsigned minutes, bool *valid, int *nbins, float *quality)
+{
+    nvLoad();
+    if ((nvData.lastUpdate == 0) || (minutes == 0) || (minutes > 24 * 60)) {
+        setQuality(0, 0, valid, nbins, quality);
+        return 0;
+    }
+
+    if (minutes <= 60) {
+        History hourHist = {
+            .hist = nvData.hist,
+            .size = RAIN_HIST_SIZE,
+            .updateRate = nvData.updateRate,
+            .sums = &hourSums
+        };
+        size_t bins = (minutes + nvData.updateRate - 1) / nvData.updateRate;
+        int newest = calculateIndex(nvData.lastUpdate, nvData.updateRate);
+        return sumRecent(hourHist, bins, newest, valid, nbins, quality, 0.01);
+    }
+
+    History dayHist = {
+        .hist = nvData.hist24h,
+        .size = RAIN_HIST_SIZE_24H,
+        .updateRate = 60,
+        .sums = &daySums
+    };
+    size_t bins = (minutes + 59) / 60;
+    int newest = calculateIndex(nvData.lastUpdate, 60);
+    return sumRecent(dayHist, bins, newest, valid, nbins, quality, 0.01);
+}
+
 float
 RainGauge::currentDay(void)
 {
+    nvLoad();
     if (nvData.tsMonthBegin == 0xFF)
         return -1;
     
@@ -485,6 +549,7 @@ RainGauge::currentDay(void)
 float
 RainGauge::currentWeek(void)
 {
+    nvLoad();
     if (nvData.tsWeekBegin == 0xFF)
         return -1;
     
@@ -494,6 +559,7 @@ RainGauge::currentWeek(void)
 float
 RainGauge::currentMonth(void)
 {
+    nvLoad();
     if (nvData.tsMonthBegin == 0xFF)
         return -1;
     
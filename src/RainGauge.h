@@ -58,6 +58,11 @@
 // 20260211 Added past24Hours()
 //          Refactored to use RollingCounter base class
 // 20260221 Improved RollingCounter generalization, documentation, and code deduplication
+// 20261016 Using RTC RAM: storage can be passed to the constructor (multiple instances)
+//          Using Preferences: nvData stored as single versioned, CRC-protected record,
+//          loaded once and written only if modified (see flush(), setFlushInterval())
+//          Added running sums of history buffers and pastMinutes()
+//          Added lastCycle()
 //
 // ToDo: 
 // -
@@ -72,8 +77,9 @@
   #include <sys/time.h>
 #endif
 #include "RollingCounter.h"
-#if defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
+#if defined(RAINGAUGE_USE_PREFS)
     #include <Preferences.h>
+    #include "PrefsBlob.h"
 #endif
 
 /**
@@ -106,6 +112,24 @@
 #define RAIN_HIST_SIZE_24H 24
 
 
+/**
+ * \def RAINGAUGE_NVDATA_VERSION
+ *
+ * Version of nvData_t stored in Preferences - increment when nvData_t is modified
+ */
+#define RAINGAUGE_NVDATA_VERSION 1
+
+/**
+ * \def RAINGAUGE_FLUSH_INTERVAL
+ *
+ * Minimum interval [s] between writes of modified data to Preferences
+ * (0: write after each update(); see RainGauge::setFlushInterval())
+ */
+#if !defined(RAINGAUGE_FLUSH_INTERVAL)
+#define RAINGAUGE_FLUSH_INTERVAL 0
+#endif
+
+
 /**
  * \defgroup Reset rain counters
  */
@@ -154,6 +178,13 @@ typedef struct {
     uint8_t   updateRate; // update rate for pastHour() calculation
 } nvData_t;
 
+#if !defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
+/**
+ * \brief Default storage in RTC RAM (used if no storage is passed to the constructor)
+ */
+extern nvData_t nvData;
+#endif
+
 /**
  * \class RainGauge
  *
@@ -165,6 +196,9 @@ class RainGauge : public RollingCounter {
 private:
     float rainCurr;
     float raingaugeMax;
+    float deltaRain = -1; //!< rainfall during last update cycle (-1: no valid update)
+    HistorySums hourSums; //!< running sums of nvData.hist
+    HistorySums daySums;  //!< running sums of nvData.hist24h
 
     #if defined(RAINGAUGE_USE_PREFS) || defined(INSIDE_UNITTEST)
     nvData_t nvData = {
@@ -185,8 +219,15 @@ private:
         .updateRate = RAINGAUGE_UPD_RATE
     };
     #endif
-    #if defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
+    #if defined(RAINGAUGE_USE_PREFS)
     Preferences preferences;
+    bool        nvLoaded = false;   //!< nvData has been loaded from Preferences
+    bool        nvDirty = false;    //!< nvData has been modified since last write
+    time_t      nvFlushed = 0;      //!< timestamp of last write
+    uint32_t    flushInterval = RAINGAUGE_FLUSH_INTERVAL;
+    #endif
+    #if !defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
+    nvData_t &nvData;
     #endif
 
 public:
@@ -195,11 +236,29 @@ public:
      * 
      * \param raingauge_max     raingauge value which causes a counter overflow
      * \param quality_threshold fraction of valid rain_hist entries required for valid pastHour() result
+     * \param nv_data           storage in RTC RAM (RTC_DATA_ATTR) - required for each additional instance;
+     *                          ignored with RAINGAUGE_USE_PREFS (default: ::nvData)
      */
-    RainGauge(const float raingauge_max = RAINGAUGE_MAX_VALUE, const float quality_threshold = DEFAULT_QUALITY_THRESHOLD) :
+    RainGauge(const float raingauge_max = RAINGAUGE_MAX_VALUE, const float quality_threshold = DEFAULT_QUALITY_THRESHOLD,
+              nvData_t *nv_data = nullptr) :
         RollingCounter(quality_threshold),
         raingaugeMax(raingauge_max)
-    {};
+    #if !defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
+        , nvData(nv_data ? *nv_data : ::nvData)
+    #endif
+    {
+        (void)nv_data;
+    };
+
+    #if defined(RAINGAUGE_USE_PREFS)
+    /**
+     * Destructor - writes modified data to Preferences
+     */
+    ~RainGauge()
+    {
+        flush();
+    }
+    #endif
 
     /**
      * Set maximum rain counter value
@@ -255,22 +314,45 @@ public:
             return false;
         }
         
-        #if !defined(INSIDE_UNITTEST)
-        preferences.begin("BWS-RAIN", false);
-        uint8_t updateRatePrev = preferences.getUChar("updateRate", RAINGAUGE_UPD_RATE);
-        preferences.putUChar("updateRate", rate);
-        preferences.end();
-        #else
-        static uint8_t updateRatePrev = RAINGAUGE_UPD_RATE;
-        updateRatePrev = nvData.updateRate;
-        #endif
-        nvData.updateRate = rate;
-        if (nvData.updateRate != updateRatePrev) {
+        nvLoad();
+        if (nvData.updateRate != rate) {
+            nvData.updateRate = rate;
             hist_init();
+            nvModified();
+            flush();
         }
         return true;
     }
 
+    /**
+     * \brief Set minimum interval between writes of modified data to Preferences
+     *
+     * With RAINGAUGE_USE_PREFS, nvData is loaded once and written as a single record
+     * only if it has been modified. By default (interval 0), it is written after each
+     * update(). A longer interval reduces flash wear and update() latency; in this case
+     * flush() must be called before the data would be lost (e.g. before deep sleep).
+     *
+     * Without RAINGAUGE_USE_PREFS (RTC RAM), this function has no effect.
+     *
+     * \param interval  interval in seconds (timestamps passed to update())
+     */
+    void setFlushInterval(uint32_t interval)
+    {
+        #if defined(RAINGAUGE_USE_PREFS)
+        flushInterval = interval;
+        #else
+        (void)interval;
+        #endif
+    }
+
+    /**
+     * \brief Write modified data to Preferences
+     *
+     * Call before deep sleep or power down if a flush interval has been set.
+     * Without RAINGAUGE_USE_PREFS (RTC RAM), this function has no effect.
+     */
+    void flush(void);
+
     /**
      * Reset non-volatile data and current rain counter value
      * 
@@ -292,8 +374,17 @@ public:
      */
     void hist24h_init(int16_t rain = -1);
 
-    #if defined(RAINGAUGE_USE_PREFS) && !defined(INSIDE_UNITTEST)
+    #if defined(RAINGAUGE_USE_PREFS)
+    /**
+     * Load nvData from Preferences
+     *
+     * Data stored in the previous layout (one key per member) is converted.
+     */
     void prefs_load(void);
+
+    /**
+     * Write nvData to Preferences
+     */
     void prefs_save(void);
     #endif
 
@@ -332,6 +423,31 @@ public:
      */
     float past24Hours(bool *valid = nullptr, int *nbins = nullptr, float *quality = nullptr);
 
+    /**
+     * Rainfall during past minutes
+     *
+     * Sum of the most recent history bins covering the given time span (rounded up
+     * to full bins) up to the last update:
+     * - up to 60 minutes: from hourly history (resolution: update rate)
+     * - up to 24 hours: from 24-hour history (resolution: 1 hour)
+     *
+     * \param minutes   time span in minutes (1...1440)
+     * \param valid     number of valid bins >= qualityThreshold * number of bins
+     * \param nbins     number of valid bins
+     * \param quality   fraction of valid bins (0..1)
+     *
+     * \returns amount of rain during past minutes
+     */
+    float pastMinutes(unsigned minutes, bool *valid = nullptr, int *nbins = nullptr, float *quality = nullptr);
+
+    /**
+     * Rainfall during last update cycle
+     *
+     * \returns amount of rain since previous update (-1: no update since reset / start
+     *          or last update ignored, e.g. due to negative time span)
+     */
+    float lastCycle(void);
+
     /**
      * Rainfall of current calendar day
      * 
@@ -352,5 +468,27 @@ public:
      * \returns amount of rain
      */
     float currentMonth(void);
+
+private:
+    /**
+     * Load nvData from Preferences if not done yet
+     */
+    void nvLoad(void);
+
+    /**
+     * Mark nvData as modified
+     */
+    void nvModified(void);
+
+    /**
+     * Mark nvData as modified and write it if the flush interval has expired
+     *
+     * \param timestamp    time of update
+     */
+    void nvCommit(time_t timestamp);
+
+    #if defined(RAINGAUGE_USE_PREFS)
+    void prefs_migrate(void);
+    #endif
 };
 #endif // _RAINGAUGE_H
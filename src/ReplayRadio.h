@@ -0,0 +1,406 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ReplayRadio.h
+//
+// Radio backend replaying recorded frames (e.g. for tests on a Linux host)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _REPLAYRADIO_H
+#define _REPLAYRADIO_H
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "RadioBackend.h"
+
+/**
+ * \class ReplayRadio
+ *
+ * \brief Radio backend which replays recorded frames at their original time
+ *
+ * Frames are delivered by poll() when they are due (millis() since begin()/rewind()).
+ * If the receiver is in receive mode, the frame can be read with readData() and the
+ * packet received callback is called. Otherwise (standby/sleep) the frame is lost.
+ * A frame which has not been read before the next one is delivered is overwritten.
+ *
+ * With 'bandwidth' set, frames with a carrier frequency outside of the receiver bandwidth
+ * are lost and frames in the outer 20% of the bandwidth are read with bit errors.
+ *
+ * Interference (see addInterference()) raises the RSSI in receive mode above 'noiseFloor';
+ * frames received during interference are read with bit errors.
+ *
+ * poll() has to be called regularly, e.g. from the callback function of
+ * WeatherSensor::getData() or from delay() on the host.
+ *
+ * Frame file format (text, one frame per line, '#' starts a comment):
+ *
+ *     <time in ms> <RSSI in dBm> <frame bytes in hex, e.g. D4 5E AA ...>
+ *
+ * Times are relative to the start of the replay and must be in ascending order.
+ * The frame bytes are as read from the transceiver, i.e. starting with the last sync byte
+ * (0xD4) - this is the format of WeatherSensor's verbose log output ("Data: D4 ...").
+ */
+class ReplayRadio : public RadioBackend
+{
+public:
+    static const size_t MAX_FRAME_SIZE = 32;   //!< maximum frame size in bytes
+
+    enum Mode
+    {
+        MODE_SLEEP,
+        MODE_STANDBY,
+        MODE_RX
+    };
+
+    /**
+     * \brief Recorded frame
+     */
+    struct Frame
+    {
+        uint32_t time;                   //!< time after start of replay in ms
+        float rssi;                      //!< RSSI in dBm
+        uint8_t len;                     //!< frame length in bytes
+        uint8_t data[MAX_FRAME_SIZE];    //!< frame data
+        double carrier;                  //!< carrier frequency in MHz (0: receiver frequency)
+    };
+
+    uint32_t delivered = 0;      //!< frames delivered in receive mode
+    uint32_t dropped = 0;        //!< frames lost because receiver was not in receive mode or out of band
+    float noiseFloor = -110.0;   //!< RSSI without frame in dBm (+/-2 dB random variation, see getInstantRSSI())
+    double bandwidth = 0;        //!< receiver bandwidth in kHz (0: frames are received at any frequency)
+
+    /**
+     * \brief Add frame to replay
+     *
+     * \param time    time after start of replay in ms (>= time of previous frame)
+     * \param rssi    RSSI in dBm
+     * \param data    frame data
+     * \param len     frame length in bytes (<= MAX_FRAME_SIZE)
+     * \param carrier carrier frequency in MHz (0: receiver frequency, no frequency error)
+     *
+     * \returns false if frame is invalid
+     */
+    bool add(uint32_t time, float rssi, const uint8_t *data, size_t len, double carrier = 0)
+    {
+        if ((len == 0) || (len > MAX_FRAME_SIZE) || (!frames.empty() && (time < frames.back().time)))
+            return false;
+
+        Frame frame;
+        frame.time = time;
+        frame.rssi = rssi;
+        frame.len = len;
+        frame.carrier = carrier;
+        memcpy(frame.data, data, len);
+        frames.push_back(frame);
+        return true;
+    }
+
+    /**
+     * \brief Add interference
+     *
+     * \param time     time after start of replay in ms
+     * \param duration duration in ms
+     * \param level    RSSI during interference in dBm
+     */
+    void addInterference(uint32_t time, uint32_t duration, float level)
+    {
+        interferers.push_back(Interferer{time, duration, level});
+    }
+
+    /**
+     * \brief Load frames from file (see class description)
+     *
+     * \param path    file name
+     *
+     * \returns number of frames loaded or -1 if the file could not be opened
+     */
+    int load(const char *path)
+    {
+        FILE *fp = fopen(path, "r");
+        if (!fp)
+            return -1;
+
+        int count = 0;
+        char line[256];
+        while (fgets(line, sizeof(line), fp))
+        {
+            unsigned long time;
+            float rssi;
+            int pos = 0;
+            if ((line[0] == '#') || (sscanf(line, "%lu %f %n", &time, &rssi, &pos) != 2))
+                continue;
+
+            uint8_t data[MAX_FRAME_SIZE];
+            size_t len = 0;
+            int nibbles = 0;
+            for (const char *p = &line[pos]; *p && (*p != '#') && (len < MAX_FRAME_SIZE); p++)
+            {
+                int digit = hexDigit(*p);
+                if (digit < 0)
+                    continue;
+                data[len] = (nibbles & 1) ? (data[len] << 4) | digit : digit;
+                if (nibbles++ & 1)
+                    len++;
+            }
+            if (add(time, rssi, data, len))
+                count++;
+        }
+        fclose(fp);
+        return count;
+    }
+
+    /**
+     * \brief Remove all frames
+     */
+    void clear(void)
+    {
+        frames.clear();
+        interferers.clear();
+        rewind();
+    }
+
+    /**
+     * \brief Restart replay at current time
+     */
+    void rewind(void)
+    {
+        start = millis();
+        next = 0;
+        pending = false;
+        delivered = 0;
+        dropped = 0;
+    }
+
+    /**
+     * \brief Deliver due frames
+     */
+    void poll(void)
+    {
+        uint32_t now = millis() - start;
+        while ((next < frames.size()) && (now >= frames[next].time))
+        {
+            if ((mode == MODE_RX) && (inBand(frames[next]) >= 0))
+            {
+                current = next;
+                pending = true;
+                delivered++;
+                if (callback)
+                    callback();
+            }
+            else
+            {
+                dropped++;
+            }
+            next++;
+        }
+    }
+
+    /**
+     * \brief Check if all frames have been replayed
+     */
+    bool done(void) const
+    {
+        return next >= frames.size();
+    }
+
+    /**
+     * \brief Get time of next frame after start of replay in ms
+     *
+     * \returns time or UINT32_MAX if all frames have been replayed
+     */
+    uint32_t nextTime(void) const
+    {
+        return done() ? UINT32_MAX : frames[next].time;
+    }
+
+    /**
+     * \brief Get current transceiver mode
+     */
+    Mode getMode(void) const
+    {
+        return mode;
+    }
+
+    /**
+     * \brief Get frequency set by begin() or setFrequency() in MHz
+     */
+    double getFrequency(void) const
+    {
+        return frequency;
+    }
+
+    int16_t begin(double freq) override
+    {
+        frequency = freq;
+        mode = MODE_STANDBY;
+        rewind();
+        return RADIOLIB_ERR_NONE;
+    }
+
+    int16_t startReceive(void) override
+    {
+        mode = MODE_RX;
+        return RADIOLIB_ERR_NONE;
+    }
+
+    int16_t readData(uint8_t *data, size_t len) override
+    {
+        if (!pending)
+            return RADIOLIB_ERR_RX_TIMEOUT;
+
+        const Frame &frame = frames[current];
+        for (size_t i = 0; i < len; i++)
+            data[i] = (i < frame.len) ? frame.data[i] : 0;
+        if (((inBand(frame) == 0) || (interference(frame.time) > -200)) && (len > 2))
+        {
+            // Burst errors at the start of the message - too many for error correction
+            data[1] ^= 0x5A;
+            data[2] ^= 0xA5;
+        }
+        rssi = frame.rssi;
+        freqError = (frame.carrier != 0) ? (frame.carrier - frequency) * 1e6 : 0;
+        pending = false;
+        mode = MODE_STANDBY;
+        return RADIOLIB_ERR_NONE;
+    }
+
+    float getRSSI(void) override
+    {
+        return (mode == MODE_STANDBY) ? rssi : noiseFloor;
+    }
+
+    int16_t standby(void) override
+    {
+        mode = MODE_STANDBY;
+        return RADIOLIB_ERR_NONE;
+    }
+
+    int16_t sleep(void) override
+    {
+        mode = MODE_SLEEP;
+        pending = false;
+        return RADIOLIB_ERR_NONE;
+    }
+
+    void setPacketReceivedAction(void (*func)(void)) override
+    {
+        callback = func;
+    }
+
+    int16_t setFrequency(double freq) override
+    {
+        frequency = freq;
+        return RADIOLIB_ERR_NONE;
+    }
+
+    int16_t getFrequencyError(float &error_hz) override
+    {
+        error_hz = freqError;
+        return RADIOLIB_ERR_NONE;
+    }
+
+    int16_t getInstantRSSI(float &level) override
+    {
+        if (mode != MODE_RX)
+            return RADIOLIB_ERR_UNKNOWN;
+        float noise = noiseFloor + (rand() % 5) - 2;
+        float interferer = interference(millis() - start);
+        level = (interferer > noise) ? interferer : noise;
+        return RADIOLIB_ERR_NONE;
+    }
+
+private:
+    struct Interferer
+    {
+        uint32_t time;
+        uint32_t duration;
+        float level;
+    };
+
+    // Level of interference at time after start of replay in dBm (-200: none)
+    float interference(uint32_t time) const
+    {
+        float level = -200;
+        for (const Interferer &i : interferers)
+        {
+            if ((time - i.time < i.duration) && (i.level > level))
+                level = i.level;
+        }
+        return level;
+    }
+
+    // Reception of frame: -1 - out of band, 0 - with bit error, 1 - ok
+    int inBand(const Frame &frame) const
+    {
+        if ((bandwidth == 0) || (frame.carrier == 0))
+            return 1;
+        double offset = (frame.carrier - frequency) * 1000;
+        if (offset < 0)
+            offset = -offset;
+        if (offset > bandwidth / 2)
+            return -1;
+        return (offset > bandwidth * 0.4) ? 0 : 1;
+    }
+
+    static int hexDigit(char c)
+    {
+        if ((c >= '0') && (c <= '9'))
+            return c - '0';
+        if ((c >= 'a') && (c <= 'f'))
+            return c - 'a' + 10;
+        if ((c >= 'A') && (c <= 'F'))
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    std::vector<Frame> frames;
+    std::vector<Interferer> interferers;
+    size_t next = 0;
+    size_t current = 0;
+    bool pending = false;
+    uint32_t start = 0;
+    float rssi = -110.0;
+    float freqError = 0;
+    double frequency = 0;
+    Mode mode = MODE_SLEEP;
+    void (*callback)(void) = nullptr;
+};
+
+#endif // _REPLAYRADIO_H
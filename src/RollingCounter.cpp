@@ -36,6 +36,9 @@
 //
 // 20260211 Created from common code in RainGauge and Lightning
 // 20260221 Improved generalization, documentation, and code deduplication
+// 20261016 Bin index of past timestamps calculated from cached UTC offset
+//          instead of localtime_r()
+//          Added running sums (HistorySums) and sumRecent()
 //
 // ToDo: 
 // -
@@ -58,9 +61,73 @@ RollingCounter::calculateIndex(const struct tm& tm, uint8_t rate) const
     }
 }
 
+// Days since 1970-01-01 (proleptic Gregorian calendar)
+// see https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+static long
+daysFromCivil(long y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const long era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<long>(doe) - 719468;
+}
+
+long
+RollingCounter::localOffset(time_t t)
+{
+    struct tm tm;
+    localtime_r(&t, &tm);
+    long long local = static_cast<long long>(daysFromCivil(tm.tm_year + 1900L, tm.tm_mon + 1, tm.tm_mday)) * 86400 +
+                      tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    return static_cast<long>(local - t);
+}
+
+long
+RollingCounter::utcOffset(time_t t)
+{
+    if ((t >= tzFrom) && (t <= tzUntil)) {
+        return tzOffset;
+    }
+
+    long offset = localOffset(t);
+    time_t until = t + TZ_HORIZON;
+    if (localOffset(until) != offset) {
+        // Find last second before transition
+        time_t lo = t;
+        while (until - lo > 1) {
+            time_t mid = lo + (until - lo) / 2;
+            if (localOffset(mid) == offset) {
+                lo = mid;
+            } else {
+                until = mid;
+            }
+        }
+        until = lo;
+    }
+    tzFrom = t;
+    tzUntil = until;
+    tzOffset = offset;
+    return offset;
+}
+
+int
+RollingCounter::calculateIndex(time_t t, uint8_t rate)
+{
+    long long local = static_cast<long long>(t) + utcOffset(t);
+    long secOfDay = static_cast<long>(((local % 86400) + 86400) % 86400);
+
+    if (rate >= 60) {
+        return secOfDay / 3600;
+    } else {
+        return (secOfDay / 60 % 60) / rate;
+    }
+}
+
 void 
 RollingCounter::markMissedEntries(int16_t* hist, size_t size, time_t lastUpdate, 
-                                  time_t timestamp, uint8_t rate)
+                                  time_t timestamp, uint8_t rate, HistorySums *sums)
 {
     // Guard against invalid rate values to avoid division by zero
     if (rate == 0) {
@@ -70,113 +137,206 @@ RollingCounter::markMissedEntries(int16_t* hist, size_t size, time_t lastUpdate,
 
     // Mark all history entries in interval [expected_index, current_index) as invalid
     // N.B.: excluding current index!
+    // (Index from cached UTC offset - localtime_r() is only called near DST transitions)
     for (time_t ts = lastUpdate + (rate * 60); ts < timestamp; ts += rate * 60) {
-        struct tm timeinfo;
-        localtime_r(&ts, &timeinfo);
-        int idx = calculateIndex(timeinfo, rate);
+        int idx = calculateIndex(ts, rate);
         
         // Use provided size to guard against out-of-bounds writes
         if (idx < 0 || static_cast<size_t>(idx) >= size) {
-            log_w("markMissedEntries: computed index %d out of bounds (size=%u, hour=%d, minute=%d, rate=%u)",
-                  idx, static_cast<unsigned>(size), timeinfo.tm_hour, timeinfo.tm_min, rate);
+            log_w("markMissedEntries: computed index %d out of bounds (size=%u, rate=%u)",
+                  idx, static_cast<unsigned>(size), rate);
             continue;
         }
         
-        hist[idx] = -1;
+        setEntry(hist, size, idx, -1, sums);
         log_d("hist[%d]=-1", idx);
     }
 }
 
-float 
-RollingCounter::sumHistory(const History& h, bool *valid, int *nbins, float *quality, float scale)
+void
+RollingCounter::setEntry(int16_t *hist, size_t size, int idx, int16_t value, HistorySums *sums)
 {
-    int entries = 0;
-    float res = 0;
+    if ((sums != nullptr) && sums->valid && (size <= ROLLING_COUNTER_MAX_BINS)) {
+        int32_t diff = (value >= 0 ? value : 0) - (hist[idx] >= 0 ? hist[idx] : 0);
+        int cdiff = (value >= 0 ? 1 : 0) - (hist[idx] >= 0 ? 1 : 0);
+        if ((diff != 0) || (cdiff != 0)) {
+            for (size_t i = idx + 1; i <= size; i++) {
+                sums->prefix[i] += diff;
+                sums->count[i] += cdiff;
+            }
+        }
+    }
+    hist[idx] = value;
+}
 
-    // Validate updateRate to avoid division by zero
-    if (h.updateRate == 0) {
-        log_w("sumHistory called with invalid updateRate=0");
-        if (nbins != nullptr)
-            *nbins = 0;
-        if (valid != nullptr)
-            *valid = false;
-        if (quality != nullptr)
-            *quality = 0.0f;
-        return 0.0f;
+void
+RollingCounter::rebuildSums(const int16_t *hist, size_t size, HistorySums &sums)
+{
+    if (size > ROLLING_COUNTER_MAX_BINS) {
+        sums.valid = false;
+        return;
     }
+    sums.prefix[0] = 0;
+    sums.count[0] = 0;
+    for (size_t i = 0; i < size; i++) {
+        bool isValid = hist[i] >= 0;
+        sums.prefix[i + 1] = sums.prefix[i] + (isValid ? hist[i] : 0);
+        sums.count[i + 1] = sums.count[i] + (isValid ? 1 : 0);
+    }
+    sums.valid = true;
+}
 
+size_t
+RollingCounter::effectiveBins(const History &h)
+{
     // Calculate the effective number of bins based on size and update rate
     // For hourly buffer: 60 minutes / updateRate = number of bins
     // For 24h buffer: size is already correct (24 bins for 24 hours)
-    size_t effectiveBins;
+    size_t bins;
     if (h.updateRate == 60) {
         // 24-hour buffer: size is already the effective bin count
-        effectiveBins = h.size;
+        bins = h.size;
     } else if (h.updateRate > 60) {
         // Invalid rate for hourly buffer, can't have update rate > 60 minutes
         log_w("sumHistory called with updateRate=%u > 60 minutes", h.updateRate);
-        effectiveBins = 1; // Fallback to avoid division by zero
+        bins = 1; // Fallback to avoid division by zero
     } else {
         // Hourly buffer: calculate bins based on update rate
-        effectiveBins = 60 / h.updateRate;
+        bins = 60 / h.updateRate;
         // Constrain to actual buffer size
-        if (effectiveBins > h.size) {
-            effectiveBins = h.size;
-        }
-    }
-
-    // Sum of all valid entries, but only count bins within the effective range
-    size_t binsToCheck = (effectiveBins < h.size) ? effectiveBins : h.size;
-    for (size_t i = 0; i < binsToCheck; i++){
-        if (h.hist[i] >= 0) {
-            res += h.hist[i] * scale;
-            entries++;
+        if (bins > h.size) {
+            bins = h.size;
         }
     }
+    return bins;
+}
 
+void
+RollingCounter::setQuality(int entries, size_t bins, bool *valid, int *nbins, float *quality) const
+{
     // Optional: return number of valid bins
     if (nbins != nullptr)
         *nbins = entries;
     
     // Optional: return valid flag
     if (valid != nullptr) {
-        if (entries >= qualityThreshold * effectiveBins) {
-            *valid = true;
-        } else {
-            *valid = false;
-        }
+        *valid = (bins > 0) && (entries >= qualityThreshold * bins);
     }
 
     // Optional: return quality
     if (quality != nullptr) {
-        if (effectiveBins > 0) {
-            *quality = static_cast<float>(entries) / effectiveBins;
+        if (bins > 0) {
+            *quality = static_cast<float>(entries) / bins;
         } else {
             *quality = 0.0f;
         }
     }
+}
+
+float 
+RollingCounter::sumHistory(const History& h, bool *valid, int *nbins, float *quality, float scale)
+{
+    int entries = 0;
+    float res = 0;
+
+    // Validate updateRate to avoid division by zero
+    if (h.updateRate == 0) {
+        log_w("sumHistory called with invalid updateRate=0");
+        setQuality(0, 0, valid, nbins, quality);
+        return 0.0f;
+    }
+
+    size_t bins = effectiveBins(h);
+
+    // Sum of all valid entries, but only count bins within the effective range
+    size_t binsToCheck = (bins < h.size) ? bins : h.size;
+    if ((h.sums != nullptr) && (h.size <= ROLLING_COUNTER_MAX_BINS)) {
+        if (!h.sums->valid) {
+            rebuildSums(h.hist, h.size, *h.sums);
+        }
+        res = h.sums->prefix[binsToCheck] * scale;
+        entries = h.sums->count[binsToCheck];
+    } else {
+        for (size_t i = 0; i < binsToCheck; i++){
+            if (h.hist[i] >= 0) {
+                res += h.hist[i] * scale;
+                entries++;
+            }
+        }
+    }
 
+    setQuality(entries, bins, valid, nbins, quality);
     return res;
 }
 
+float
+RollingCounter::sumRecent(const History &h, size_t bins, int newest, bool *valid, int *nbins, float *quality, float scale)
+{
+    if (h.updateRate == 0) {
+        log_w("sumRecent called with invalid updateRate=0");
+        setQuality(0, 0, valid, nbins, quality);
+        return 0.0f;
+    }
+
+    size_t n = effectiveBins(h);
+    if (n > h.size) {
+        n = h.size;
+    }
+    if (bins > n) {
+        bins = n;
+    }
+    if ((newest < 0) || (static_cast<size_t>(newest) >= n)) {
+        log_w("sumRecent: index %d out of bounds (bins=%u)", newest, static_cast<unsigned>(n));
+        setQuality(0, bins, valid, nbins, quality);
+        return 0.0f;
+    }
+
+    int32_t sum = 0;
+    int entries = 0;
+    if ((h.sums != nullptr) && (h.size <= ROLLING_COUNTER_MAX_BINS)) {
+        if (!h.sums->valid) {
+            rebuildSums(h.hist, h.size, *h.sums);
+        }
+        // Bins [first, newest] - wrapping around to [n + first, n - 1] if first < 0
+        int first = newest + 1 - static_cast<int>(bins);
+        const HistorySums &s = *h.sums;
+        if (first >= 0) {
+            sum = s.prefix[newest + 1] - s.prefix[first];
+            entries = s.count[newest + 1] - s.count[first];
+        } else {
+            sum = s.prefix[newest + 1] + s.prefix[n] - s.prefix[n + first];
+            entries = s.count[newest + 1] + s.count[n] - s.count[n + first];
+        }
+    } else {
+        for (size_t k = 0; k < bins; k++) {
+            int16_t v = h.hist[(newest + n - k) % n];
+            if (v >= 0) {
+                sum += v;
+                entries++;
+            }
+        }
+    }
+
+    setQuality(entries, bins, valid, nbins, quality);
+    return sum * scale;
+}
+
 RollingCounter::UpdateResult
 RollingCounter::updateHistoryBufferCore(int16_t* hist, size_t size, int idx, int16_t delta,
                                        time_t t_delta, time_t timestamp, time_t lastUpdate,
-                                       uint8_t updateRate)
+                                       uint8_t updateRate, HistorySums *sums)
 {
     if (t_delta / 60 < updateRate) {
         // t_delta shorter than expected update rate
         if (hist[idx] < 0)
-            hist[idx] = 0;
-        struct tm t_prev;
-        localtime_r(&lastUpdate, &t_prev);
-        if (calculateIndex(t_prev, updateRate) == idx) {
+            setEntry(hist, size, idx, 0, sums);
+        if (calculateIndex(lastUpdate, updateRate) == idx) {
             // same index as in previous cycle - add value
-            hist[idx] += delta;
+            setEntry(hist, size, idx, hist[idx] + delta, sums);
             log_d("hist[%d]=%d (upd)", idx, hist[idx]);
         } else {
             // different index - new value
-            hist[idx] = delta;
+            setEntry(hist, size, idx, delta, sums);
             log_d("hist[%d]=%d (new)", idx, hist[idx]);
         }
         return UPDATE_SUCCESS;
@@ -190,10 +350,10 @@ RollingCounter::updateHistoryBufferCore(int16_t* hist, size_t size, int idx, int
         // Some other index
         
         // Mark missed entries
-        markMissedEntries(hist, size, lastUpdate, timestamp, updateRate);
+        markMissedEntries(hist, size, lastUpdate, timestamp, updateRate, sums);
         
         // Write delta
-        hist[idx] = delta;
+        setEntry(hist, size, idx, delta, sums);
         log_d("hist[%d]=%d", idx, delta);
         return UPDATE_SUCCESS;
     }
@@ -202,10 +362,10 @@ RollingCounter::updateHistoryBufferCore(int16_t* hist, size_t size, int idx, int
 void
 RollingCounter::updateHistoryBuffer(int16_t* hist, size_t size, int idx, int16_t delta,
                                    time_t t_delta, time_t timestamp, time_t lastUpdate,
-                                   uint8_t updateRate)
+                                   uint8_t updateRate, HistorySums *sums)
 {
     UpdateResult result = updateHistoryBufferCore(hist, size, idx, delta, t_delta, 
-                                                  timestamp, lastUpdate, updateRate);
+                                                  timestamp, lastUpdate, updateRate, sums);
     if (result == UPDATE_EXPIRED) {
         hist_init();
     }
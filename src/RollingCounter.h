@@ -36,6 +36,10 @@
 //
 // 20260211 Created from common code in RainGauge and Lightning
 // 20260221 Improved generalization, documentation, and code deduplication
+// 20261016 Bin index of past timestamps calculated from cached UTC offset
+//          instead of localtime_r()
+//          Added running sums (HistorySums) and sumRecent()
+//          Added timezoneChanged()
 //
 // ToDo:
 // -
@@ -66,6 +70,31 @@
  */
 #define DEFAULT_QUALITY_THRESHOLD 0.8
 
+/**
+ * \def
+ *
+ * Maximum history buffer size with running sums (see HistorySums)
+ */
+#define ROLLING_COUNTER_MAX_BINS 24
+
+/**
+ * \struct HistorySums
+ *
+ * \brief Running sums of the valid entries of a history buffer
+ *
+ * prefix[i] / count[i]: sum / number of valid entries in hist[0...i-1]
+ *
+ * Updated with each write to the history buffer via RollingCounter, so that
+ * queries do not have to iterate over the buffer. Not stored in non-volatile
+ * memory - rebuilt from the history buffer if 'valid' is false.
+ */
+struct HistorySums
+{
+    bool valid = false;                             //!< false: rebuild required
+    int32_t prefix[ROLLING_COUNTER_MAX_BINS + 1];   //!< prefix sums
+    uint8_t count[ROLLING_COUNTER_MAX_BINS + 1];    //!< number of valid entries
+};
+
 /**
  * \class RollingCounter
  *
@@ -109,6 +138,7 @@ protected:
         int16_t *hist;      // pointer to buffer
         size_t size;        // number of bins
         uint8_t updateRate; // minutes per bin
+        HistorySums *sums;  // running sums (optional)
     } History;
 
     /**
@@ -121,6 +151,32 @@ protected:
      */
     int calculateIndex(const struct tm &tm, uint8_t rate) const;
 
+    /**
+     * Get offset of local time to UTC
+     *
+     * localtime_r() is only called if t is outside of the cached interval with
+     * constant offset. The interval is extended by TZ_HORIZON from t; if the offset
+     * at its end differs (DST transition), the interval ends at the transition
+     * (bisection). Assumption: no more than one transition within TZ_HORIZON.
+     *
+     * \param t         timestamp
+     *
+     * \returns offset in seconds (local time - UTC)
+     */
+    long utcOffset(time_t t);
+
+    /**
+     * Calculate index into history buffer based on timestamp
+     *
+     * Same result as calculateIndex() with localtime_r(t), but using the cached UTC offset
+     *
+     * \param t         timestamp
+     * \param rate      update rate in minutes
+     *
+     * \returns index into history buffer
+     */
+    int calculateIndex(time_t t, uint8_t rate);
+
     /**
      * Mark history entries as invalid for missed update cycles
      *
@@ -129,9 +185,30 @@ protected:
      * \param lastUpdate    timestamp of last update
      * \param timestamp     current timestamp
      * \param rate          update rate in minutes
+     * \param sums          running sums (optional)
      */
     void markMissedEntries(int16_t *hist, size_t size, time_t lastUpdate,
-                           time_t timestamp, uint8_t rate);
+                           time_t timestamp, uint8_t rate, HistorySums *sums = nullptr);
+
+    /**
+     * Write history entry and update running sums
+     *
+     * \param hist          history buffer
+     * \param size          buffer size
+     * \param idx           index
+     * \param value         new value (< 0: invalid)
+     * \param sums          running sums (optional)
+     */
+    static void setEntry(int16_t *hist, size_t size, int idx, int16_t value, HistorySums *sums);
+
+    /**
+     * Rebuild running sums from history buffer
+     *
+     * \param hist          history buffer
+     * \param size          buffer size
+     * \param sums          running sums
+     */
+    static void rebuildSums(const int16_t *hist, size_t size, HistorySums &sums);
 
     /**
      * Update history buffer with new delta value (core logic without init)
@@ -149,12 +226,13 @@ protected:
      * \param timestamp     current timestamp
      * \param lastUpdate    timestamp of last update
      * \param updateRate    update rate in minutes
+     * \param sums          running sums (optional)
      *
      * \returns UPDATE_SUCCESS or UPDATE_EXPIRED
      */
     UpdateResult updateHistoryBufferCore(int16_t *hist, size_t size, int idx, int16_t delta,
                                          time_t t_delta, time_t timestamp, time_t lastUpdate,
-                                         uint8_t updateRate);
+                                         uint8_t updateRate, HistorySums *sums = nullptr);
 
     /**
      * Update history buffer with new delta value
@@ -172,10 +250,11 @@ protected:
      * \param timestamp     current timestamp
      * \param lastUpdate    timestamp of last update
      * \param updateRate    update rate in minutes
+     * \param sums          running sums (optional)
      */
     void updateHistoryBuffer(int16_t *hist, size_t size, int idx, int16_t delta,
                              time_t t_delta, time_t timestamp, time_t lastUpdate,
-                             uint8_t updateRate);
+                             uint8_t updateRate, HistorySums *sums = nullptr);
 
     /**
      * Initialize history buffer - must be implemented by derived classes
@@ -189,6 +268,8 @@ protected:
     /**
      * Sum all valid entries in a history buffer
      *
+     * With running sums (h.sums), the result is available without iterating over the buffer.
+     *
      * \param h          History buffer to sum
      * \param valid      pointer to bool indicating if result is valid (optional)
      * \param nbins      pointer to int for number of valid bins (optional)
@@ -200,6 +281,56 @@ protected:
     float sumHistory(const History &h, bool *valid = nullptr, int *nbins = nullptr,
                      float *quality = nullptr, float scale = 1.0);
 
+    /**
+     * Sum valid entries of the most recent bins in a history buffer
+     *
+     * The bins [newest - bins + 1, newest] (modulo number of bins) are evaluated.
+     * With running sums (h.sums), the result is available without iterating over the buffer.
+     *
+     * \param h          History buffer
+     * \param bins       number of bins (limited to number of bins in h)
+     * \param newest     index of most recent bin
+     * \param valid      pointer to bool indicating if result is valid (optional)
+     * \param nbins      pointer to int for number of valid bins (optional)
+     * \param quality    pointer to float for quality metric (optional)
+     * \param scale      scaling factor to apply to values (default: 1.0)
+     *
+     * \returns sum of valid entries
+     */
+    float sumRecent(const History &h, size_t bins, int newest, bool *valid = nullptr, int *nbins = nullptr,
+                    float *quality = nullptr, float scale = 1.0);
+
+    /**
+     * Set optional quality outputs of sumHistory() / sumRecent()
+     *
+     * \param entries    number of valid bins
+     * \param bins       number of bins evaluated (0: result invalid)
+     * \param valid      pointer to bool indicating if result is valid (optional)
+     * \param nbins      pointer to int for number of valid bins (optional)
+     * \param quality    pointer to float for quality metric (optional)
+     */
+    void setQuality(int entries, size_t bins, bool *valid, int *nbins, float *quality) const;
+
+private:
+    /**
+     * Number of bins evaluated by sumHistory() (60 / updateRate or size)
+     */
+    static size_t effectiveBins(const History &h);
+
+    /**
+     * Length of the interval [s] for which a constant UTC offset is checked
+     */
+    static const time_t TZ_HORIZON = 86400;
+
+    time_t tzFrom = 1;  //!< start of interval with constant UTC offset (empty if tzFrom > tzUntil)
+    time_t tzUntil = 0; //!< end of interval with constant UTC offset
+    long tzOffset = 0;  //!< UTC offset [s] in [tzFrom, tzUntil]
+
+    /**
+     * UTC offset at t (localtime_r())
+     */
+    static long localOffset(time_t t);
+
 public:
     /**
      * Constructor
@@ -228,6 +359,14 @@ public:
      * \returns update rate in minutes
      */
     uint8_t getUpdateRate() const { return updateRate; }
+
+    /**
+     * Invalidate cached UTC offset
+     *
+     * Must be called after the time zone has been changed (setenv("TZ", ...), tzset()),
+     * otherwise the previous offset is used until the end of the cached interval.
+     */
+    void timezoneChanged() { tzFrom = 1; tzUntil = 0; }
 };
 
 #endif // _ROLLINGCOUNTER_H
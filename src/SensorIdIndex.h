@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SensorIdIndex.h
+//
+// Hash index for mapping sensor IDs to sensor data slots
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SENSORIDINDEX_H
+#define _SENSORIDINDEX_H
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \class SensorIdIndex
+ *
+ * \brief Open addressing hash table mapping sensor IDs to slot numbers
+ *
+ * The table is sized at run time to at least twice the number of slots (power of two,
+ * linear probing). Entries are never removed individually - a slot may be reassigned
+ * to another sensor or cleared without notice. Therefore the caller must verify the
+ * slot returned by find() and rebuild the index from the valid slots if insert() fails.
+ */
+class SensorIdIndex
+{
+public:
+    /**
+     * \brief Resize table for the given number of slots (removes all entries)
+     *
+     * \param slots     number of sensor data slots
+     */
+    void resize(unsigned slots)
+    {
+        unsigned size = 4;
+        bits = 2;
+        while (size < 2 * slots)
+        {
+            size <<= 1;
+            bits++;
+        }
+        table.assign(size, Entry());
+        used = 0;
+    }
+
+    /**
+     * \brief Remove all entries
+     */
+    void clear(void)
+    {
+        for (Entry &e : table)
+            e.slot = -1;
+        used = 0;
+    }
+
+    /**
+     * \brief Find slot by sensor ID
+     *
+     * \param id        sensor ID
+     *
+     * \returns slot number or -1 if not found
+     */
+    int find(uint32_t id) const
+    {
+        if (table.empty())
+            return -1;
+        for (unsigned i = home(id);; i = (i + 1) & (table.size() - 1))
+        {
+            const Entry &e = table[i];
+            if (e.slot < 0)
+                return -1;
+            if (e.id == id)
+                return e.slot;
+        }
+    }
+
+    /**
+     * \brief Insert or update mapping of sensor ID to slot
+     *
+     * \param id        sensor ID
+     * \param slot      slot number
+     *
+     * \returns false if the table is more than half full (index must be rebuilt)
+     */
+    bool insert(uint32_t id, int slot)
+    {
+        if (table.empty())
+            return false;
+        for (unsigned i = home(id);; i = (i + 1) & (table.size() - 1))
+        {
+            Entry &e = table[i];
+            if (e.slot < 0)
+            {
+                if (2 * (used + 1) > table.size())
+                    return false;
+                used++;
+                e.id = id;
+                e.slot = slot;
+                return true;
+            }
+            if (e.id == id)
+            {
+                e.slot = slot;
+                return true;
+            }
+        }
+    }
+
+private:
+    struct Entry
+    {
+        uint32_t id = 0;
+        int slot = -1;
+    };
+
+    // Multiplicative (Fibonacci) hashing
+    unsigned home(uint32_t id) const
+    {
+        return static_cast<uint32_t>(id * 2654435769UL) >> (32 - bits);
+    }
+
+    std::vector<Entry> table;
+    unsigned bits = 2;
+    unsigned used = 0;
+};
+
+#endif // _SENSORIDINDEX_H
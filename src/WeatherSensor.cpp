@@ -118,6 +118,26 @@
 // 20260619 Added returning state in begin() in case of initialization failure
 // 20260620 Fixed SPI pin reset by RadioLib for CC1101 with LORA_SPI_BUS
 //          Changed radio initialization to new ConfigFSK_t structure in RadioLib 7.7.x
+// 20261016 Changed lfsr_digest16() and crc16() to table driven implementations (DigestUtils.h)
+//          getData(): Accept DECODE_OK_CORRECTED
+//          Added combining of repeated transmissions which could not be decoded
+//          Added suppression of duplicate frames in getMessage()
+//          findId(): Lookup via slotIndex
+//          genMessage(): Set last_seen
+//          Split getMessage() into receiveFrame() (producer) and decoding of buffered
+//          frames (consumer), added getRxOverruns()
+//          Added optional receive task (RX_TASK), getData() waits for its results
+//          getData(): Sleep while waiting for packet received interrupt, callback at callbackInterval
+//          Added getDataScheduled() and getNextArrival()
+//          Access to radio transceiver via RadioBackend (RadioLibBackend or setRadio()),
+//          moved RadioLib specific initialization to RadioLibBackend::begin()
+//          Replaced global receivedFlag / setFlag() by per-transceiver interrupt state,
+//          added addRadio() (multiple transceivers per instance, multiple instances)
+//          Added automatic frequency correction (FREQ_TRACK_THRESHOLD_KHZ)
+//          Added sweepFrequency() and sweepBest()
+//          Added link quality statistics (getLinkStats(), countError())
+//          Added noise floor / interference monitor (sampleNoise(), getNoiseStats()),
+//          RadioLibBackend::getInstantRSSI()
 //
 // ToDo:
 // -
@@ -126,9 +146,14 @@
 
 #include "WeatherSensorCfg.h"
 #include "WeatherSensor.h"
+#include "DigestUtils.h"
+#if defined(ESP32)
+#include <sys/time.h>
+#endif
 
 namespace WeatherSensorReceiver
 {
+#if !defined(INSIDE_UNITTEST)
 #if defined(ARDUINO_LILYGO_T3S3_SX1262) || defined(ARDUINO_LILYGO_T3S3_SX1276) || defined(ARDUINO_LILYGO_T3S3_LR1121) || \
     defined(HELTEC_WIRELESS_STICK_LITE_V3)
     // Use a statically allocated SPIClass with the integer bus-number constructor instead of
@@ -173,6 +198,8 @@ namespace WeatherSensorReceiver
     };
 #endif
 
+    RadioLibBackend radioLibBackend(radio);
+#endif // !defined(INSIDE_UNITTEST)
 }
 
 using namespace WeatherSensorReceiver;
@@ -197,51 +224,101 @@ static void femDisable(void)
 }
 #endif
 
-// Flag to indicate that a packet was received
-static volatile bool receivedFlag = false;
+// Receive interrupt state of each transceiver (assigned to WeatherSensor instances in begin())
+struct RxIrq
+{
+    WeatherSensor *owner;                   // instance using this entry, nullptr if free
+    volatile bool flag;                     // packet received
+    volatile uint32_t overruns;             // packets received before the previous one was read
+#if defined(ESP32)
+    volatile TaskHandle_t *task;            // task to be notified (owner's rxTaskHandle)
+#endif
+};
+
+static RxIrq rxIrqState[MAX_RADIOS];
+
+#if COMBINE_WINDOW_MS > 0
+// Message decoded (possibly not stored) - no further attempts required
+static bool decodeAccepted(DecodeStatus res)
+{
+    return (res == DECODE_OK) || (res == DECODE_OK_CORRECTED) ||
+           (res == DECODE_SKIP) || (res == DECODE_FULL);
+}
+#endif
+
+#if PREDICT_SENSORS > 0
+// Learned sensor transmit intervals (see getDataScheduled()), one per instance -
+// indexed by the interrupt handler of the instance's first transceiver
+// ESP32: Retained during deep sleep - the time base (system time) keeps running.
+// Setting the system time (e.g. by SNTP) only causes wrong predictions until the
+// next reception of each sensor.
+// Multiple instances: begin() has to be called in the same order after each restart.
+#if defined(ESP32) && !defined(INSIDE_UNITTEST)
+static RTC_DATA_ATTR ArrivalPredictor<PREDICT_SENSORS> predictorPool[MAX_RADIOS];
+#else
+static ArrivalPredictor<PREDICT_SENSORS> predictorPool[MAX_RADIOS];
+#endif
+
+// Time base of predictor in ms
+static uint32_t predictTime(void)
+{
+#if defined(ESP32)
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return static_cast<uint32_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+#else
+    return millis();
+#endif
+}
+#endif
 
 // This function is called when a complete packet is received by the module
 // IMPORTANT: This function MUST be 'void' type and MUST NOT have any arguments!
+// - one instance per transceiver (N: index in rxIrqState[])
+template <unsigned N>
 #if defined(ESP8266) || defined(ESP32)
 IRAM_ATTR
 #endif
 void setFlag(void)
 {
-    // We got a packet, set the flag
-    receivedFlag = true;
-}
+    RxIrq &irq = rxIrqState[N];
 
-int16_t WeatherSensor::begin(uint8_t max_sensors_default, bool init_filters, double frequency_offset)
-{
-    uint8_t maxSensors = max_sensors_default;
-    getSensorsCfg(maxSensors, rxFlags, enDecoders);
-    log_d("max_sensors: %u", maxSensors);
-    log_d("rx_flags: %u", rxFlags);
-    log_d("en_decoders: %u", enDecoders);
-    sensor.resize(maxSensors);
+    // We got a packet, set the flag
+    if (irq.flag)
+        irq.overruns = irq.overruns + 1;
+    irq.flag = true;
 
-    if (init_filters)
+#if defined(ESP32)
+    if (irq.task && *irq.task)
     {
-        // List of sensor IDs to be excluded - can be empty
-        std::vector<uint32_t> sensor_ids_exc_def = SENSOR_IDS_EXC;
-        initList(sensor_ids_exc, sensor_ids_exc_def, "exc");
-
-        // List of sensor IDs to be included - if zero, handle all available sensors
-        std::vector<uint32_t> sensor_ids_inc_def = SENSOR_IDS_INC;
-        initList(sensor_ids_inc, sensor_ids_inc_def, "inc");
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(*irq.task, &woken);
+        portYIELD_FROM_ISR(woken);
     }
-
-#if defined(ARDUINO_LILYGO_T3S3_SX1262) || defined(ARDUINO_LILYGO_T3S3_SX1276) || defined(ARDUINO_LILYGO_T3S3_LR1121) || \
-    defined(HELTEC_WIRELESS_STICK_LITE_V3) || defined(LORA_SPI_BUS)
-    spi.begin(LORA_SCK, LORA_MISO, LORA_MOSI, LORA_CS);
 #endif
+}
 
-#if defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
-    femEnable();
+static void (*const setFlagHandler[MAX_RADIOS])(void) = {
+    setFlag<0>,
+#if MAX_RADIOS > 1
+    setFlag<1>,
+#endif
+#if MAX_RADIOS > 2
+    setFlag<2>,
 #endif
+#if MAX_RADIOS > 3
+    setFlag<3>,
+#endif
+};
 
-    double frequency = 868.3 + frequency_offset;
-    log_d("Setting frequency to %f MHz", 868.3 + frequency_offset);
+#if !defined(INSIDE_UNITTEST)
+int16_t RadioLibBackend::begin(double frequency)
+{
+#if defined(ARDUINO_LILYGO_T3S3_SX1262) || defined(ARDUINO_LILYGO_T3S3_SX1276) || defined(ARDUINO_LILYGO_T3S3_LR1121) || \
+    defined(HELTEC_WIRELESS_STICK_LITE_V3) || defined(LORA_SPI_BUS)
+    if (boardRadio)
+        spi.begin(LORA_SCK, LORA_MISO, LORA_MOSI, LORA_CS);
+#endif
 
     // https://github.com/RFD-FHEM/RFFHEM/issues/607#issuecomment-830818445
     // Freq: 868.300 MHz, Bandwidth: 203 KHz, rAmpl: 33 dB, sens: 8 dB, DataRate: 8207.32 Baud
@@ -265,56 +342,60 @@ int16_t WeatherSensor::begin(uint8_t max_sensors_default, bool init_filters, dou
 #endif
 
 #if defined(USE_CC1101)
-    int state = radio.begin(config);
+    int state = chip.begin(config);
 #elif defined(USE_LR1121)
-    int state = radio.beginGFSK(config);
+    int state = chip.beginGFSK(config);
 #else
-    int state = radio.beginFSK(config);
+    int state = chip.beginFSK(config);
 #endif
 
+    // Board specific settings - not applicable to additional transceivers
+    if (boardRadio)
+    {
 #if defined(ARDUINO_LILYGO_T3S3_LR1121)
-    // set RF switch control configuration
-    radio.setRfSwitchTable(rfswitch_dio_pins, rfswitch_table);
+        // set RF switch control configuration
+        chip.setRfSwitchTable(rfswitch_dio_pins, rfswitch_table);
 
-    // LR1121 TCXO Voltage 2.85~3.15V
-    radio.setTCXO(3.0);
+        // LR1121 TCXO Voltage 2.85~3.15V
+        chip.setTCXO(3.0);
 #endif
 
 #if defined(ARDUINO_XIAO_ESP32S3)
-    // set RF switch control configuration
-    radio.setRfSwitchPins(38, RADIOLIB_NC);
+        // set RF switch control configuration
+        chip.setRfSwitchPins(38, RADIOLIB_NC);
 
-    // TCXO voltage according to
-    // https://files.seeedstudio.com/products/SenseCAP/Wio_SX1262/Wio-SX1262_Module_Datasheet.pdf:
-    // 1.7~3.3V
-    //
-    // Set to 1.7V as recommended by Seeed Studio Support
-    radio.setTCXO(1.7);
+        // TCXO voltage according to
+        // https://files.seeedstudio.com/products/SenseCAP/Wio_SX1262/Wio-SX1262_Module_Datasheet.pdf:
+        // 1.7~3.3V
+        //
+        // Set to 1.7V as recommended by Seeed Studio Support
+        chip.setTCXO(1.7);
 #endif
 
 #if defined(HELTEC_WIRELESS_STICK_LITE_V3) || defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
-    // RF switch is controlled internally by SX1262 DIO2
-    // (SX126X_DIO2_AS_RF_SWITCH in Meshtastic heltec_wsl_v3/variant.h)
-    radio.setDio2AsRfSwitch(true);
-    
-    // TCXO voltage according to
-    // https://github.com/meshtastic/firmware/blob/master/variants/esp32s3/heltec_wsl_v3/variant.h
-    radio.setTCXO(1.8);
+        // RF switch is controlled internally by SX1262 DIO2
+        // (SX126X_DIO2_AS_RF_SWITCH in Meshtastic heltec_wsl_v3/variant.h)
+        chip.setDio2AsRfSwitch(true);
+
+        // TCXO voltage according to
+        // https://github.com/meshtastic/firmware/blob/master/variants/esp32s3/heltec_wsl_v3/variant.h
+        chip.setTCXO(1.8);
 #endif
+    }
 
     if (state == RADIOLIB_ERR_NONE)
     {
         log_d("success!");
-        state = radio.fixedPacketLengthMode(MSG_BUF_SIZE);
+        state = chip.fixedPacketLengthMode(MSG_BUF_SIZE);
         if (state != RADIOLIB_ERR_NONE)
         {
             log_e("%s Error setting fixed packet length: [%d]", RECEIVER_CHIP, state);
             return state;
         }
 #if defined(USE_SX1262) || defined(USE_LR1121)
-        state = radio.setCRC(0);
+        state = chip.setCRC(0);
 #else
-        state = radio.setCrcFiltering(false);
+        state = chip.setCrcFiltering(false);
 #endif
         if (state != RADIOLIB_ERR_NONE)
         {
@@ -329,10 +410,10 @@ int16_t WeatherSensor::begin(uint8_t max_sensors_default, bool init_filters, dou
 // which then uses the last byte of the preamble - we receive the last sync byte
 // as the 1st byte of the payload.
 #if defined(USE_CC1101)
-        state = radio.setSyncWord(0xAA, 0x2D, 0, false);
+        state = chip.setSyncWord(0xAA, 0x2D, 0, false);
 #else
         uint8_t sync_word[] = {0xAA, 0x2D};
-        state = radio.setSyncWord(sync_word, 2);
+        state = chip.setSyncWord(sync_word, 2);
 #endif
         if (state != RADIOLIB_ERR_NONE)
         {
@@ -345,145 +426,832 @@ int16_t WeatherSensor::begin(uint8_t max_sensors_default, bool init_filters, dou
         log_e("%s Error initialising: [%d]", RECEIVER_CHIP, state);
         return state;
     }
+    return state;
+}
+
+int16_t RadioLibBackend::getFrequencyError(float &error_hz)
+{
+#if defined(USE_SX1276)
+    // FSK mode: frequency error indicator (FEI) measured during the preamble
+    error_hz = chip.getFrequencyError();
+    return RADIOLIB_ERR_NONE;
+#else
+    (void)error_hz;
+    return RADIOLIB_ERR_UNSUPPORTED;
+#endif
+}
+
+int16_t RadioLibBackend::getInstantRSSI(float &rssi)
+{
+#if defined(USE_SX1276)
+    // FSK mode: RSSI register, receive mode is not restarted
+    rssi = chip.getRSSI(false, true);
+    return RADIOLIB_ERR_NONE;
+#elif defined(USE_SX1262)
+    rssi = chip.getRSSI(false);
+    return RADIOLIB_ERR_NONE;
+#elif defined(USE_LR1121)
+    return chip.getRSSIInst(&rssi);
+#else
+    // CC1101: only the RSSI of the last packet is available in packet mode
+    (void)rssi;
+    return RADIOLIB_ERR_UNSUPPORTED;
+#endif
+}
+#endif
+
+int16_t WeatherSensor::begin(uint8_t max_sensors_default, bool init_filters, double frequency_offset)
+{
+    uint8_t maxSensors = max_sensors_default;
+    getSensorsCfg(maxSensors, rxFlags, enDecoders);
+    log_d("max_sensors: %u", maxSensors);
+    log_d("rx_flags: %u", rxFlags);
+    log_d("en_decoders: %u", enDecoders);
+    resizeSlots(maxSensors);
+
+    if (init_filters)
+    {
+        // List of sensor IDs to be excluded - can be empty
+        std::vector<uint32_t> sensor_ids_exc_def = SENSOR_IDS_EXC;
+        initList(sensor_ids_exc, sensor_ids_exc_def, "exc");
+
+        // List of sensor IDs to be included - if zero, handle all available sensors
+        std::vector<uint32_t> sensor_ids_inc_def = SENSOR_IDS_INC;
+        initList(sensor_ids_inc, sensor_ids_inc_def, "inc");
+        sortLists();
+    }
+
+#if defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
+    femEnable();
+#endif
+
+#if !defined(INSIDE_UNITTEST)
+    if (!backend[0])
+        setRadio(&radioLibBackend);
+#endif
+    if (!backend[0])
+    {
+        log_e("No radio backend");
+        return RADIOLIB_ERR_UNKNOWN;
+    }
+
+    // Assign an interrupt handler to each transceiver
+    if (!rxIrqValid)
+    {
+        uint8_t n = 0;
+        for (uint8_t i = 0; (i < MAX_RADIOS) && (n < numRadios); i++)
+        {
+            if (!rxIrqState[i].owner)
+                rxIrq[n++] = i;
+        }
+        if (n < numRadios)
+        {
+            log_e("Number of radios exceeds MAX_RADIOS");
+            return RADIOLIB_ERR_UNKNOWN;
+        }
+        for (uint8_t i = 0; i < numRadios; i++)
+        {
+            RxIrq &irq = rxIrqState[rxIrq[i]];
+            irq.owner = this;
+            irq.flag = false;
+            irq.overruns = 0;
+#if defined(ESP32)
+            irq.task = &rxTaskHandle;
+#endif
+        }
+        rxIrqValid = true;
+#if PREDICT_SENSORS > 0
+        predictor = &predictorPool[rxIrq[0]];
+#endif
+    }
+
+    double frequency = 868.3 + frequency_offset;
+    freqBase = frequency;
+
+    int state = RADIOLIB_ERR_NONE;
+    for (uint8_t i = 0; i < numRadios; i++)
+    {
+#if FREQ_TRACK_THRESHOLD_KHZ > 0
+        freqTracker[i] = FreqTracker(FREQ_TRACK_THRESHOLD_KHZ, FREQ_TRACK_STEP_KHZ, FREQ_TRACK_MAX_KHZ);
+        freqTracker[i].begin(loadFreqCorrection(rxIrq[i]));
+        frequency = freqBase + freqTracker[i].getCorrection() / 1000;
+#endif
+#if NOISE_SAMPLE_INTERVAL_MS > 0
+        noiseMonitor[i] = NoiseMonitor(NOISE_THRESHOLD_DB);
+#endif
+        log_d("Setting frequency to %f MHz", frequency);
+        state = backend[i]->begin(frequency);
+        if (state != RADIOLIB_ERR_NONE)
+        {
+            return state;
+        }
+
+        // Set callback function
+        backend[i]->setPacketReceivedAction(setFlagHandler[rxIrq[i]]);
+
+        state = backend[i]->startReceive();
+        if (state != RADIOLIB_ERR_NONE)
+        {
+            log_e("%s startReceive() failed, code %d", RECEIVER_CHIP, state);
+            return state;
+        }
+    }
     log_d("%s Setup complete - awaiting incoming messages...", RECEIVER_CHIP);
-    rssi = radio.getRSSI();
+    rssi = backend[0]->getRSSI();
 
-    // Set callback function
-    radio.setPacketReceivedAction(setFlag);
+#if defined(RX_TASK)
+    if (!rxTaskHandle)
+    {
+        rxMutex = xSemaphoreCreateMutex();
+        rxQueue = xQueueCreate(RX_RING_SIZE, sizeof(DecodeStatus));
+    #if portNUM_PROCESSORS > 1
+        xTaskCreatePinnedToCore(rxTask, "WSRx", RX_TASK_STACK, this, RX_TASK_PRIORITY, (TaskHandle_t *)&rxTaskHandle, RX_TASK_CORE);
+    #else
+        xTaskCreate(rxTask, "WSRx", RX_TASK_STACK, this, RX_TASK_PRIORITY, (TaskHandle_t *)&rxTaskHandle);
+    #endif
+        log_d("Receive task started");
+    }
+#endif
+    return state;
+}
 
-    state = radio.startReceive();
+bool WeatherSensor::addRadio(RadioBackend *radio_backend)
+{
+    if (rxIrqValid || (numRadios >= MAX_RADIOS) || !radio_backend)
+        return false;
+
+    if (!backend[0])
+    {
+        // Keep slot 0 for the default transceiver
+#if defined(INSIDE_UNITTEST)
+        return false;
+#else
+        backend[0] = &radioLibBackend;
+        numRadios = 1;
+#endif
+    }
+    backend[numRadios++] = radio_backend;
+    return true;
+}
+
+WeatherSensor::~WeatherSensor()
+{
+    if (!rxIrqValid)
+        return;
+
+    // The transceivers are not accessed - they might have been destroyed already
+    for (uint8_t i = 0; i < numRadios; i++)
+    {
+        rxIrqState[rxIrq[i]].owner = nullptr;
+#if defined(ESP32)
+        rxIrqState[rxIrq[i]].task = nullptr;
+#endif
+    }
+}
+
+void WeatherSensor::startReceiveAll(void)
+{
+    for (uint8_t i = 0; i < numRadios; i++)
+        backend[i]->startReceive();
+}
+
+void WeatherSensor::standbyAll(void)
+{
+    for (uint8_t i = 0; i < numRadios; i++)
+        backend[i]->standby();
+}
+
+bool WeatherSensor::rxPending(void)
+{
+    for (uint8_t i = 0; i < numRadios; i++)
+    {
+        if (rxIrqState[rxIrq[i]].flag)
+            return true;
+    }
+    return false;
+}
+
+float WeatherSensor::getFreqCorrection(uint8_t radio)
+{
+#if FREQ_TRACK_THRESHOLD_KHZ > 0
+    return (radio < MAX_RADIOS) ? freqTracker[radio].getCorrection() : 0;
+#else
+    (void)radio;
+    return 0;
+#endif
+}
+
+void WeatherSensor::clearFreqCorrection(void)
+{
+#if FREQ_TRACK_THRESHOLD_KHZ > 0
+#if defined(RX_TASK)
+    xSemaphoreTake(rxMutex, portMAX_DELAY);
+#endif
+    for (uint8_t i = 0; i < MAX_RADIOS; i++)
+    {
+        freqTracker[i].begin(0);
+        if (!rxIrqValid)
+            saveFreqCorrection(i, 0);
+        else if (i < numRadios)
+            retune(i);
+    }
+#if defined(RX_TASK)
+    xSemaphoreGive(rxMutex);
+#endif
+#endif
+}
+
+#if FREQ_TRACK_THRESHOLD_KHZ > 0
+void WeatherSensor::retune(uint8_t radio)
+{
+    float correction = freqTracker[radio].getCorrection();
+    log_i("Radio %u: frequency correction %.1f kHz", radio, correction);
+    tune(radio, freqBase + correction / 1000);
+    saveFreqCorrection(rxIrq[radio], correction);
+}
+#endif
+
+void WeatherSensor::tune(uint8_t radio, double frequency)
+{
+    backend[radio]->standby();
+    int state = backend[radio]->setFrequency(frequency);
     if (state != RADIOLIB_ERR_NONE)
     {
-        log_e("%s startReceive() failed, code %d", RECEIVER_CHIP, state);
-        return state;
+        log_e("%s setFrequency() failed, code %d", RECEIVER_CHIP, state);
     }
-    
-    return state;
+    backend[radio]->startReceive();
 }
 
 void WeatherSensor::radioReset(void)
 {
-    radio.reset();
+    for (uint8_t i = 0; i < numRadios; i++)
+        backend[i]->reset();
 }
 
 void WeatherSensor::sleep(void)
 {
-    radio.sleep();
+#if defined(RX_TASK)
+    xSemaphoreTake(rxMutex, portMAX_DELAY);
+#endif
+    for (uint8_t i = 0; i < numRadios; i++)
+        backend[i]->sleep();
 #if defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
     femDisable();
 #endif
+#if defined(RX_TASK)
+    xSemaphoreGive(rxMutex);
+#endif
 }
 
 bool WeatherSensor::getData(uint32_t timeout, uint8_t flags, uint8_t type, void (*func)())
 {
     const uint32_t timestamp = millis();
 
+#if defined(RX_TASK)
+    // Reception and decoding is done by the receive task - wait for its results
+    xSemaphoreTake(rxMutex, portMAX_DELAY);
 #if defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
     femEnable();
 #endif
-    radio.startReceive();
+    // Restart reception (e.g. after sleep())
+    startReceiveAll();
+    xQueueReset(rxQueue);
+    rxActive = true;
+    xSemaphoreGive(rxMutex);
+
+    // Decode frames buffered while getData() was not active
+    xTaskNotifyGive(rxTaskHandle);
 
-    while ((millis() - timestamp) < timeout)
+    bool res = false;
+    uint32_t elapsed;
+    uint32_t callback_ts = timestamp;
+    while ((elapsed = millis() - timestamp) < timeout)
     {
+        DecodeStatus decode_status;
+        bool received = xQueueReceive(rxQueue, &decode_status, pdMS_TO_TICKS(waitTime(timeout - elapsed, func, callback_ts))) == pdTRUE;
+
+        // Callback function (see https://www.geeksforgeeks.org/callbacks-in-c/)
+        if (func && ((millis() - callback_ts) >= callbackInterval))
+        {
+            (*func)();
+            callback_ts = millis();
+        }
+
+        if (received && ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED)))
+        {
+            xSemaphoreTake(rxMutex, portMAX_DELAY);
+            res = checkSlots(flags, type);
+            xSemaphoreGive(rxMutex);
+            if (res)
+                break;
+        }
+    }
+
+    // Stop decoding - the receiver stays in receive mode and received frames are buffered
+    xSemaphoreTake(rxMutex, portMAX_DELAY);
+    rxActive = false;
+    xSemaphoreGive(rxMutex);
+    return res;
+#else
+#if defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
+    femEnable();
+#endif
+#if defined(ESP32)
+    rxTaskHandle = xTaskGetCurrentTaskHandle();
+#endif
+    startReceiveAll();
+
+    bool res = false;
+    uint32_t elapsed;
+    uint32_t callback_ts = timestamp;
+    while ((elapsed = millis() - timestamp) < timeout)
+    {
+        // Sleep until a packet has been received, the callback or a noise sample is due or timeout
+        if (!rxPending() && (rxRing.available() == 0))
+        {
+            uint32_t wait = waitTime(timeout - elapsed, func, callback_ts);
+#if NOISE_SAMPLE_INTERVAL_MS > 0
+            wait = (wait < NOISE_SAMPLE_INTERVAL_MS) ? wait : NOISE_SAMPLE_INTERVAL_MS;
+#endif
+            waitReceived(wait);
+            sampleNoise();
+        }
+
         int decode_status = getMessage();
 
         // Callback function (see https://www.geeksforgeeks.org/callbacks-in-c/)
-        if (func)
+        if (func && ((millis() - callback_ts) >= callbackInterval))
         {
             (*func)();
+            callback_ts = millis();
         }
 
-        if (decode_status == DECODE_OK)
+        if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED))
         {
-            bool all_slots_valid = true;
-            bool all_slots_complete = true;
+            if (checkSlots(flags, type))
+            {
+                res = true;
+                break;
+            }
+        }
+    } //  while ((millis() - timestamp) < timeout)
+
+#if defined(ESP32)
+    rxTaskHandle = nullptr;
+#endif
+    standbyAll();
+    return res;
+#endif
+}
 
-            for (size_t i = 0; i < sensor.size(); i++)
+bool WeatherSensor::getDataScheduled(uint32_t timeout, uint8_t flags, uint8_t type, void (*func)())
+{
+#if (PREDICT_SENSORS > 0) && !defined(RX_TASK)
+    const uint32_t timestamp = millis();
+    uint32_t rx_on = 0;
+    bool res = false;
+    uint32_t elapsed;
+    while ((elapsed = millis() - timestamp) < timeout)
+    {
+        if (res && !learning())
+            break;
+
+        uint32_t remaining = timeout - elapsed;
+        uint32_t wait = 0;
+        uint32_t length = remaining;
+        uint32_t id = 0;
+        bool predicted = !res && nextWindow(flags, type, wait, length, id);
+
+        if (predicted && (wait > 0))
+        {
+            // Receiver sleeps until the window opens
+            sleep();
+            idleWait((wait < remaining) ? wait : remaining, func);
+            continue;
+        }
+
+        uint32_t last = 0;
+        if (predicted)
+        {
+            schedStats.windows++;
+            last = predictor->find(id)->last;
+            log_d("RX window for ID 0x%08X: %u ms", (unsigned int)id, (unsigned int)length);
+        }
+
+        // Receive window (or continuous reception); after the requirements have been met,
+        // any message is accepted while learning the interval of a new sensor
+        uint32_t ts = millis();
+        bool ok = getData((length < remaining) ? length : remaining, res ? 0 : flags, type, func);
+        rx_on += millis() - ts;
+
+        if (predicted)
+        {
+            const ArrivalPredictor<PREDICT_SENSORS>::Entry *e = predictor->find(id);
+            if (e && (e->last == last))
             {
-                if (!sensor[i].valid)
-                {
-                    all_slots_valid = false;
-                    continue;
-                }
-
-                // No special requirements, one valid message is sufficient
-                if (flags == 0)
-                {
-                    radio.standby();
-                    return true;
-                }
-
-                // Specific sensor type required
-                if (((flags & DATA_TYPE) != 0) && (sensor[i].s_type == type))
-                {
-                    if (sensor[i].complete || !(flags & DATA_COMPLETE))
-                    {
-                        radio.standby();
-                        return true;
-                    }
-                }
-                // All slots required (valid AND complete) - must check all slots
-                else if (flags & DATA_ALL_SLOTS)
-                {
-                    all_slots_valid &= sensor[i].valid;
-                    all_slots_complete &= sensor[i].complete;
-                }
-                // At least one sensor valid and complete
-                else if (sensor[i].complete)
-                {
-                    radio.standby();
-                    return true;
-                }
-            } // for (size_t i=0; i<sensor.size(); i++)
-
-            // All slots required (valid AND complete)
-            if ((flags & DATA_ALL_SLOTS) && all_slots_valid && all_slots_complete)
+                schedStats.missed++;
+                predictor->miss(id);
+            }
+        }
+        if (ok && !res)
+        {
+            res = true;
+            schedStats.last_ttc_ms = millis() - timestamp;
+        }
+    }
+    sleep();
+
+    elapsed = millis() - timestamp;
+    if (!res)
+        schedStats.last_ttc_ms = elapsed;
+    schedStats.last_rx_on_ms = rx_on;
+    schedStats.rx_on_ms += rx_on;
+    schedStats.total_ms += elapsed;
+    log_d("RX on: %u ms, time-to-complete: %u ms", (unsigned int)rx_on, (unsigned int)schedStats.last_ttc_ms);
+    return res;
+#else
+    // Receive task keeps the receiver in receive mode
+    return getData(timeout, flags, type, func);
+#endif
+}
+
+bool WeatherSensor::getNextArrival(uint32_t id, uint32_t &wait_ms)
+{
+#if PREDICT_SENSORS > 0
+    if (!predictor)
+        return false;
+#if defined(RX_TASK)
+    xSemaphoreTake(rxMutex, portMAX_DELAY);
+#endif
+    const ArrivalPredictor<PREDICT_SENSORS>::Entry *e = predictor->find(id);
+    uint32_t now = predictTime();
+    uint32_t next;
+    uint32_t guard;
+    bool res = e && predictor->predict(*e, now, PREDICT_GUARD_MS, next, guard);
+#if defined(RX_TASK)
+    xSemaphoreGive(rxMutex);
+#endif
+    if (res)
+    {
+        int32_t wait = static_cast<int32_t>(next - now);
+        wait_ms = (wait > 0) ? wait : 0;
+    }
+    return res;
+#else
+    (void)id;
+    (void)wait_ms;
+    return false;
+#endif
+}
+
+int WeatherSensor::sweepFrequency(SweepResult *results, int max_results, int start_khz, int stop_khz, int step_khz,
+                                  uint32_t max_dwell_ms, uint16_t min_decoded, void (*func)())
+{
+    if (!rxIrqValid || !results || (step_khz <= 0))
+        return 0;
+
+#if defined(RX_TASK)
+    xSemaphoreTake(rxMutex, portMAX_DELAY);
+    rxActive = true;
+#elif defined(ESP32)
+    rxTaskHandle = xTaskGetCurrentTaskHandle();
+#endif
+#if defined(ARDUINO_HELTEC_WIFI_LORA_32_V4)
+    femEnable();
+#endif
+    standbyAll();
+    sweeping = true;
+#if defined(RX_TASK)
+    xSemaphoreGive(rxMutex);
+#endif
+
+    int count = 0;
+    uint32_t callback_ts = millis();
+    for (int offset = start_khz; (offset <= stop_khz) && (count < max_results); offset += step_khz)
+    {
+        SweepResult &res = results[count++];
+        res.offset_khz = offset;
+        res.decoded = 0;
+        res.errors = 0;
+        res.rssi_max = -200;
+        float rssi_sum = 0;
+
+        // Discard frames received on the previous frequency
+#if defined(RX_TASK)
+        xSemaphoreTake(rxMutex, portMAX_DELAY);
+#endif
+        tune(0, 868.3 + offset / 1000.0);
+        rxIrqState[rxIrq[0]].flag = false;
+        while (rxRing.peek())
+            rxRing.pop();
+#if defined(RX_TASK)
+        xQueueReset(rxQueue);
+        xSemaphoreGive(rxMutex);
+#endif
+
+        const uint32_t ts = millis();
+        uint32_t elapsed;
+        while (((elapsed = millis() - ts) < max_dwell_ms) && (res.decoded < min_decoded))
+        {
+            float frame_rssi;
+            DecodeStatus decode_status = waitDecode(waitTime(max_dwell_ms - elapsed, func, callback_ts), frame_rssi);
+
+            // Callback function (see https://www.geeksforgeeks.org/callbacks-in-c/)
+            if (func && ((millis() - callback_ts) >= callbackInterval))
             {
-                radio.standby();
-                return true;
+                (*func)();
+                callback_ts = millis();
             }
 
-        } // if (decode_status == DECODE_OK)
-    } //  while ((millis() - timestamp) < timeout)
+            if ((decode_status == DECODE_OK) || (decode_status == DECODE_OK_CORRECTED) || (decode_status == DECODE_DUP))
+            {
+                res.decoded++;
+                rssi_sum += frame_rssi;
+                if (frame_rssi > res.rssi_max)
+                    res.rssi_max = frame_rssi;
+            }
+            else if ((decode_status == DECODE_PAR_ERR) || (decode_status == DECODE_CHK_ERR) || (decode_status == DECODE_DIG_ERR))
+            {
+                res.errors++;
+            }
+        }
+        res.dwell_ms = millis() - ts;
+        res.rssi_avg = res.decoded ? rssi_sum / res.decoded : -200;
+        log_d("Sweep %+d kHz: decoded: %u errors: %u RSSI: %.1f dBm (%u ms)",
+              offset, res.decoded, res.errors, res.rssi_avg, (unsigned)res.dwell_ms);
+    }
+
+    // Restore frequency
+#if defined(RX_TASK)
+    xSemaphoreTake(rxMutex, portMAX_DELAY);
+#endif
+    sweeping = false;
+    tune(0, freqBase + getFreqCorrection(0) / 1000);
+#if defined(RX_TASK)
+    // The receiver stays in receive mode (see getData())
+    startReceiveAll();
+    rxActive = false;
+    xSemaphoreGive(rxMutex);
+#else
+#if defined(ESP32)
+    rxTaskHandle = nullptr;
+#endif
+    standbyAll();
+#endif
+    return count;
+}
+
+bool WeatherSensor::sweepBest(const SweepResult *results, int count, int &offset_khz)
+{
+    float sum = 0;
+    unsigned decoded = 0;
+    for (int i = 0; i < count; i++)
+    {
+        sum += static_cast<float>(results[i].offset_khz) * results[i].decoded;
+        decoded += results[i].decoded;
+    }
+    if (decoded == 0)
+        return false;
+
+    offset_khz = lroundf(sum / decoded);
+    return true;
+}
+
+DecodeStatus WeatherSensor::waitDecode(uint32_t timeout_ms, float &frame_rssi)
+{
+    DecodeStatus decode_status = DECODE_INVALID;
+#if defined(RX_TASK)
+    if (xQueueReceive(rxQueue, &decode_status, pdMS_TO_TICKS(timeout_ms)) == pdTRUE)
+    {
+        xSemaphoreTake(rxMutex, portMAX_DELAY);
+        frame_rssi = rssi;
+        xSemaphoreGive(rxMutex);
+    }
+#else
+    // Sleep until a packet has been received or timeout
+    if (!rxPending() && (rxRing.available() == 0))
+    {
+        waitReceived(timeout_ms);
+    }
+    decode_status = getMessage();
+    frame_rssi = rssi;
+#endif
+    return decode_status;
+}
 
-    // Timeout
-    radio.standby();
+#if PREDICT_SENSORS > 0
+bool WeatherSensor::nextWindow(uint8_t flags, uint8_t type, uint32_t &wait, uint32_t &length, uint32_t &id)
+{
+    const uint32_t now = predictTime();
+    bool found = false;
+    int32_t open_min = 0;
+
+    for (unsigned i = 0; i < predictor->size(); i++)
+    {
+        const ArrivalPredictor<PREDICT_SENSORS>::Entry &e = (*predictor)[i];
+        uint32_t next;
+        uint32_t guard;
+        if (!e.count || !predictor->predict(e, now, PREDICT_GUARD_MS, next, guard))
+            continue;
+
+        // Sensor not required or already received
+        if ((flags & DATA_TYPE) && (e.type != type))
+            continue;
+        int slot = findId(e.id);
+        if ((slot >= 0) && sensor[slot].valid && (sensor[slot].complete || !(flags & DATA_COMPLETE)))
+            continue;
+
+        // Earliest window
+        int32_t open = static_cast<int32_t>(next - guard - now);
+        if (found && (open >= open_min))
+            continue;
+        found = true;
+        open_min = open;
+        id = e.id;
+        length = (open > 0) ? 2 * guard : next + guard - now;
+    }
+    wait = (open_min > 0) ? open_min : 0;
+    return found;
+}
+
+bool WeatherSensor::learning(void)
+{
+    // Only one attempt per sensor (received once so far), a sensor which is not
+    // received again would otherwise extend each call of getDataScheduled() until timeout
+    for (size_t i = 0; i < sensor.size(); i++)
+    {
+        if (!sensor[i].valid)
+            continue;
+        const ArrivalPredictor<PREDICT_SENSORS>::Entry *e = predictor->find(sensor[i].sensor_id);
+        if (e && (e->count == 1))
+            return true;
+    }
     return false;
 }
 
-DecodeStatus WeatherSensor::getMessage(void)
+void WeatherSensor::idleWait(uint32_t ms, void (*func)())
 {
-    uint8_t recvData[MSG_BUF_SIZE];
-    DecodeStatus decode_res = DECODE_INVALID;
+    const uint32_t timestamp = millis();
+    uint32_t callback_ts = timestamp;
+    uint32_t elapsed;
+    while ((elapsed = millis() - timestamp) < ms)
+    {
+        delay(waitTime(ms - elapsed, func, callback_ts));
 
-    // Receive data
-    if (receivedFlag)
+        if (func && ((millis() - callback_ts) >= callbackInterval))
+        {
+            (*func)();
+            callback_ts = millis();
+        }
+    }
+}
+#endif
+
+uint32_t WeatherSensor::waitTime(uint32_t remaining, void (*func)(), uint32_t callback_ts)
+{
+    if (!func)
+        return remaining;
+
+    uint32_t since = millis() - callback_ts;
+    uint32_t due = (since < callbackInterval) ? callbackInterval - since : 0;
+    return (due < remaining) ? due : remaining;
+}
+
+#if !defined(RX_TASK)
+void WeatherSensor::waitReceived(uint32_t timeout_ms)
+{
+    if (timeout_ms == 0)
+        return;
+#if defined(ESP32)
+    // Woken by setFlag()
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+#else
+    const uint32_t ts = millis();
+    while (!rxPending() && ((millis() - ts) < timeout_ms))
     {
-        receivedFlag = false;
+        delay(1);
+    }
+#endif
+}
+#endif
+
+bool WeatherSensor::checkSlots(uint8_t flags, uint8_t type)
+{
+    bool all_slots_valid = true;
+    bool all_slots_complete = true;
+
+    for (size_t i = 0; i < sensor.size(); i++)
+    {
+        if (!sensor[i].valid)
+        {
+            all_slots_valid = false;
+            continue;
+        }
+
+        // No special requirements, one valid message is sufficient
+        if (flags == 0)
+        {
+            return true;
+        }
+
+        // Specific sensor type required
+        if (((flags & DATA_TYPE) != 0) && (sensor[i].s_type == type))
+        {
+            if (sensor[i].complete || !(flags & DATA_COMPLETE))
+            {
+                return true;
+            }
+        }
+        // All slots required (valid AND complete) - must check all slots
+        else if (flags & DATA_ALL_SLOTS)
+        {
+            all_slots_valid &= sensor[i].valid;
+            all_slots_complete &= sensor[i].complete;
+        }
+        // At least one sensor valid and complete
+        else if (sensor[i].complete)
+        {
+            return true;
+        }
+    } // for (size_t i=0; i<sensor.size(); i++)
+
+    // All slots required (valid AND complete)
+    return (flags & DATA_ALL_SLOTS) && all_slots_valid && all_slots_complete;
+}
+
+#if defined(RX_TASK)
+void WeatherSensor::rxTask(void *param)
+{
+    WeatherSensor *ws = static_cast<WeatherSensor *>(param);
+
+    for (;;)
+    {
+        // Wait for packet received interrupt (or getData()) - or next noise sample
+#if NOISE_SAMPLE_INTERVAL_MS > 0
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(NOISE_SAMPLE_INTERVAL_MS));
+#else
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#endif
+
+        xSemaphoreTake(ws->rxMutex, portMAX_DELAY);
+        if (ws->rxActive)
+        {
+            ws->sampleNoise();
+        }
+        if (!ws->rxActive && (ws->rxRing.available() == RX_RING_SIZE))
+        {
+            // Not decoding - replace oldest frame instead of dropping the new one
+            ws->rxRing.pop();
+        }
+        ws->receiveFrame();
+        while (ws->rxActive && ws->rxRing.available())
+        {
+            DecodeStatus decode_status = ws->decodeFrame();
+            xQueueSend(ws->rxQueue, &decode_status, 0);
+        }
+        xSemaphoreGive(ws->rxMutex);
+    }
+}
+#endif
+
+bool WeatherSensor::receiveFrame(void)
+{
+    bool stored = false;
+
+    if (!rxIrqValid)
+        return false;
 
-        int state = radio.readData(recvData, MSG_BUF_SIZE);
-        rssi = radio.getRSSI();
-        radio.startReceive();
+    for (uint8_t i = 0; i < numRadios; i++)
+    {
+        RxIrq &irq = rxIrqState[rxIrq[i]];
+        if (!irq.flag)
+            continue;
+
+        irq.flag = false;
+
+        uint8_t recvData[MSG_BUF_SIZE];
+        int state = backend[i]->readData(recvData, MSG_BUF_SIZE);
+        float frame_rssi = backend[i]->getRSSI();
+        float freq_error = NAN;
+#if FREQ_TRACK_THRESHOLD_KHZ > 0
+        float error_hz;
+        if (backend[i]->getFrequencyError(error_hz) == RADIOLIB_ERR_NONE)
+            freq_error = error_hz / 1000;
+#endif
+        backend[i]->startReceive();
 
         if (state == RADIOLIB_ERR_NONE)
         {
-            // Verify last syncword is 1st byte of payload (see setSyncWord() above)
-            if (recvData[0] == 0xD4)
+#if NOISE_SAMPLE_INTERVAL_MS > 0
+            noiseMonitor[i].frame(millis());
+#endif
+            if (!rxRing.push(recvData, frame_rssi, millis(), freq_error, i))
             {
-#if CORE_DEBUG_LEVEL == ARDUHAL_LOG_LEVEL_VERBOSE
-                char buf[128];
-                *buf = '\0';
-                for (size_t i = 0; (i < sizeof(recvData)) && (i < sizeof(buf) / 3); i++)
-                {
-                    sprintf(&buf[strlen(buf)], "%02X ", recvData[i]);
-                }
-                log_v("%s Data: %s", RECEIVER_CHIP, buf);
-#endif
-                log_d("%s R [%02X] RSSI: %0.1f", RECEIVER_CHIP, recvData[0], rssi);
-
-                decode_res = decodeMessage(&recvData[1], sizeof(recvData) - 1);
-            } // if (recvData[0] == 0xD4)
-        } // if (state == RADIOLIB_ERR_NONE)
+                log_d("%s Receive buffer full", RECEIVER_CHIP);
+                continue;
+            }
+            stored = true;
+        }
         else if (state == RADIOLIB_ERR_RX_TIMEOUT)
         {
             log_v("T");
@@ -494,21 +1262,286 @@ DecodeStatus WeatherSensor::getMessage(void)
             log_d("%s Receive failed: [%d]", RECEIVER_CHIP, state);
         }
     }
+    return stored;
+}
+
+uint32_t WeatherSensor::getRxOverruns(void)
+{
+    uint32_t overruns = rxRing.overruns();
+
+    if (rxIrqValid)
+    {
+        for (uint8_t i = 0; i < numRadios; i++)
+            overruns += rxIrqState[rxIrq[i]].overruns;
+    }
+    return overruns;
+}
+
+DecodeStatus WeatherSensor::getMessage(void)
+{
+    receiveFrame();
+    return decodeFrame();
+}
 
+DecodeStatus WeatherSensor::decodeFrame(void)
+{
+    DecodeStatus decode_res = DECODE_INVALID;
+
+    // Decode oldest buffered frame
+    const FrameRing<RX_RING_SIZE, MSG_BUF_SIZE>::Entry *frame = rxRing.peek();
+    if (!frame)
+        return decode_res;
+
+    const uint8_t *recvData = frame->data;
+    rssi = frame->rssi;
+
+    // Verify last syncword is 1st byte of payload (see setSyncWord() above)
+    if (recvData[0] == 0xD4)
+    {
+#if CORE_DEBUG_LEVEL == ARDUHAL_LOG_LEVEL_VERBOSE
+        char buf[128];
+        *buf = '\0';
+        for (size_t i = 0; (i < MSG_BUF_SIZE) && (i < sizeof(buf) / 3); i++)
+        {
+            sprintf(&buf[strlen(buf)], "%02X ", recvData[i]);
+        }
+        log_v("%s Data: %s", RECEIVER_CHIP, buf);
+#endif
+#if DUP_CACHE_WINDOW_MS > 0
+        // Frame identical to a recently decoded one - only refresh RSSI and last_seen
+        // Capture time of the frame - it may have been buffered for a while
+        uint32_t hash = dupCache.hash(&recvData[1], MSG_BUF_SIZE - 1);
+        uint32_t id;
+        int slot = dupCache.find(hash, frame->time, id);
+        if ((slot >= 0) && (slot < (int)sensor.size()) && sensor[slot].valid && (sensor[slot].sensor_id == id))
+        {
+            dupStats.hit++;
+            sensor[slot].rssi = rssi;
+            sensor[slot].last_seen = frame->time;
+#if LINK_STATS_SENSORS > 0
+            linkMonitor.update(id, rssi, frame->time);
+#endif
+            log_v("%s R [%02X] RSSI: %0.1f - duplicate, ID: 0x%08X", RECEIVER_CHIP, recvData[0], rssi, (unsigned int)id);
+            rxRing.pop();
+            return DECODE_DUP;
+        }
+        dupStats.miss++;
+#endif
+        log_d("%s R [%02X] RSSI: %0.1f", RECEIVER_CHIP, recvData[0], rssi);
+
+        lastSlot = -1;
+        decode_res = decodeMessage(&recvData[1], MSG_BUF_SIZE - 1);
+#if COMBINE_WINDOW_MS > 0
+        if (decodeAccepted(decode_res))
+        {
+            combiner.clear();
+        }
+        else
+        {
+            // Keep status of the received frame if combining was not successful
+            DecodeStatus combine_res = combineMessage(&recvData[1], MSG_BUF_SIZE - 1, frame->time);
+            if (combine_res != DECODE_INVALID)
+                decode_res = combine_res;
+        }
+#endif
+        if (((decode_res == DECODE_OK) || (decode_res == DECODE_OK_CORRECTED)) && (lastSlot >= 0))
+        {
+            sensor[lastSlot].last_seen = frame->time;
+#if PREDICT_SENSORS > 0
+            predictor->update(sensor[lastSlot].sensor_id, sensor[lastSlot].s_type,
+                             predictTime() - (millis() - frame->time), 2000, PREDICT_MAX_INTERVAL_MS);
+#endif
+#if LINK_STATS_SENSORS > 0
+            uint32_t interval = 0;
+#if PREDICT_SENSORS > 0
+            const ArrivalPredictor<PREDICT_SENSORS>::Entry *e = predictor->find(sensor[lastSlot].sensor_id);
+            if (e)
+                interval = e->interval;
+#endif
+            linkMonitor.update(sensor[lastSlot].sensor_id, rssi, frame->time, interval);
+#endif
+#if FREQ_TRACK_THRESHOLD_KHZ > 0
+            if (!sweeping && !isnan(frame->freqError) && freqTracker[frame->radio].update(frame->freqError))
+                retune(frame->radio);
+#endif
+#if DUP_CACHE_WINDOW_MS > 0
+            dupCache.insert(hash, frame->time, lastSlot, sensor[lastSlot].sensor_id);
+#endif
+        }
+        else if ((decode_res == DECODE_PAR_ERR) || (decode_res == DECODE_CHK_ERR) || (decode_res == DECODE_DIG_ERR))
+        {
+            countError(&recvData[1], MSG_BUF_SIZE - 1, decode_res, frame->radio, frame->time);
+        }
+    } // if (recvData[0] == 0xD4)
+
+    rxRing.pop();
     return decode_res;
 }
 
+//
+// Count undecodable message and attribute it to a known sensor
+//
+void WeatherSensor::countError(const uint8_t *msg, uint8_t msgSize, DecodeStatus status, uint8_t radio, uint32_t time)
+{
+    LinkStats::Error err;
+
+    if (status == DECODE_PAR_ERR)
+    {
+        errStats.par++;
+        err = LinkStats::ERR_PARITY;
+    }
+    else if (status == DECODE_CHK_ERR)
+    {
+        errStats.chk++;
+        err = LinkStats::ERR_CHECKSUM;
+    }
+    else
+    {
+        errStats.dig++;
+        err = LinkStats::ERR_DIGEST;
+    }
+
+#if NOISE_SAMPLE_INTERVAL_MS > 0
+    if (noiseMonitor[radio].interference(time))
+        errStats.interference++;
+#else
+    (void)radio;
+    (void)time;
+#endif
+
+#if LINK_STATS_SENSORS > 0
+    uint32_t ids[3];
+    unsigned n = errorIds(msg, msgSize, ids);
+    for (unsigned i = 0; i < n; i++)
+    {
+        if (linkMonitor.error(ids[i], err))
+        {
+            log_d("Error attributed to ID: 0x%08X", (unsigned int)ids[i]);
+            return;
+        }
+    }
+#else
+    (void)msg;
+    (void)msgSize;
+    (void)err;
+#endif
+    errStats.unattributed++;
+}
+
+//
+// Sample RSSI while waiting for frames
+//
+void WeatherSensor::sampleNoise(void)
+{
+#if NOISE_SAMPLE_INTERVAL_MS > 0
+    uint32_t now = millis();
+    if (sweeping || ((now - noiseTs) < NOISE_SAMPLE_INTERVAL_MS))
+        return;
+    noiseTs = now;
+
+    for (uint8_t i = 0; i < numRadios; i++)
+    {
+        float level;
+        if (rxIrqState[rxIrq[i]].flag || (backend[i]->getInstantRSSI(level) != RADIOLIB_ERR_NONE))
+            continue;
+        noiseMonitor[i].sample(level, now);
+    }
+#endif
+}
+
+//
+// Get noise floor and interference statistics
+//
+NoiseStats WeatherSensor::getNoiseStats(uint8_t radio) const
+{
+#if NOISE_SAMPLE_INTERVAL_MS > 0
+    if (radio < numRadios)
+        return noiseMonitor[radio].getStats();
+#else
+    (void)radio;
+#endif
+    NoiseStats stats = {-128, -128, -128, false, 0, 0, 0};
+    return stats;
+}
+
+//
+// Get link quality statistics
+//
+const LinkStats *WeatherSensor::getLinkStats(uint32_t id) const
+{
+#if LINK_STATS_SENSORS > 0
+    return linkMonitor.find(id);
+#else
+    (void)id;
+    return nullptr;
+#endif
+}
+
+#if COMBINE_WINDOW_MS > 0
+//
+// Combine undecodable message with previously received copies
+//
+DecodeStatus WeatherSensor::combineMessage(const uint8_t *msg, uint8_t msgSize, uint32_t time)
+{
+    uint8_t voted[MSG_BUF_SIZE - 1];
+    uint8_t diff[MSG_BUF_SIZE - 1];
+    uint8_t cand[MSG_BUF_SIZE - 1];
+    DecodeStatus decode_res = DECODE_INVALID;
+
+    // The received frame has already been classified - combined messages are not counted
+    ClassifierStats stats = classStats;
+
+    unsigned copies = combiner.add(msg, msgSize, rssi, time, voted, diff);
+    if (copies == 3)
+    {
+        decode_res = decodeMessage(voted, msgSize);
+    }
+    else if (copies == 2)
+    {
+        // No majority - try all combinations of the differing bits;
+        // error correction is disabled to avoid false positives
+        unsigned bits = count_bits(diff, msgSize);
+        if ((bits > 0) && (bits <= COMBINE_MAX_BITS))
+        {
+            correction = false;
+            for (uint32_t i = 1; i < (1UL << bits); i++)
+            {
+                FrameCombiner<MSG_BUF_SIZE - 1>::candidate(voted, diff, msgSize, i, cand);
+                decode_res = decodeMessage(cand, msgSize);
+                if (decodeAccepted(decode_res))
+                    break;
+            }
+            correction = true;
+        }
+    }
+    classStats = stats;
+
+    if (decodeAccepted(decode_res))
+    {
+        log_d("Decoded after combining %u copies", copies);
+        combiner.clear();
+        if (decode_res != DECODE_SKIP)
+            combined++;
+        return decode_res;
+    }
+
+    return DECODE_INVALID;
+}
+#endif
+
 //
 // Generate sample data for testing
 //
 bool WeatherSensor::genMessage(int i, uint32_t id, uint8_t s_type, uint8_t channel, uint8_t startup)
 {
     sensor[i].sensor_id = id;
+    indexSlot(id, i);
     sensor[i].s_type = s_type;
     sensor[i].startup = startup;
     sensor[i].chan = channel;
     sensor[i].battery_ok = true;
     sensor[i].rssi = 88.8;
+    sensor[i].last_seen = millis();
     sensor[i].valid = true;
     sensor[i].complete = true;
 
@@ -560,12 +1593,44 @@ bool WeatherSensor::genMessage(int i, uint32_t id, uint8_t s_type, uint8_t chann
 //
 int WeatherSensor::findId(uint32_t id)
 {
+    // The index may contain stale entries - verify slot
+    int slot = slotIndex.find(id);
+    if ((slot >= 0) && (slot < (int)sensor.size()) && sensor[slot].valid && (sensor[slot].sensor_id == id))
+        return slot;
+    return -1;
+}
+
+//
+// Assign sensor ID to slot in index
+//
+void WeatherSensor::indexSlot(uint32_t id, int slot)
+{
+    if (slotIndex.insert(id, slot))
+        return;
+
+    // Index is full of stale entries - rebuild from valid slots
+    log_v("Rebuilding slot index");
+    slotIndex.clear();
     for (size_t i = 0; i < sensor.size(); i++)
     {
-        if (sensor[i].valid && (sensor[i].sensor_id == id))
-            return i;
+        if (sensor[i].valid && ((int)i != slot))
+            slotIndex.insert(sensor[i].sensor_id, i);
+    }
+    slotIndex.insert(id, slot);
+}
+
+//
+// Resize sensor data array and index
+//
+void WeatherSensor::resizeSlots(uint8_t max_sensors)
+{
+    sensor.resize(max_sensors);
+    slotIndex.resize(max_sensors);
+    for (size_t i = 0; i < sensor.size(); i++)
+    {
+        if (sensor[i].valid)
+            slotIndex.insert(sensor[i].sensor_id, i);
     }
-    return -1;
 }
 
 //
@@ -583,30 +1648,26 @@ int WeatherSensor::findType(uint8_t type, uint8_t ch)
 }
 
 //
-// From from rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/util.c
+// LFSR-16 digest - table driven for the generator/key combinations used by the decoders,
+// bit-by-bit (from rtl_433 project) otherwise
 //
 uint16_t WeatherSensor::lfsr_digest16(uint8_t const message[], unsigned bytes, uint16_t gen, uint16_t key)
 {
-    uint16_t sum = 0;
-    for (unsigned k = 0; k < bytes; ++k)
+    if (gen == 0x8810)
     {
-        uint8_t data = message[k];
-        for (int i = 7; i >= 0; --i)
+        switch (key)
         {
-            // fprintf(stderr, "key at bit %d : %04x\n", i, key);
-            // if data bit is set then xor with key
-            if ((data >> i) & 1)
-                sum ^= key;
-
-            // roll the key right (actually the lsb is dropped here)
-            // and apply the gen (needs to include the dropped lsb as msb)
-            if (key & 1)
-                key = (key >> 1) ^ gen;
-            else
-                key = (key >> 1);
+        case 0x5412: // bresser_6in1
+            return Lfsr16Table<0x8810, 0x5412>::digest(message, bytes);
+        case 0xba95: // bresser_7in1
+            return Lfsr16Table<0x8810, 0xba95>::digest(message, bytes);
+        case 0xabf9: // bresser_lightning
+            return Lfsr16Table<0x8810, 0xabf9>::digest(message, bytes);
+        default:
+            break;
         }
     }
-    return sum;
+    return lfsr_digest16_bitwise(message, bytes, gen, key);
 }
 
 //
@@ -623,27 +1684,13 @@ int WeatherSensor::add_bytes(uint8_t const message[], unsigned num_bytes)
 }
 
 //
-// From from rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/util.c
+// CRC16 - table driven for CRC16/XMODEM polynomial, bit-by-bit (from rtl_433 project) otherwise
 //
 uint16_t WeatherSensor::crc16(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init)
 {
-    uint16_t remainder = init;
-    unsigned byte, bit;
-
-    for (byte = 0; byte < nBytes; ++byte)
+    if (polynomial == 0x1021)
     {
-        remainder ^= message[byte] << 8;
-        for (bit = 0; bit < 8; ++bit)
-        {
-            if (remainder & 0x8000)
-            {
-                remainder = (remainder << 1) ^ polynomial;
-            }
-            else
-            {
-                remainder = (remainder << 1);
-            }
-        }
+        return Crc16Table<0x1021>::crc(message, nBytes, init);
     }
-    return remainder;
+    return crc16_bitwise(message, nBytes, polynomial, init);
 }
@@ -89,6 +89,28 @@
 // 20260202 Added forward declaration of WeatherSensorReceiver namespace
 // 20260221 Improved memory safety
 // 20260430 Added setSensorsCfg() variant with rx_flags and enabled decoders
+// 20261016 Added classifyMessage() and classStats
+//          Added combining of repeated transmissions (FrameCombiner)
+//          Added suppression of duplicate frames (FrameCache), DECODE_DUP, dupStats and
+//          Sensor::last_seen
+//          Added SensorIdIndex for ID -> slot lookup, sorted include/exclude lists,
+//          changed size of include/exclude lists in bytes to uint16_t
+//          Added slot eviction (evictionPolicy, slotStats)
+//          Added receive ring buffer (FrameRing), receiveFrame() and getRxOverruns()
+//          Added optional receive task (RX_TASK)
+//          getData(): Sleep while waiting for messages, added callbackInterval
+//          Added getDataScheduled(), getNextArrival() and schedStats (ArrivalPredictor)
+//          Added RadioBackend, RadioLibBackend and setRadio()
+//          Added multiple instances / radios: addRadio(), per-instance IRQ flags,
+//          RadioLibBackend::boardRadio
+//          Added automatic frequency correction (FreqTracker), getFreqCorrection() and
+//          clearFreqCorrection()
+//          Added sweepFrequency() and sweepBest()
+//          Added link quality statistics (LinkMonitor, getLinkStats()) and errStats
+//          Added noise floor / interference monitor (NoiseMonitor, getNoiseStats()),
+//          RadioBackend::getInstantRSSI()
+//          Added DECODE_OK_CORRECTED
+//          Added Sensor::rescued
 //
 // ToDo:
 // -
@@ -102,14 +124,146 @@
 #include <vector>
 #include <string>
 #include <Preferences.h>
+#if !defined(INSIDE_UNITTEST)
 #include <RadioLib.h>
+#endif
 #include "WeatherSensorCfg.h"
+#include "FrameCombiner.h"
+#include "FrameCache.h"
+#include "SensorIdIndex.h"
+#include "FrameRing.h"
+#include "ArrivalPredictor.h"
+#include "RadioBackend.h"
+#include "FreqTracker.h"
+#include "LinkMonitor.h"
+#include "NoiseMonitor.h"
+
+// Defaults for options missing in custom configuration files
+#if !defined(DIGEST_CORRECTION_BITS)
+#define DIGEST_CORRECTION_BITS 0
+#endif
+#if !defined(PARITY_REPAIR_COLUMNS)
+#define PARITY_REPAIR_COLUMNS 0
+#endif
+#if !defined(COMBINE_WINDOW_MS)
+#define COMBINE_WINDOW_MS 0
+#endif
+#if !defined(COMBINE_MAX_BITS)
+#define COMBINE_MAX_BITS 6
+#endif
+#if !defined(DUP_CACHE_WINDOW_MS)
+#define DUP_CACHE_WINDOW_MS 0
+#endif
+#if !defined(DUP_CACHE_SIZE)
+#define DUP_CACHE_SIZE 8
+#endif
+#if !defined(SLOT_EVICTION)
+#define SLOT_EVICTION SLOT_EVICT_NEVER
+#endif
+#if !defined(RX_RING_SIZE)
+#define RX_RING_SIZE 8
+#endif
+#if !defined(RX_CALLBACK_INTERVAL_MS)
+#define RX_CALLBACK_INTERVAL_MS 10
+#endif
+#if !defined(PREDICT_SENSORS)
+#define PREDICT_SENSORS 0
+#endif
+#if !defined(LINK_STATS_SENSORS)
+#define LINK_STATS_SENSORS 0
+#endif
+#if !defined(NOISE_SAMPLE_INTERVAL_MS)
+#define NOISE_SAMPLE_INTERVAL_MS 0
+#endif
+#if !defined(NOISE_THRESHOLD_DB)
+#define NOISE_THRESHOLD_DB 10
+#endif
+#if !defined(MAX_RADIOS)
+#define MAX_RADIOS 1
+#endif
+#if (MAX_RADIOS < 1) || (MAX_RADIOS > 4)
+#error "MAX_RADIOS must be in the range 1...4"
+#endif
+#if !defined(FREQ_TRACK_THRESHOLD_KHZ)
+#define FREQ_TRACK_THRESHOLD_KHZ 0
+#endif
+#if !defined(FREQ_TRACK_STEP_KHZ)
+#define FREQ_TRACK_STEP_KHZ 5
+#endif
+#if !defined(FREQ_TRACK_MAX_KHZ)
+#define FREQ_TRACK_MAX_KHZ 50
+#endif
+#if !defined(PREDICT_GUARD_MS)
+#define PREDICT_GUARD_MS 300
+#endif
+#if !defined(PREDICT_MAX_INTERVAL_MS)
+#define PREDICT_MAX_INTERVAL_MS 120000
+#endif
+#if defined(RX_TASK)
+    #if !defined(ESP32)
+        #error "RX_TASK is only supported on ESP32"
+    #endif
+    #if !defined(RX_TASK_CORE)
+        #define RX_TASK_CORE 1
+    #endif
+    #if !defined(RX_TASK_PRIORITY)
+        #define RX_TASK_PRIORITY 5
+    #endif
+    #if !defined(RX_TASK_STACK)
+        #define RX_TASK_STACK 4096
+    #endif
+#endif
 
 
+#if !defined(INSIDE_UNITTEST)
 // Forward declaration of radio module in WeatherSensorReceiver namespace
 namespace WeatherSensorReceiver {
     extern RADIO_CHIP radio;
+
+    /*!
+     * \class RadioLibBackend
+     *
+     * \brief RadioLib transceiver (RADIO_CHIP) - default radio backend of WeatherSensor
+     *
+     * Additional transceivers (e.g. on a second SPI bus) are created by the application:
+     *
+     *     SPIClass spi2(HSPI);
+     *     RADIO_CHIP radio2 = new Module(CS2, IRQ2, RST2, GPIO2, spi2);
+     *     RadioLibBackend radio2Backend(radio2, false);
+     *
+     * The application has to call spi2.begin() before WeatherSensor::begin().
+     */
+    class RadioLibBackend : public RadioBackend {
+        public:
+            /*!
+             * \brief Constructor
+             *
+             * \param radio_chip    RadioLib transceiver object
+             * \param board_radio   true: board's transceiver - SPI bus, RF switch and TCXO are
+             *                      initialized according to the board definition
+             */
+            RadioLibBackend(RADIO_CHIP &radio_chip, bool board_radio = true) : chip(radio_chip), boardRadio(board_radio) {}
+
+            int16_t begin(double frequency) override;
+            int16_t startReceive(void) override { return chip.startReceive(); }
+            int16_t readData(uint8_t *data, size_t len) override { return chip.readData(data, len); }
+            float getRSSI(void) override { return chip.getRSSI(); }
+            int16_t standby(void) override { return chip.standby(); }
+            int16_t sleep(void) override { return chip.sleep(); }
+            void setPacketReceivedAction(void (*func)(void)) override { chip.setPacketReceivedAction(func); }
+            void reset(void) override { chip.reset(); }
+            int16_t setFrequency(double frequency) override { return chip.setFrequency(frequency); }
+            int16_t getFrequencyError(float &error_hz) override;
+            int16_t getInstantRSSI(float &rssi) override;
+
+        private:
+            RADIO_CHIP &chip;
+            bool boardRadio;
+    };
+
+    extern RadioLibBackend radioLibBackend;
 }
+#endif
 
 
 // Sensor Types / Decoders / Part Numbers
@@ -160,12 +314,18 @@ namespace WeatherSensorReceiver {
 #define DECODER_LIGHTNING       0x08
 #define DECODER_LEAKAGE         0x10
 
+// Slot eviction policy (see findSlot())
+#define SLOT_EVICT_NEVER        0       // reject new sensors if all slots are in use
+#define SLOT_EVICT_LRU          1       // replace least recently received sensor
+#define SLOT_EVICT_RSSI         2       // replace sensor with lowest RSSI
+
 // Message buffer size
 #define MSG_BUF_SIZE            27
 
 // Radio message decoding status
 typedef enum DecodeStatus {
-    DECODE_INVALID, DECODE_OK, DECODE_PAR_ERR, DECODE_CHK_ERR, DECODE_DIG_ERR, DECODE_SKIP, DECODE_FULL
+    DECODE_INVALID, DECODE_OK, DECODE_PAR_ERR, DECODE_CHK_ERR, DECODE_DIG_ERR, DECODE_SKIP, DECODE_FULL,
+    DECODE_OK_CORRECTED, DECODE_DUP
 } DecodeStatus;
 
 
@@ -189,8 +349,8 @@ typedef struct SensorMap {
 class WeatherSensor {
     private:
         Preferences cfgPrefs; //!< Preferences (stored in flash memory)
-        std::vector<uint32_t> sensor_ids_inc;
-        std::vector<uint32_t> sensor_ids_exc;
+        std::vector<uint32_t> sensor_ids_inc;      //!< sensor IDs to be included (sorted, see findSlot())
+        std::vector<uint32_t> sensor_ids_exc;      //!< sensor IDs to be excluded (sorted, see findSlot())
 
     public:
         /*!
@@ -200,6 +360,92 @@ class WeatherSensor {
         */
         int16_t begin(uint8_t max_sensors_default = MAX_SENSORS_DEFAULT, bool init_filters = true, double frequency_offset = 0.0);
 
+        /*!
+        \brief Set radio backend (call before begin())
+
+        Default: RadioLib transceiver (RadioLibBackend). Alternatively, e.g. ReplayRadio
+        for replaying recorded frames.
+
+        Each WeatherSensor instance needs its own transceiver; several instances
+        (with separate sensor data slots) can receive concurrently.
+
+        \param radio_backend   radio backend
+        */
+        void setRadio(RadioBackend *radio_backend)
+        {
+            backend[0] = radio_backend;
+            if (numRadios == 0)
+                numRadios = 1;
+        }
+
+        /*!
+        \brief Add a radio transceiver feeding the same sensor data slots (call before begin())
+
+        Spatial diversity reception: all transceivers receive on the same frequency,
+        copies of a transmission received by more than one transceiver are dropped
+        by the duplicate cache (see DUP_CACHE_WINDOW_MS).
+
+        At most MAX_RADIOS transceivers can be used by all instances together.
+
+        \param radio_backend   radio backend
+
+        \returns false if MAX_RADIOS is exceeded
+        */
+        bool addRadio(RadioBackend *radio_backend);
+
+        /*!
+        \brief Destructor - releases the transceivers' interrupt handlers
+        */
+        ~WeatherSensor();
+
+        /*!
+        \brief Get learned frequency correction (see FREQ_TRACK_THRESHOLD_KHZ)
+
+        The correction is added to the frequency offset passed to begin().
+
+        \param radio   index of transceiver (0: setRadio(), 1...: addRadio())
+
+        \returns frequency correction in kHz
+        */
+        float getFreqCorrection(uint8_t radio = 0);
+
+        /*!
+        \brief Clear learned frequency corrections (RAM and Preferences)
+
+        Running transceivers are retuned to the frequency passed to begin().
+        Before begin(), the corrections of all transceivers (all instances) are cleared.
+        */
+        void clearFreqCorrection(void);
+
+        /*!
+        \brief Get link quality statistics of a sensor
+
+        RSSI mean and variance, transmissions received vs. expected (from the transmit
+        interval learned for getDataScheduled(), see PREDICT_SENSORS) and the frames
+        with parity, checksum or digest error which could be attributed to the sensor
+        by their (undamaged) ID. The statistics are kept when slots are cleared.
+
+        \param id      sensor ID (e.g. sensor[i].sensor_id)
+
+        \returns statistics or nullptr if not available (see LINK_STATS_SENSORS)
+        */
+        const LinkStats *getLinkStats(uint32_t id) const;
+
+        /*!
+        \brief Get noise floor and interference statistics of a transceiver
+
+        While getData() waits for messages, the RSSI is sampled every NOISE_SAMPLE_INTERVAL_MS
+        (if enabled - disabled by default - and supported by the transceiver,
+        see RadioBackend::getInstantRSSI()).
+        Samples exceeding the noise floor by NOISE_THRESHOLD_DB are counted as interference
+        bursts; decode errors during a burst are counted in errStats.interference.
+
+        \param radio   index of transceiver (see addRadio())
+
+        \returns statistics (samples == 0 if not available)
+        */
+        NoiseStats getNoiseStats(uint8_t radio = 0) const;
+
         /*!
         \brief Reset radio transceiver
         */
@@ -215,31 +461,149 @@ class WeatherSensor {
         With BRESSER_6_IN_1, data is distributed across two different messages. Reception of entire
         data is tried if 'complete' is set.
 
+        On ESP32, the CPU sleeps while waiting for the packet received interrupt (task
+        notification); on other platforms, the interrupt flag is polled every 1 ms (delay(1)).
+
         \param timeout timeout in ms.
 
         \param flags    DATA_COMPLETE / DATA_TYPE / DATA_ALL_SLOTS
 
         \param type     sensor type (combined with FLAGS==DATA_TYPE)
 
-        \param func     Callback function for each loop iteration. (default: NULL)
+        \param func     Callback function, called every callbackInterval ms. (default: NULL)
 
         \returns false: Timeout occurred.
                  true:  Reception (according to parameter 'complete') successful.
         */
         bool    getData(uint32_t timeout, uint8_t flags = 0, uint8_t type = 0, void (*func)() = NULL);
 
+        /*!
+        \brief Wait for data like getData(), but keep the receiver in sleep mode between
+        the predicted transmissions of the required sensors.
+
+        The transmit interval of each sensor is learned from the received messages
+        (see ArrivalPredictor). The receiver is only switched on in a window of
+        +/- PREDICT_GUARD_MS (plus jitter) around the next predicted transmission.
+        As long as no prediction is available for any required sensor, reception is continuous.
+        If a sensor's interval is still unknown after the requirements have been met,
+        reception continues until its next transmission (within timeout) to learn it.
+        After two consecutive receive windows of a sensor without reception, its interval
+        is learned again.
+
+        Receiver on-time and time-to-complete are reported in schedStats.
+        Without PREDICT_SENSORS or with RX_TASK, this is identical to getData().
+
+        \param timeout timeout in ms.
+
+        \param flags    DATA_COMPLETE / DATA_TYPE / DATA_ALL_SLOTS
+
+        \param type     sensor type (combined with FLAGS==DATA_TYPE)
+
+        \param func     Callback function, called every callbackInterval ms. (default: NULL)
+
+        \returns false: Timeout occurred.
+                 true:  Reception (according to parameter 'complete') successful.
+        */
+        bool    getDataScheduled(uint32_t timeout, uint8_t flags = 0, uint8_t type = 0, void (*func)() = NULL);
+
+        /*!
+        \brief Get time until the next expected transmission of a sensor
+
+        \param id      sensor ID
+
+        \param wait_ms time until predicted transmission in ms (0 if overdue)
+
+        \returns true if a prediction is available
+        */
+        bool    getNextArrival(uint32_t id, uint32_t &wait_ms);
+
+        /*!
+        \brief Reception statistics of one frequency (see sweepFrequency())
+        */
+        struct SweepResult {
+            int16_t offset_khz;     //!< frequency offset from 868.3 MHz in kHz
+            uint16_t decoded;       //!< frames decoded successfully (including duplicates)
+            uint16_t errors;        //!< frames with parity, checksum or digest error
+            float rssi_avg;         //!< mean RSSI of decoded frames in dBm (-200: none)
+            float rssi_max;         //!< max. RSSI of decoded frames in dBm (-200: none)
+            uint32_t dwell_ms;      //!< time spent on this frequency in ms
+        };
+
+        /*!
+        \brief Frequency sweep for finding the optimal frequency offset (call after begin())
+
+        The first transceiver is retuned (without re-initialization) from 868.3 MHz + start_khz
+        to 868.3 MHz + stop_khz in steps of step_khz; additional transceivers are set to standby.
+        The receiver dwells on each frequency until min_decoded frames have been decoded or
+        max_dwell_ms has elapsed. Decoded messages are stored in the sensor data slots as usual;
+        frequency tracking is suspended. Afterwards, the previous frequency is restored.
+
+        \param results      result table (one entry per frequency)
+        \param max_results  size of result table
+        \param start_khz    first frequency offset in kHz
+        \param stop_khz     last frequency offset in kHz
+        \param step_khz     step size in kHz
+        \param max_dwell_ms max. time per frequency in ms
+        \param min_decoded  number of decoded frames after which the next frequency is selected
+        \param func         callback function (called every callbackInterval ms, see getData())
+
+        \returns number of entries in result table
+        */
+        int     sweepFrequency(SweepResult *results, int max_results, int start_khz, int stop_khz, int step_khz,
+                               uint32_t max_dwell_ms, uint16_t min_decoded = 3, void (*func)() = NULL);
+
+        /*!
+        \brief Get optimal frequency offset from sweep results
+
+        The frequency range with successful reception is usually symmetrical to the
+        transmitter's frequency - its center (weighted by the number of decoded frames)
+        is used. The result can be passed to begin() (frequency_offset = offset_khz / 1000.0).
+
+        \param results      result table (see sweepFrequency())
+        \param count        number of entries
+        \param offset_khz   optimal frequency offset in kHz
+
+        \returns false if no frames have been decoded
+        */
+        static bool sweepBest(const SweepResult *results, int count, int &offset_khz);
+
 
         /*!
         \brief Tries to receive radio message (non-blocking) and to decode it.
         Timeout occurs after a multitude of expected time-on-air.
 
+        The oldest frame from the receive buffer is decoded (see receiveFrame()).
+        With RX_TASK, reception and decoding is done by the receive task - use getData() only.
+
         \returns DecodeStatus
         */
         DecodeStatus    getMessage(void);
 
+        /*!
+        \brief Reads received frames from the radio transceivers into the receive buffer
+        and re-arms reception (non-blocking).
+
+        Producer side of the receive buffer - must not be called concurrently with itself.
+        Without RX_TASK, it is only called by getMessage(), so the buffer holds at most one frame per transceiver.
+
+        \returns true if a frame was stored
+        */
+        bool    receiveFrame(void);
+
+        /*!
+        \brief Get number of lost frames
+
+        Frames are lost if the receive buffer is full or if a frame was not read from the
+        transceiver before the next one arrived.
+
+        \returns number of lost frames
+        */
+        uint32_t getRxOverruns(void);
+
         /*!
         \brief Decode message
-        Tries the available decoders until a decoding was successful.
+        Selects the decoder by message signature (see classifyMessage()).
+        If the signature is ambiguous, tries the available decoders until a decoding was successful.
 
         \returns DecodeStatus
         */
@@ -328,6 +692,8 @@ class WeatherSensor {
             bool     battery_ok;       //!< battery o.k.
             bool     valid;            //!< data valid (but not necessarily complete)
             bool     complete;         //!< data is split into two separate messages is complete (only 6-in-1 WS)
+            uint16_t rescued;          //!< number of messages decoded after error correction / repair
+            uint32_t last_seen;        //!< time of last reception (millis())
             union {
                 struct Weather      w;
                 struct Soil         soil;
@@ -353,6 +719,61 @@ class WeatherSensor {
         uint8_t rxFlags;                           //!< receive flags (see getData())
         uint8_t enDecoders = 0xFF;                 //!< enabled Decoders                     
 
+        /*!
+        \brief Message classifier statistics (see decodeMessage())
+        */
+        struct ClassifierStats {
+            uint32_t single = 0;    //!< messages routed to exactly one decoder
+            uint32_t fallback = 0;  //!< ambiguous messages - all enabled decoders tried
+            uint32_t rejected = 0;  //!< messages not matching any decoder's signature
+        } classStats;
+
+        uint32_t combined = 0;                     //!< messages decoded after combining repeated transmissions
+
+        /*!
+        \brief Statistics of frames which could not be decoded (see getLinkStats())
+        */
+        struct ErrorStats {
+            uint32_t par = 0;           //!< parity errors
+            uint32_t chk = 0;           //!< checksum errors
+            uint32_t dig = 0;           //!< digest errors
+            uint32_t unattributed = 0;  //!< errors which could not be attributed to a known sensor
+            uint32_t interference = 0;  //!< errors during interference bursts (see getNoiseStats())
+        } errStats;
+
+        /*!
+        \brief Duplicate frame suppression statistics (see getMessage())
+        */
+        struct DupStats {
+            uint32_t hit = 0;       //!< frames identical to a recently decoded frame - not decoded again
+            uint32_t miss = 0;      //!< frames decoded
+        } dupStats;
+
+        uint8_t evictionPolicy = SLOT_EVICTION;    //!< slot eviction policy (SLOT_EVICT_*)
+        uint16_t callbackInterval = RX_CALLBACK_INTERVAL_MS; //!< getData() callback interval in ms
+
+        /*!
+        \brief Slot eviction statistics (see findSlot())
+        */
+        struct SlotStats {
+            uint32_t evicted = 0;   //!< slots replaced by a new sensor
+            uint32_t rejected = 0;  //!< new sensors rejected (DECODE_FULL)
+        } slotStats;
+
+        /*!
+        \brief Receive window scheduling statistics (see getDataScheduled())
+
+        The receiver's share of energy is approx. rx_on_ms * I_rx + (total_ms - rx_on_ms) * I_sleep.
+        */
+        struct SchedStats {
+            uint32_t rx_on_ms = 0;      //!< receiver on-time (accumulated)
+            uint32_t total_ms = 0;      //!< time spent in getDataScheduled() (accumulated)
+            uint32_t windows = 0;       //!< predicted receive windows opened
+            uint32_t missed = 0;        //!< predicted receive windows without reception
+            uint32_t last_rx_on_ms = 0; //!< receiver on-time of last call
+            uint32_t last_ttc_ms = 0;   //!< time-to-complete of last call (timeout if not successful)
+        } schedStats;
+
         /*!
         \brief Generates data otherwise received and decoded from a radio message.
 
@@ -413,7 +834,7 @@ class WeatherSensor {
          * \param bytes sensor IDs
          * \param size buffer size in bytes
          */
-        void setSensorsInc(uint8_t *bytes, uint8_t size);
+        void setSensorsInc(uint8_t *bytes, uint16_t size);
 
         /*!
          * Set sensors include list in Preferences
@@ -421,7 +842,7 @@ class WeatherSensor {
          * \param bytes sensor IDs
          * \param size buffer size in bytes
          */
-        void setSensorsExc(uint8_t *bytes, uint8_t size);
+        void setSensorsExc(uint8_t *bytes, uint16_t size);
 
         /*!
          * Set maximum number of sensors, rx_flags and enabled decoders and store it in Preferences
@@ -447,7 +868,7 @@ class WeatherSensor {
          *
          * \returns size size in bytes
          */
-        uint8_t getSensorsInc(uint8_t *payload);
+        uint16_t getSensorsInc(uint8_t *payload);
 
         /*!
          * Get sensors exclude list (Preferences/defaults)
@@ -456,18 +877,18 @@ class WeatherSensor {
          *
          * \returns size size in bytes
          */
-        uint8_t getSensorsExc(uint8_t *payload);
+        uint16_t getSensorsExc(uint8_t *payload);
 
         /*!
          * Convert sensor IDs from JSON string to byte array
          * 
          * \param ids list of sensor IDs
          * \param json JSON string
-         * \param buf buffer for storing sensor IDs
+         * \param buf buffer for storing sensor IDs (resized as required)
          * 
          * \returns size in bytes
          */
-        uint8_t convSensorsJson(std::vector<uint32_t> &ids, String json, uint8_t *buf);
+        uint16_t convSensorsJson(std::vector<uint32_t> &ids, String json, std::vector<uint8_t> &buf);
 
         /*!
          * Set sensors include list from JSON string
@@ -541,6 +962,11 @@ class WeatherSensor {
          * 3. Either an existing slot with the same ID as the current message is updated
          *    or a free slot (if any) is selected.
          *
+         * 4. If no slot is free, a slot is evicted according to evictionPolicy (see evictSlot()).
+         *
+         * The include/exclude lists are searched by binary search - they must be sorted
+         * (see sortLists()); existing slots are found via slotIndex.
+         *
          * \param id Sensor ID from current message
          *
          * \returns Pointer to slot in sensor data array or NULL if ID is not wanted or
@@ -548,6 +974,272 @@ class WeatherSensor {
          */
         int findSlot(uint32_t id, DecodeStatus * status);
 
+        /*!
+         * \brief Select slot to be replaced by a new sensor
+         *
+         * Slots of sensors from the include list are pinned, i.e. never evicted.
+         *
+         * \returns Slot (cleared) or -1 if no slot may be evicted
+         */
+        int evictSlot(void);
+
+        /*!
+         * \brief Classify message by cheap signatures
+         *
+         * Checks the 5-in-1 inverted copy, the 6-in-1 checksum, the leakage sensor's
+         * sanity conditions and the sensor type nibble before any digest is calculated.
+         *
+         * \param msg     Message buffer.
+         *
+         * \param msgSize Message size in bytes.
+         *
+         * \returns Bitmap of candidate decoders (DECODER_*), not limited to enDecoders
+         */
+        uint8_t classifyMessage(const uint8_t *msg, uint8_t msgSize);
+
+        /*!
+         * \brief Get possible sensor IDs of a message which could not be decoded
+         *
+         * The ID is taken from its position in each message format; the 5-in-1 ID
+         * is only returned if it matches its inverted copy.
+         *
+         * \param msg      message buffer
+         * \param msgSize  message size in bytes
+         * \param ids      candidate IDs (at least 3 entries)
+         *
+         * \returns number of candidate IDs
+         */
+        unsigned errorIds(const uint8_t *msg, uint8_t msgSize, uint32_t *ids);
+
+        /*!
+         * \brief Count frame which could not be decoded in errStats and link statistics
+         *
+         * \param msg      message buffer
+         * \param msgSize  message size in bytes
+         * \param status   decoder status
+         * \param radio    index of transceiver
+         * \param time     time of reception
+         */
+        void countError(const uint8_t *msg, uint8_t msgSize, DecodeStatus status, uint8_t radio, uint32_t time);
+
+        RadioBackend *backend[MAX_RADIOS] = {};    //!< radio transceivers (see setRadio(), addRadio())
+        uint8_t numRadios = 0;                     //!< number of radio transceivers
+        uint8_t rxIrq[MAX_RADIOS];                 //!< interrupt handler index of each transceiver (see begin())
+        bool rxIrqValid = false;                   //!< interrupt handlers assigned
+        #if defined(ESP32)
+            volatile TaskHandle_t rxTaskHandle = nullptr;  //!< notified by interrupt handlers (receive task or getData())
+        #endif
+        #if PREDICT_SENSORS > 0
+            ArrivalPredictor<PREDICT_SENSORS> *predictor = nullptr;  //!< learned transmit intervals (see begin())
+        #endif
+        #if LINK_STATS_SENSORS > 0
+            LinkMonitor<LINK_STATS_SENSORS> linkMonitor;  //!< link quality statistics (see getLinkStats())
+        #endif
+        #if NOISE_SAMPLE_INTERVAL_MS > 0
+            NoiseMonitor noiseMonitor[MAX_RADIOS];   //!< noise floor of each transceiver (see getNoiseStats())
+            uint32_t noiseTs = 0;                    //!< time of last noise sample
+        #endif
+
+        /*!
+         * \brief Sample RSSI of transceivers in receive mode without pending frame (if due)
+         */
+        void sampleNoise(void);
+        double freqBase = 868.3;                   //!< frequency in MHz without correction (see begin())
+        bool sweeping = false;                     //!< sweepFrequency() active
+
+        /*!
+         * \brief Change frequency of transceiver and restart reception
+         *
+         * \param radio       index of transceiver
+         * \param frequency   frequency in MHz
+         */
+        void tune(uint8_t radio, double frequency);
+
+        /*!
+         * \brief Wait for a received frame and decode it (see sweepFrequency())
+         *
+         * \param timeout_ms  timeout in ms
+         * \param frame_rssi  RSSI of frame
+         *
+         * \returns DecodeStatus (DECODE_INVALID if no frame was received)
+         */
+        DecodeStatus waitDecode(uint32_t timeout_ms, float &frame_rssi);
+
+        #if FREQ_TRACK_THRESHOLD_KHZ > 0
+            FreqTracker freqTracker[MAX_RADIOS];   //!< frequency correction of each transceiver
+
+            /*!
+             * \brief Set frequency of transceiver to freqBase + learned correction and store correction
+             *
+             * \param radio   index of transceiver
+             */
+            void retune(uint8_t radio);
+
+            /*!
+             * \brief Load learned frequency correction from Preferences
+             *
+             * \param irq     interrupt handler index of transceiver (unique for all instances)
+             *
+             * \returns frequency correction in kHz
+             */
+            float loadFreqCorrection(uint8_t irq);
+
+            /*!
+             * \brief Store learned frequency correction in Preferences
+             *
+             * \param irq             interrupt handler index of transceiver (unique for all instances)
+             * \param correction_khz  frequency correction in kHz
+             */
+            void saveFreqCorrection(uint8_t irq, float correction_khz);
+        #endif
+        bool correction = true;                    //!< bit error correction / repair enabled in decoders
+        int lastSlot = -1;                         //!< slot assigned by last call of findSlot()
+        SensorIdIndex slotIndex;                   //!< sensor ID -> slot mapping
+        FrameRing<RX_RING_SIZE, MSG_BUF_SIZE> rxRing;  //!< receive buffer
+
+        /*!
+         * \brief Decode oldest frame from receive buffer (consumer side)
+         *
+         * \returns DecodeStatus (DECODE_INVALID if buffer is empty)
+         */
+        DecodeStatus decodeFrame(void);
+
+        /*!
+         * \brief Check if received data meets the requirements of getData()
+         *
+         * \param flags    see getData()
+         * \param type     see getData()
+         *
+         * \returns true if requirements are met
+         */
+        bool checkSlots(uint8_t flags, uint8_t type);
+
+        /*!
+         * \brief Get time to wait in getData() until timeout or next callback
+         *
+         * \param remaining   time until timeout in ms
+         * \param func        callback function
+         * \param callback_ts time of last callback
+         *
+         * \returns time to wait in ms
+         */
+        uint32_t waitTime(uint32_t remaining, void (*func)(), uint32_t callback_ts);
+
+        /*!
+         * \brief Check if a packet has been received by any of the transceivers
+         *
+         * \returns true if a packet is waiting to be read
+         */
+        bool rxPending(void);
+
+        /*!
+         * \brief Start receive mode of all transceivers
+         */
+        void startReceiveAll(void);
+
+        /*!
+         * \brief Set all transceivers to standby mode
+         */
+        void standbyAll(void);
+
+        #if !defined(RX_TASK)
+            /*!
+             * \brief Sleep until a packet has been received or timeout
+             *
+             * \param timeout_ms  timeout in ms
+             */
+            void waitReceived(uint32_t timeout_ms);
+        #endif
+
+        #if defined(RX_TASK)
+            QueueHandle_t rxQueue = nullptr;       //!< decode status of messages decoded by receive task
+            SemaphoreHandle_t rxMutex = nullptr;   //!< radio and sensor data access
+            volatile bool rxActive = false;        //!< decoding enabled (getData() is waiting)
+
+            /*!
+             * \brief Receive task - receives frames and decodes them while getData() is waiting
+             *
+             * \param param   pointer to WeatherSensor object
+             */
+            static void rxTask(void *param);
+        #endif
+
+        /*!
+         * \brief Assign sensor ID to slot in slotIndex
+         *
+         * The index is rebuilt from all valid slots if it is full of stale entries.
+         *
+         * \param id      sensor ID
+         *
+         * \param slot    slot in sensor data array
+         */
+        void indexSlot(uint32_t id, int slot);
+
+        /*!
+         * \brief Resize sensor data array and slotIndex
+         *
+         * \param max_sensors maximum number of sensors
+         */
+        void resizeSlots(uint8_t max_sensors);
+
+        /*!
+         * \brief Sort include/exclude lists for binary search in findSlot()
+         */
+        void sortLists(void);
+
+        #if PREDICT_SENSORS > 0
+            /*!
+             * \brief Find next receive window for the sensors required by getDataScheduled()
+             *
+             * Sensors which already meet the requirements are skipped.
+             *
+             * \param flags    see getData()
+             * \param type     see getData()
+             * \param wait     time until window opens in ms (0: window is open)
+             * \param length   window length in ms (from now if window is open)
+             * \param id       sensor ID
+             *
+             * \returns false if no prediction is available
+             */
+            bool nextWindow(uint8_t flags, uint8_t type, uint32_t &wait, uint32_t &length, uint32_t &id);
+
+            /*!
+             * \brief Check if a sensor has been received for the first time (transmit interval unknown)
+             *
+             * \returns true if interval has to be learned
+             */
+            bool learning(void);
+
+            /*!
+             * \brief Wait while receiver is in sleep mode, calling callback function
+             *
+             * \param ms      time to wait in ms
+             * \param func    callback function
+             */
+            void idleWait(uint32_t ms, void (*func)());
+        #endif
+
+        #if DUP_CACHE_WINDOW_MS > 0
+            FrameCache<DUP_CACHE_SIZE> dupCache{DUP_CACHE_WINDOW_MS};  //!< recently decoded frames
+        #endif
+
+        #if COMBINE_WINDOW_MS > 0
+            FrameCombiner<MSG_BUF_SIZE - 1> combiner{COMBINE_WINDOW_MS};  //!< storage of undecodable messages
+
+            /*!
+             * \brief Combine undecodable message with previously received copies and decode result
+             *
+             * \param msg     Message buffer.
+             *
+             * \param msgSize Message size in bytes.
+             *
+             * \param time    Capture time of the frame (millis()).
+             *
+             * \returns Decode status.
+             */
+            DecodeStatus combineMessage(const uint8_t *msg, uint8_t msgSize, uint32_t time);
+        #endif
+
 
         #ifdef BRESSER_5_IN_1
             /*!
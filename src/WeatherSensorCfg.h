@@ -72,6 +72,26 @@
 // 20260114 Added pin definitions for Seeed Studio XIAO ESP32S3 with Wio-SX1262
 // 20260611 Added pin definitions for Heltec Wireless Stick Lite V3 (SX1262)
 // 20260514 Added pin definitions for Heltec WiFi LoRa 32(V4)
+// 20261016 Added DIGEST_CORRECTION_BITS and PARITY_REPAIR_COLUMNS
+//          Added COMBINE_WINDOW_MS and COMBINE_MAX_BITS
+//          Added DUP_CACHE_WINDOW_MS and DUP_CACHE_SIZE
+//          Increased MAX_SENSOR_IDS to 200
+//          Added SLOT_EVICTION
+//          Added RX_RING_SIZE
+//          Added RX_TASK, RX_TASK_CORE, RX_TASK_PRIORITY and RX_TASK_STACK
+//          Added RX_CALLBACK_INTERVAL_MS
+//          Added PREDICT_SENSORS, PREDICT_GUARD_MS and PREDICT_MAX_INTERVAL_MS
+//          Added MAX_RADIOS
+//          Added FREQ_TRACK_THRESHOLD_KHZ, FREQ_TRACK_STEP_KHZ and FREQ_TRACK_MAX_KHZ
+//          Added LINK_STATS_SENSORS
+//          Added NOISE_SAMPLE_INTERVAL_MS and NOISE_THRESHOLD_DB
+//          (noise sampling disabled by default)
+//          (bit error correction and 5-in-1 repair disabled by default)
+//          (prediction of sensor transmissions disabled by default)
+//          (automatic frequency correction disabled by default)
+//          (link quality statistics disabled by default)
+//          Added RAINGAUGE_FLUSH_INTERVAL and LIGHTNING_FLUSH_INTERVAL
+//          Documented limitations of RX_RING_SIZE and sleeping without RX_TASK / ESP32
 //
 // ToDo:
 // -
@@ -97,7 +117,7 @@
 //#define SENSOR_IDS_INC { 0x83750871 }
 
 // Maximum number of sensor IDs in include/exclude list
-#define MAX_SENSOR_IDS 12
+#define MAX_SENSOR_IDS 200
 
 // Disable data type which will not be used to save RAM
 #define WIND_DATA_FLOATINGPOINT
@@ -111,6 +131,122 @@
 #define BRESSER_LIGHTNING
 #define BRESSER_LEAKAGE
 
+// Correction of bit errors in messages with failed digest check (6-in-1, 7-in-1)
+// Maximum number of bit errors to be corrected: 0 (disabled), 1 or 2
+// N.B.: With 2, significantly more erroneous messages pass the digest check and
+// only are rejected by checksum (6-in-1) or plausibility check (7-in-1)
+// Disabled by default - each corrected message increases the risk of accepting wrong data.
+// To enable, set e.g. 1 (here or as build flag -DDIGEST_CORRECTION_BITS=1).
+#if !defined(DIGEST_CORRECTION_BITS)
+#define DIGEST_CORRECTION_BITS 0
+#endif
+
+// Repair of 5-in-1 messages with mismatching data / inverted data bytes
+// Maximum number of mismatching bytes to be repaired: 0 (disabled) ... 8
+// The correct copy of each byte is selected by checksum and BCD plausibility check
+// Disabled by default - each repaired message increases the risk of accepting wrong data.
+// To enable, set e.g. 4 (here or as build flag -DPARITY_REPAIR_COLUMNS=4).
+#if !defined(PARITY_REPAIR_COLUMNS)
+#define PARITY_REPAIR_COLUMNS 0
+#endif
+
+// Combining of repeated transmissions which could not be decoded
+// Time window in ms: 0 (disabled) or max. time between copies of the same transmission
+// Three copies are combined by bitwise majority vote.
+// With only two copies, all combinations of up to COMBINE_MAX_BITS differing bits are tried.
+#if !defined(COMBINE_WINDOW_MS)
+#define COMBINE_WINDOW_MS 500
+#endif
+#define COMBINE_MAX_BITS 6
+
+// Suppression of repeated transmissions which have already been decoded
+// Time window in ms: 0 (disabled) or max. time between copies of the same transmission
+// Identical frames only refresh RSSI and last_seen of their sensor data slot.
+#if !defined(DUP_CACHE_WINDOW_MS)
+#define DUP_CACHE_WINDOW_MS 1000
+#endif
+#define DUP_CACHE_SIZE 8
+
+// Eviction of sensor data slots if all slots are in use and a new sensor is received
+// SLOT_EVICT_NEVER: new sensor is rejected (DECODE_FULL)
+// SLOT_EVICT_LRU:   slot with least recently received sensor is replaced
+// SLOT_EVICT_RSSI:  slot with lowest RSSI is replaced (if the new sensor's RSSI is higher)
+// Sensors from the include list (SENSOR_IDS_INC) are never evicted.
+// Can be changed at run time (WeatherSensor::evictionPolicy).
+#define SLOT_EVICTION SLOT_EVICT_NEVER
+
+// Number of received frames buffered between receiver and decoder (power of two)
+// N.B.: Frames are only buffered while decoding with RX_TASK. Without RX_TASK, a frame is read
+// from the transceiver by getData()/getMessage(), i.e. the buffer never holds more than one
+// frame per transceiver and a frame arriving before the previous one has been read is lost.
+#define RX_RING_SIZE 8
+
+// Receive task (ESP32 only)
+// Reception and decoding run in a separate task started by begin();
+// getData() only waits for decoded messages from this task.
+// The receiver stays in receive mode between calls of getData().
+// RX_TASK_CORE: 1 - Arduino loop() core (the WiFi/BT stack runs on core 0);
+// ignored on single core chips
+//#define RX_TASK
+#define RX_TASK_CORE 1
+#define RX_TASK_PRIORITY 5
+#define RX_TASK_STACK 4096
+
+// Interval in ms for calling getData()'s callback function while waiting for messages
+// (0: after each wakeup, i.e. without sleeping between calls)
+// N.B.: The CPU only sleeps while waiting on ESP32 (task notification); on other platforms,
+// the interrupt flag is polled with delay(1).
+#define RX_CALLBACK_INTERVAL_MS 10
+
+// Prediction of sensor transmissions for getDataScheduled()
+// PREDICT_SENSORS: number of sensors whose transmit interval is learned (0: disabled)
+// PREDICT_GUARD_MS: minimum receive window before/after a predicted transmission
+// PREDICT_MAX_INTERVAL_MS: a sensor's interval is only learned from two receptions
+// within this time (e.g. not across a deep sleep period)
+// Disabled by default - getDataScheduled() is then identical to getData().
+// To enable, set e.g. 8 (here or as build flag -DPREDICT_SENSORS=8).
+#if !defined(PREDICT_SENSORS)
+#define PREDICT_SENSORS 0
+#endif
+#define PREDICT_GUARD_MS 300
+#define PREDICT_MAX_INTERVAL_MS 120000
+
+// Number of sensors with link quality statistics (0: disabled)
+// (see WeatherSensor::getLinkStats())
+// Disabled by default. To enable, set e.g. 8 (here or as build flag -DLINK_STATS_SENSORS=8);
+// expected transmissions and loss are only available with PREDICT_SENSORS > 0.
+#if !defined(LINK_STATS_SENSORS)
+#define LINK_STATS_SENSORS 0
+#endif
+
+// Noise floor / interference monitor (see WeatherSensor::getNoiseStats())
+// While waiting for messages, the RSSI is sampled every NOISE_SAMPLE_INTERVAL_MS (0: disabled);
+// samples NOISE_THRESHOLD_DB above the noise floor are counted as interference.
+// Disabled by default - each sample is an SPI transaction while waiting for messages.
+// To enable, set the interval to e.g. 250 (here or as build flag -DNOISE_SAMPLE_INTERVAL_MS=250).
+// Not supported by CC1101.
+#if !defined(NOISE_SAMPLE_INTERVAL_MS)
+#define NOISE_SAMPLE_INTERVAL_MS 0
+#endif
+#define NOISE_THRESHOLD_DB 10
+
+// Max. number of radio transceivers used by all WeatherSensor instances (1...4)
+// (see WeatherSensor::setRadio() and WeatherSensor::addRadio())
+#define MAX_RADIOS 2
+
+// Automatic frequency correction (SX1276 only - frequency error indicator)
+// The frequency error of decoded frames is averaged; if the average exceeds
+// FREQ_TRACK_THRESHOLD_KHZ (0: disabled), the receiver is retuned by max. FREQ_TRACK_STEP_KHZ.
+// The learned correction (max. +/-FREQ_TRACK_MAX_KHZ) is stored in Preferences
+// and added to the frequency offset passed to WeatherSensor::begin().
+// Disabled by default - the correction is written to flash; no effect with other transceivers.
+// To enable, set e.g. 10 (here or as build flag -DFREQ_TRACK_THRESHOLD_KHZ=10).
+#if !defined(FREQ_TRACK_THRESHOLD_KHZ)
+#define FREQ_TRACK_THRESHOLD_KHZ 0
+#endif
+#define FREQ_TRACK_STEP_KHZ 5
+#define FREQ_TRACK_MAX_KHZ 50
+
 
 // ------------------------------------------------------------------------------------------------
 // --- Rain Gauge / Lightning sensor data retention during deep sleep ---
@@ -131,6 +267,14 @@
     #endif
 #endif
 
+// Using Preferences: minimum interval [s] between writes of modified rain gauge data
+// (0: write after each update; otherwise RainGauge::flush() must be called before deep sleep)
+#define RAINGAUGE_FLUSH_INTERVAL 0
+
+// Using Preferences: minimum interval [s] between writes of modified lightning data
+// (0: write after each update; otherwise Lightning::flush() must be called before deep sleep)
+#define LIGHTNING_FLUSH_INTERVAL 0
+
 // ------------------------------------------------------------------------------------------------
 // --- Board ---
 // ------------------------------------------------------------------------------------------------
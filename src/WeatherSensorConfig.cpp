@@ -42,6 +42,10 @@
 // 20240702 Fixed handling of empty list of IDs / 0x00000000 in Preferences
 // 20241113 Added getting/setting of sensor include/exclude list from JSON strings
 // 20260430 Added setSensorsCfg() variant with rx_flags and enabled decoders
+// 20261016 Include/exclude lists are kept sorted (binary search in findSlot()),
+//          changed size of include/exclude lists in bytes to uint16_t
+//          Added loadFreqCorrection() / saveFreqCorrection()
+//          Buffers for include/exclude lists are allocated at runtime
 //
 //
 // ToDo:
@@ -49,6 +53,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <ArduinoJson.h>
 #include "WeatherSensorCfg.h"
 #include "WeatherSensor.h"
@@ -64,8 +69,9 @@ void WeatherSensor::initList(std::vector<uint32_t> &list, const std::vector<uint
     {
         size_t size = cfgPrefs.getBytesLength(key);
         log_d("Using sensor_ids_%s list from Preferences (%d bytes)", key, size);
-        uint8_t buf[48];
-        cfgPrefs.getBytes(key, buf, size);
+        std::vector<uint8_t> buf(std::max(size, (size_t)4));
+        cfgPrefs.getBytes(key, buf.data(), size);
+        size = std::min(size, (size_t)MAX_SENSOR_IDS * 4) & ~3U;
         if ((buf[0] | buf[1] | buf[2] | buf[3]) == 0)
         {
             size = 0;
@@ -95,8 +101,15 @@ void WeatherSensor::initList(std::vector<uint32_t> &list, const std::vector<uint
     }
 }
 
+// Sort include/exclude lists for binary search
+void WeatherSensor::sortLists(void)
+{
+    std::sort(sensor_ids_inc.begin(), sensor_ids_inc.end());
+    std::sort(sensor_ids_exc.begin(), sensor_ids_exc.end());
+}
+
 // Set sensors include list in Preferences
-void WeatherSensor::setSensorsInc(uint8_t *buf, uint8_t size)
+void WeatherSensor::setSensorsInc(uint8_t *buf, uint16_t size)
 {
     log_d("size: %d", size);
     cfgPrefs.begin("BWS-CFG", false);
@@ -116,10 +129,11 @@ void WeatherSensor::setSensorsInc(uint8_t *buf, uint8_t size)
             (buf[i + 2] << 8) |
             buf[i + 3]);
     }
+    std::sort(sensor_ids_inc.begin(), sensor_ids_inc.end());
 }
 
 // Get sensors include list from Preferences
-uint8_t WeatherSensor::getSensorsInc(uint8_t *payload)
+uint16_t WeatherSensor::getSensorsInc(uint8_t *payload)
 {
     for (const uint32_t &id : sensor_ids_inc)
     {
@@ -133,7 +147,7 @@ uint8_t WeatherSensor::getSensorsInc(uint8_t *payload)
 }
 
 // Set sensors exclude list in Preferences
-void WeatherSensor::setSensorsExc(uint8_t *buf, uint8_t size)
+void WeatherSensor::setSensorsExc(uint8_t *buf, uint16_t size)
 {
     log_d("size: %d", size);
     cfgPrefs.begin("BWS-CFG", false);
@@ -153,10 +167,11 @@ void WeatherSensor::setSensorsExc(uint8_t *buf, uint8_t size)
             (buf[i + 2] << 8) |
             buf[i + 3]);
     }
+    std::sort(sensor_ids_exc.begin(), sensor_ids_exc.end());
 }
 
 // Get sensors exclude list
-uint8_t WeatherSensor::getSensorsExc(uint8_t *payload)
+uint16_t WeatherSensor::getSensorsExc(uint8_t *payload)
 {
     for (const uint32_t &id : sensor_ids_exc)
     {
@@ -209,39 +224,43 @@ String WeatherSensor::getSensorsExcJson(void)
 }
 
 // Convert JSON string to sensor IDs as byte array
-uint8_t WeatherSensor::convSensorsJson(std::vector<uint32_t> &ids, String json, uint8_t *buf)
+uint16_t WeatherSensor::convSensorsJson(std::vector<uint32_t> &ids, String json, std::vector<uint8_t> &buf)
 {
     JsonDocument doc;
     deserializeJson(doc, json);
 
     JsonArray data = doc["ids"].as<JsonArray>();
     ids.clear();
-    for (size_t i = 0; (i < data.size()) && (i < MAX_SENSOR_IDS); i++)
+    size_t count = std::min(data.size(), (size_t)MAX_SENSOR_IDS);
+
+    // At least one ID - setSensorsInc()/setSensorsExc() check the first ID
+    buf.assign(std::max(count, (size_t)1) * 4, 0);
+    for (size_t i = 0; i < count; i++)
     {
         String str = data[i].as<String>();
         log_d("ID: %s", str.c_str());
         for (size_t j=2; j < 10; j += 2) {
             String hexStr = str.substring(j, j + 2);
-            *buf++ = (uint8_t)strtol(hexStr.c_str(), NULL, 16);
+            buf[i * 4 + (j - 2) / 2] = (uint8_t)strtol(hexStr.c_str(), NULL, 16);
         }
     }
-    return data.size() * 4;
+    return count * 4;
 }
 
 // Set sensors include list from JSON string
 void WeatherSensor::setSensorsIncJson(String json)
 {
-    uint8_t buf[MAX_SENSOR_IDS * 4];
-    uint8_t size = convSensorsJson(sensor_ids_inc, json, buf);
-    setSensorsInc(buf, size);
+    std::vector<uint8_t> buf;
+    uint16_t size = convSensorsJson(sensor_ids_inc, json, buf);
+    setSensorsInc(buf.data(), size);
 }
 
 // Set sensors exclude list from JSON string
 void WeatherSensor::setSensorsExcJson(String json)
 {
-    uint8_t buf[MAX_SENSOR_IDS * 4];
-    uint8_t size = convSensorsJson(sensor_ids_exc, json, buf);
-    setSensorsExc(buf, size);
+    std::vector<uint8_t> buf;
+    uint16_t size = convSensorsJson(sensor_ids_exc, json, buf);
+    setSensorsExc(buf.data(), size);
 }
 
 // Set sensor configuration and store in Preferences
@@ -257,7 +276,7 @@ void WeatherSensor::setSensorsCfg(uint8_t max_sensors, uint8_t rx_flags, uint8_t
     log_d("max_sensors: %u", max_sensors);
     log_d("rx_flags: %u", rxFlags);
     log_d("enabled_decoders: %u", enDecoders);
-    sensor.resize(max_sensors);
+    resizeSlots(max_sensors);
 }
 
 // Set sensor configuration and store in Preferences
@@ -282,3 +301,27 @@ void WeatherSensor::getSensorsCfg(uint8_t &max_sensors, uint8_t &rx_flags, uint8
     en_decoders = cfgPrefs.getUChar("endec", 0xFF);
     cfgPrefs.end();
 }
+
+#if FREQ_TRACK_THRESHOLD_KHZ > 0
+// Get learned frequency correction from Preferences
+float WeatherSensor::loadFreqCorrection(uint8_t irq)
+{
+    char key[8];
+    snprintf(key, sizeof(key), "fcorr%u", irq);
+    cfgPrefs.begin("BWS-CFG", false);
+    float correction = cfgPrefs.getFloat(key, 0);
+    cfgPrefs.end();
+    log_d("%s: %.1f kHz", key, correction);
+    return correction;
+}
+
+// Store learned frequency correction in Preferences
+void WeatherSensor::saveFreqCorrection(uint8_t irq, float correction_khz)
+{
+    char key[8];
+    snprintf(key, sizeof(key), "fcorr%u", irq);
+    cfgPrefs.begin("BWS-CFG", false);
+    cfgPrefs.putFloat(key, correction_khz);
+    cfgPrefs.end();
+}
+#endif
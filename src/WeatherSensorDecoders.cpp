@@ -55,14 +55,29 @@
 // 20260224 Removed obsolete variable f_3in1 and related code in decodeBresser6In1Payload()
 //          Fixed High Precision Thermo Hygro Sensor (P/N 7009971) in decodeBresser6In1Payload()
 // 20260306 Added missing 0x prefix for ID in verbose log message
+// 20261016 Added classifyMessage() to select the decoder by message signature
+//          Added correction of bit errors by digest syndrome (6-in-1, 7-in-1)
+//          Added repair of 5-in-1 messages by redundancy, per-sensor count of rescued messages
+//          Replaced BCD expressions by functions from BcdUtils.h,
+//          BCD digit validity is reflected in the *_ok flags
+//          Changed 5-in-1 parity and checksum to word-wide inverted_copy_check()/count_bits()
+//          Bit error correction / repair can be disabled at run time (for combining of messages)
+//          findSlot(): Save assigned slot in lastSlot, binary search in include/exclude lists,
+//          lookup of existing slot via slotIndex
+//          Added slot eviction in findSlot() (evictSlot())
+//          Added errorIds()
+//          Messages not matching any signature are reported as checksum errors
 //
 // ToDo:
 // -
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include "WeatherSensorCfg.h"
 #include "WeatherSensor.h"
+#include "BcdUtils.h"
+#include "DigestUtils.h"
 
 //
 // Find slot in sensor data array
@@ -72,53 +87,39 @@ int WeatherSensor::findSlot(uint32_t id, DecodeStatus *status)
     log_v("find_slot(): ID=0x%08X", id);
 
     // Skip sensors from exclude-list (if any)
-    for (const uint32_t &exc : sensor_ids_exc)
+    if (std::binary_search(sensor_ids_exc.begin(), sensor_ids_exc.end(), id))
     {
-        if (id == exc)
-        {
-            log_v("In Exclude-List, skipping!");
-            *status = DECODE_SKIP;
-            return -1;
-        }
+        log_v("In Exclude-List, skipping!");
+        *status = DECODE_SKIP;
+        return -1;
     }
 
     // Handle sensors from include-list (if not empty)
-    if (sensor_ids_inc.size() > 0)
+    if ((sensor_ids_inc.size() > 0) &&
+        !std::binary_search(sensor_ids_inc.begin(), sensor_ids_inc.end(), id))
     {
-        bool found = false;
-        for (const uint32_t &inc : sensor_ids_inc)
-        {
-            if (id == inc)
-            {
-                found = true;
-                break;
-            }
-        }
-        if (!found)
-        {
-            log_v("Not in Include-List, skipping!");
-            *status = DECODE_SKIP;
-            return -1;
-        }
+        log_v("Not in Include-List, skipping!");
+        *status = DECODE_SKIP;
+        return -1;
     }
 
-    // Search all slots
+    // Check if sensor has already been stored
+    int update_slot = findId(id);
     int free_slot = -1;
-    int update_slot = -1;
-    for (size_t i = 0; i < sensor.size(); i++)
+    if (update_slot < 0)
     {
-        log_d("sensor[%d]: v=%d id=0x%08X t=%d c=%d", i, sensor[i].valid, (unsigned int)sensor[i].sensor_id, sensor[i].s_type, sensor[i].complete);
-
-        // Save first free slot
-        if (!sensor[i].valid && (free_slot < 0))
+        // Find first free slot
+        for (size_t i = 0; i < sensor.size(); i++)
         {
-            free_slot = i;
+            if (!sensor[i].valid)
+            {
+                free_slot = i;
+                break;
+            }
         }
-
-        // Check if sensor has already been stored
-        else if (sensor[i].valid && (sensor[i].sensor_id == id))
+        if (free_slot < 0)
         {
-            update_slot = i;
+            free_slot = evictSlot();
         }
     }
 
@@ -127,6 +128,7 @@ int WeatherSensor::findSlot(uint32_t id, DecodeStatus *status)
         // Update slot
         log_v("find_slot(): Updating slot #%d", update_slot);
         *status = DECODE_OK;
+        lastSlot = update_slot;
         return update_slot;
     }
     else if (free_slot > -1)
@@ -134,26 +136,245 @@ int WeatherSensor::findSlot(uint32_t id, DecodeStatus *status)
         // Store to free slot
         log_v("find_slot(): Storing into slot #%d", free_slot);
         *status = DECODE_OK;
+        indexSlot(id, free_slot);
+        lastSlot = free_slot;
         return free_slot;
     }
     else
     {
         log_v("find_slot(): No slot left");
         // No slot left
+        slotStats.rejected++;
         *status = DECODE_FULL;
         return -1;
     }
 }
 
+//
+// Select slot to be replaced by a new sensor
+//
+int WeatherSensor::evictSlot(void)
+{
+    if (evictionPolicy == SLOT_EVICT_NEVER)
+        return -1;
+
+    int victim = -1;
+    for (size_t i = 0; i < sensor.size(); i++)
+    {
+        // Sensors from include list are pinned
+        if (std::binary_search(sensor_ids_inc.begin(), sensor_ids_inc.end(), sensor[i].sensor_id))
+            continue;
+
+        if (victim < 0)
+        {
+            victim = i;
+        }
+        else if (evictionPolicy == SLOT_EVICT_LRU)
+        {
+            // millis() wrap-around safe comparison
+            if ((int32_t)(sensor[i].last_seen - sensor[victim].last_seen) < 0)
+                victim = i;
+        }
+        else if (sensor[i].rssi < sensor[victim].rssi)
+        {
+            victim = i;
+        }
+    }
+
+    if ((victim < 0) || ((evictionPolicy == SLOT_EVICT_RSSI) && (rssi <= sensor[victim].rssi)))
+        return -1;
+
+    log_d("Evicting slot #%d (ID: 0x%08X)", victim, (unsigned int)sensor[victim].sensor_id);
+    slotStats.evicted++;
+    sensor[victim] = sensor_t();
+    return victim;
+}
+
+
+#if DIGEST_CORRECTION_BITS > 0
+// Check if x is +2^n or -2^n (modulo 256)
+static inline bool signedPow2(uint8_t x)
+{
+    uint8_t y = -x;
+    return (x != 0) && (((x & (x - 1)) == 0) || ((y & (y - 1)) == 0));
+}
+#endif
+
+//
+// Classify message by cheap structural signatures
+//
+// Necessary conditions (a decoder cannot succeed if not met):
+// - 5-in-1:  first 13 bytes are the inverse of the following 13 bytes,
+//            except for up to PARITY_REPAIR_COLUMNS bytes; messages with more mismatching
+//            bytes, but at least 7 matching bytes are damaged 5-in-1 messages
+//            (the decoder returns DECODE_PAR_ERR)
+// - 6-in-1:  sum of msg[2]..msg[17] is 0xff (modulo 256); with digest error correction,
+//            a deviation by up to DIGEST_CORRECTION_BITS powers of two is accepted
+// - Leakage: type nibble 5, channel != 0, ALARM != NALARM
+//
+// Heuristics (raw type nibble in msg[6], not whitened):
+// - 7-in-1:    types 1, 8, 10, 11, 12, 13
+// - Lightning: type 9
+// - Types 0, 6, 7, 14 and 15 are unknown - both 7-in-1 and lightning remain candidates
+// - Type 1 is used by 6-in-1 and 7-in-1 weather stations; if both are candidates,
+//   the 7-in-1 temperature/humidity fields must be valid BCD after 0xaa de-whitening
+//
+uint8_t WeatherSensor::classifyMessage(const uint8_t *msg, uint8_t msgSize)
+{
+#if defined(LIGHTNING_TEST_DATA)
+    // Lightning decoder replaces the received message by test data
+    (void)msg;
+    (void)msgSize;
+    return 0xFF;
+#endif
+
+    if (msgSize < 26)
+    {
+        // Message too short to evaluate signatures
+        return 0xFF;
+    }
+
+    // 5-in-1: inverted copy (apart from repairable / damaged columns);
+    // a random match is virtually impossible - no other candidates
+    const unsigned maxErrors = (PARITY_REPAIR_COLUMNS > 6) ? PARITY_REPAIR_COLUMNS : 6;
+    if (inverted_copy_errors(msg, 13, maxErrors) <= maxErrors)
+    {
+        return DECODER_5IN1;
+    }
+
+    uint8_t candidates = 0;
+    uint8_t type = msg[6] >> 4;
+
+    // 6-in-1: 8-bit add checksum
+    uint8_t sum = 0;
+    for (unsigned i = 2; i < 18; i++)
+    {
+        sum += msg[i];
+    }
+    if (sum == 0xff)
+    {
+        candidates |= DECODER_6IN1;
+    }
+#if DIGEST_CORRECTION_BITS > 0
+    else
+    {
+        // Each bit error changes the sum by +/-2^n
+        uint8_t diff = 0xff - sum;
+        bool correctable = signedPow2(diff);
+#if DIGEST_CORRECTION_BITS > 1
+        for (unsigned n = 0; (n < 8) && !correctable; n++)
+        {
+            correctable = signedPow2(diff - (1 << n)) || signedPow2(diff + (1 << n));
+        }
+#endif
+        if (correctable)
+        {
+            candidates |= DECODER_6IN1;
+        }
+    }
+#endif
+
+    // Water leakage sensor: type, channel and complementary alarm flags
+    if ((type == SENSOR_TYPE_LEAKAGE) && ((msg[6] & 0x7) != 0) &&
+        (((msg[7] & 0x80) != 0) != ((msg[7] & 0x40) != 0)))
+    {
+        candidates |= DECODER_LEAKAGE;
+    }
+
+    switch (type)
+    {
+    case SENSOR_TYPE_WEATHER1:
+    case SENSOR_TYPE_AIR_PM:
+    case SENSOR_TYPE_CO2:
+    case SENSOR_TYPE_HCHO_VOC:
+    case SENSOR_TYPE_WEATHER3:
+    case SENSOR_TYPE_WEATHER8:
+        candidates |= DECODER_7IN1;
+        break;
+    case SENSOR_TYPE_LIGHTNING:
+        candidates |= DECODER_LIGHTNING;
+        break;
+    case SENSOR_TYPE_THERMO_HYGRO:
+    case SENSOR_TYPE_POOL_THERMO:
+    case SENSOR_TYPE_SOIL:
+    case SENSOR_TYPE_LEAKAGE:
+        // 6-in-1 / leakage sensor types only
+        break;
+    default:
+        candidates |= DECODER_7IN1 | DECODER_LIGHTNING;
+        break;
+    }
+
+    if ((candidates & DECODER_6IN1) && (candidates & DECODER_7IN1) && (type == SENSOR_TYPE_WEATHER1))
+    {
+        // 7-in-1 temperature (msgw[14], msgw[15] high nibble) and humidity (msgw[16]),
+        // flags (msgw[15] low nibble) masked
+        if (!bcd_valid(bcd_field(msg, 28, 6, 0xaa) & 0xFFF0FF))
+        {
+            candidates &= ~DECODER_7IN1;
+        }
+    }
+
+    return candidates;
+}
+
+//
+// Get possible sensor IDs of an undecodable message
+//
+// - 6-in-1 / leakage: msg[2..5]
+// - 7-in-1 / lightning: msg[2..3], whitened with 0xaa
+// - 5-in-1: msg[14], inverted copy in msg[1]
+//
+unsigned WeatherSensor::errorIds(const uint8_t *msg, uint8_t msgSize, uint32_t *ids)
+{
+    unsigned n = 0;
+
+    if (msgSize < 26)
+        return 0;
+
+    ids[n++] = ((uint32_t)msg[2] << 24) | (msg[3] << 16) | (msg[4] << 8) | (msg[5]);
+    ids[n++] = ((msg[2] ^ 0xaa) << 8) | (msg[3] ^ 0xaa);
+    if ((msg[14] ^ msg[1]) == 0xff)
+        ids[n++] = msg[14];
+
+    return n;
+}
 
 DecodeStatus WeatherSensor::decodeMessage(const uint8_t *msg, uint8_t msgSize)
 {
     DecodeStatus decode_res = DECODE_INVALID;
 
+    // Select decoder by message signature; try all decoders if ambiguous
+    uint8_t signature = classifyMessage(msg, msgSize);
+    uint8_t candidates = signature & enDecoders;
+    uint8_t decoders = enDecoders;
+
+    if (candidates == 0)
+    {
+        log_v("No decoder matches message signature");
+        classStats.rejected++;
+
+        // Sensor types which are only used by 6-in-1 and leakage sensors, but neither
+        // signature matches - the 6-in-1 checksum failed
+        return (signature == 0) ? DECODE_CHK_ERR : DECODE_INVALID;
+    }
+    else if ((candidates & (candidates - 1)) == 0)
+    {
+        // Exactly one candidate
+        classStats.single++;
+        decoders = candidates;
+    }
+    else
+    {
+        log_v("Ambiguous message signature [%02X], trying all decoders", candidates);
+        classStats.fallback++;
+    }
+
 #ifdef BRESSER_7_IN_1
-    if (enDecoders & DECODER_7IN1) {
+    if (decoders & DECODER_7IN1) {
         decode_res = decodeBresser7In1Payload(msg, msgSize);
         if (decode_res == DECODE_OK ||
+            decode_res == DECODE_OK_CORRECTED ||
             decode_res == DECODE_FULL ||
             decode_res == DECODE_SKIP)
         {
@@ -162,9 +383,10 @@ DecodeStatus WeatherSensor::decodeMessage(const uint8_t *msg, uint8_t msgSize)
     }
 #endif
 #ifdef BRESSER_6_IN_1
-    if (enDecoders & DECODER_6IN1) {
+    if (decoders & DECODER_6IN1) {
         decode_res = decodeBresser6In1Payload(msg, msgSize);
         if (decode_res == DECODE_OK ||
+            decode_res == DECODE_OK_CORRECTED ||
             decode_res == DECODE_FULL ||
             decode_res == DECODE_SKIP)
         {
@@ -173,9 +395,10 @@ DecodeStatus WeatherSensor::decodeMessage(const uint8_t *msg, uint8_t msgSize)
     }
 #endif
 #ifdef BRESSER_5_IN_1
-    if (enDecoders & DECODER_5IN1) {
+    if (decoders & DECODER_5IN1) {
         decode_res = decodeBresser5In1Payload(msg, msgSize);
         if (decode_res == DECODE_OK ||
+            decode_res == DECODE_OK_CORRECTED ||
             decode_res == DECODE_FULL ||
             decode_res == DECODE_SKIP)
         {
@@ -184,9 +407,10 @@ DecodeStatus WeatherSensor::decodeMessage(const uint8_t *msg, uint8_t msgSize)
     }
 #endif
 #ifdef BRESSER_LIGHTNING
-    if (enDecoders & DECODER_LIGHTNING) {
+    if (decoders & DECODER_LIGHTNING) {
         decode_res = decodeBresserLightningPayload(msg, msgSize);
         if (decode_res == DECODE_OK ||
+            decode_res == DECODE_OK_CORRECTED ||
             decode_res == DECODE_FULL ||
             decode_res == DECODE_SKIP)
         {
@@ -195,7 +419,7 @@ DecodeStatus WeatherSensor::decodeMessage(const uint8_t *msg, uint8_t msgSize)
     }
 #endif
 #ifdef BRESSER_LEAKAGE
-    if (enDecoders & DECODER_LEAKAGE) {
+    if (decoders & DECODER_LEAKAGE) {
         decode_res = decodeBresserLeakagePayload(msg, msgSize);
     }
 #endif
@@ -232,37 +456,57 @@ DecodeStatus WeatherSensor::decodeMessage(const uint8_t *msg, uint8_t msgSize)
 //
 // Returns:
 //
-// DECODE_OK      - OK - WeatherData will contain the updated information
-// DECODE_PAR_ERR - Parity Error
-// DECODE_CHK_ERR - Checksum Error
+// DECODE_OK           - OK - WeatherData will contain the updated information
+// DECODE_OK_CORRECTED - OK after repair of mismatching columns
+// DECODE_PAR_ERR      - Parity Error
+// DECODE_CHK_ERR      - Checksum Error
 //
 #ifdef BRESSER_5_IN_1
+#if PARITY_REPAIR_COLUMNS > 0
+// Plausibility check of repaired 5-in-1 message:
+// checksum must match and BCD fields must be valid (or 0xf on error)
+static bool plausible5in1(const uint8_t *msg)
+{
+    uint32_t temp_bcd = ((msg[21] & 0x0f) << 8) | msg[20];
+    uint32_t rain_bcd = (msg[24] << 8) | msg[23];
+
+    return (count_bits(&msg[14], 12) == msg[13]) &&
+           bcd_valid(rain_bcd) &&
+           (bcd_valid(temp_bcd) || ((msg[20] & 0x0f) == 0x0f)) &&
+           (bcd_valid(msg[22]) || ((msg[22] & 0x0f) == 0x0f));
+}
+#endif
+
 DecodeStatus WeatherSensor::decodeBresser5In1Payload(const uint8_t *msg, uint8_t msgSize)
 {
     // First 13 bytes need to match inverse of last 13 bytes
-    for (unsigned col = 0; col < msgSize / 2; ++col)
+    int col = inverted_copy_check(msg, msgSize / 2);
+    bool corrected = false;
+#if PARITY_REPAIR_COLUMNS > 0
+    uint8_t msgc[MSG_BUF_SIZE];
+    if ((col >= 0) && correction && (msgSize <= MSG_BUF_SIZE))
     {
-        if ((msg[col] ^ msg[col + 13]) != 0xff)
+        // Select the correct copy of each mismatching column in a copy of the message
+        memcpy(msgc, msg, msgSize);
+        int repaired = repair_inverted_copy(msgc, msgSize / 2, PARITY_REPAIR_COLUMNS, plausible5in1);
+        if (repaired > 0)
         {
-            log_d("Parity wrong at column %d", col);
-            return DECODE_PAR_ERR;
+            log_d("Parity wrong at column %d, repaired %d column(s)", col, repaired);
+            msg = msgc;
+            corrected = true;
         }
     }
+#endif
+    if ((col >= 0) && !corrected)
+    {
+        log_d("Parity wrong at column %d", col);
+        return DECODE_PAR_ERR;
+    }
 
     // Verify checksum (number bits set in bytes 14-25)
-    uint8_t bitsSet = 0;
+    uint8_t bitsSet = count_bits(&msg[14], msgSize - 14);
     uint8_t expectedBitsSet = msg[13];
 
-    for (uint8_t p = 14; p < msgSize; p++)
-    {
-        uint8_t currentByte = msg[p];
-        while (currentByte)
-        {
-            bitsSet += (currentByte & 1);
-            currentByte >>= 1;
-        }
-    }
-
     if (bitsSet != expectedBitsSet)
     {
         log_d("Checksum wrong - actual [%02X] != [%02X]", bitsSet, expectedBitsSet);
@@ -279,6 +523,12 @@ DecodeStatus WeatherSensor::decodeBresser5In1Payload(const uint8_t *msg, uint8_t
     if (status != DECODE_OK)
         return status;
 
+    // Reset statistics if slot is assigned to another sensor
+    if (sensor[slot].sensor_id != id_tmp)
+        sensor[slot].rescued = 0;
+    if (corrected)
+        sensor[slot].rescued++;
+
     sensor[slot].sensor_id = id_tmp;
     sensor[slot].chan = 0; // for compatibility with other decoders
     sensor[slot].startup = ((msg[15] & 0x80) == 0) ? true : false;
@@ -287,18 +537,23 @@ DecodeStatus WeatherSensor::decodeBresser5In1Payload(const uint8_t *msg, uint8_t
     sensor[slot].rssi = rssi;
     sensor[slot].complete = true;
 
-    int temp_raw = (msg[20] & 0x0f) + ((msg[20] & 0xf0) >> 4) * 10 + (msg[21] & 0x0f) * 100;
+    // BCD fields are stored least significant byte first
+    uint32_t temp_bcd = ((msg[21] & 0x0f) << 8) | msg[20];
+    uint32_t wind_bcd = ((msg[19] & 0x0f) << 8) | msg[18];
+    uint32_t rain_bcd = (msg[24] << 8) | msg[23];
+
+    int temp_raw = bcd_value(temp_bcd);
     if (msg[25] & 0x0f)
     {
         temp_raw = -temp_raw;
     }
     sensor[slot].w.temp_c = temp_raw * 0.1f;
 
-    sensor[slot].w.humidity = (msg[22] & 0x0f) + ((msg[22] & 0xf0) >> 4) * 10;
+    sensor[slot].w.humidity = bcd_value(msg[22]);
 
     int wind_direction_raw = ((msg[17] & 0xf0) >> 4) * 225;
     int gust_raw = ((msg[17] & 0x0f) << 8) + msg[16];
-    int wind_raw = (msg[18] & 0x0f) + ((msg[18] & 0xf0) >> 4) * 10 + (msg[19] & 0x0f) * 100;
+    int wind_raw = bcd_value(wind_bcd);
 
 #ifdef WIND_DATA_FLOATINGPOINT
     sensor[slot].w.wind_direction_deg = wind_direction_raw * 0.1f;
@@ -311,7 +566,7 @@ DecodeStatus WeatherSensor::decodeBresser5In1Payload(const uint8_t *msg, uint8_t
     sensor[slot].w.wind_avg_meter_sec_fp1 = wind_raw;
 #endif
 
-    int rain_raw = (msg[23] & 0x0f) + ((msg[23] & 0xf0) >> 4) * 10 + (msg[24] & 0x0f) * 100 + ((msg[24] & 0xf0) >> 4) * 1000;
+    int rain_raw = bcd_value(rain_bcd);
     sensor[slot].w.rain_mm = rain_raw * 0.1f;
 
     // Check if the message is from a Bresser Professional Rain Gauge
@@ -332,21 +587,21 @@ DecodeStatus WeatherSensor::decodeBresser5In1Payload(const uint8_t *msg, uint8_t
     }
     else
     {
-        sensor[slot].w.wind_ok = true;
-        sensor[slot].w.humidity_ok = (msg[22] & 0x0f) <= 9; // BCD, 0x0f on error
+        sensor[slot].w.wind_ok = bcd_valid(wind_bcd);
+        sensor[slot].w.humidity_ok = bcd_valid(msg[22]); // BCD, 0x0f on error
     }
 
     sensor[slot].s_type = type_tmp;
     sensor[slot].decoder = DECODER_5IN1;
-    sensor[slot].w.temp_ok = (msg[20] & 0x0f) <= 9; // BCD, 0x0f on error
+    sensor[slot].w.temp_ok = bcd_valid(temp_bcd); // BCD, 0x0f on error
     sensor[slot].w.light_ok = false;
     sensor[slot].w.uv_ok = false;
-    sensor[slot].w.rain_ok = true;
+    sensor[slot].w.rain_ok = bcd_valid(rain_bcd);
 
     const int i = slot;
     log_d("sensor[%d]: v=%d id=0x%08X t=%d c=%d", i, sensor[i].valid, (unsigned int)sensor[i].sensor_id, sensor[i].s_type, sensor[i].complete);
 
-    return DECODE_OK;
+    return corrected ? DECODE_OK_CORRECTED : DECODE_OK;
 }
 #endif
 
@@ -432,9 +687,10 @@ DecodeStatus WeatherSensor::decodeBresser5In1Payload(const uint8_t *msg, uint8_t
 //
 //  Returns:
 //
-//  DECODE_OK      - OK - WeatherData will contain the updated information
-//  DECODE_DIG_ERR - Digest Check Error
-//  DECODE_CHK_ERR - Checksum Error
+//  DECODE_OK           - OK - WeatherData will contain the updated information
+//  DECODE_OK_CORRECTED - OK after correction of bit errors
+//  DECODE_DIG_ERR      - Digest Check Error
+//  DECODE_CHK_ERR      - Checksum Error
 #ifdef BRESSER_6_IN_1
 DecodeStatus WeatherSensor::decodeBresser6In1Payload(const uint8_t *msg, uint8_t msgSize)
 {
@@ -451,17 +707,39 @@ DecodeStatus WeatherSensor::decodeBresser6In1Payload(const uint8_t *msg, uint8_t
     // LFSR-16 digest, generator 0x8810 init 0x5412
     int chkdgst = (msg[0] << 8) | msg[1];
     int digest = lfsr_digest16(&msg[2], 15, 0x8810, 0x5412);
+    bool corrected = false;
+#if DIGEST_CORRECTION_BITS > 0
+    uint8_t msgc[MSG_BUF_SIZE];
+#endif
     if (chkdgst != digest)
     {
-        log_d("Digest check failed - [%02X] != [%02X]", chkdgst, digest);
-        return DECODE_DIG_ERR;
+#if DIGEST_CORRECTION_BITS > 0
+        // Try to correct bit errors in a copy of the message - the result is validated by the checksum
+        bool fixed = false;
+        if (correction && (msgSize <= MSG_BUF_SIZE))
+        {
+            memcpy(msgc, msg, msgSize);
+            fixed = Lfsr16Syndrome<0x8810, 0x5412, 15>::correct(msgc, chkdgst ^ digest, DIGEST_CORRECTION_BITS) > 0;
+        }
+        if (fixed)
+        {
+            log_d("Digest check failed - [%02X] != [%02X], corrected", chkdgst, digest);
+            msg = msgc;
+            corrected = true;
+        }
+        else
+#endif
+        {
+            log_d("Digest check failed - [%02X] != [%02X]", chkdgst, digest);
+            return DECODE_DIG_ERR;
+        }
     }
     // Checksum, add with carry
     int sum = add_bytes(&msg[2], 16); // msg[2] to msg[17]
     if ((sum & 0xff) != 0xff)
     {
         log_d("Checksum failed");
-        return DECODE_CHK_ERR;
+        return corrected ? DECODE_DIG_ERR : DECODE_CHK_ERR;
     }
 
     uint32_t id_tmp = ((uint32_t)msg[2] << 24) | (msg[3] << 16) | (msg[4] << 8) | (msg[5]);
@@ -485,6 +763,12 @@ DecodeStatus WeatherSensor::decodeBresser6In1Payload(const uint8_t *msg, uint8_t
         sensor[slot].w.wind_ok = false;
         sensor[slot].w.rain_ok = false;
     }
+    // Reset statistics if slot is assigned to another sensor
+    if (sensor[slot].sensor_id != id_tmp)
+        sensor[slot].rescued = 0;
+    if (corrected)
+        sensor[slot].rescued++;
+
     sensor[slot].sensor_id = id_tmp;
     sensor[slot].s_type = type_tmp;
     sensor[slot].chan = chan_tmp;
@@ -498,7 +782,7 @@ DecodeStatus WeatherSensor::decodeBresser6In1Payload(const uint8_t *msg, uint8_t
     if (temp_ok)
     {
         bool sign = (msg[13] >> 3) & 1;
-        int temp_raw = (msg[12] >> 4) * 100 + (msg[12] & 0x0f) * 10 + (msg[13] >> 4);
+        int temp_raw = bcd_decode(msg, 24, 3);
 
         temp = ((sign) ? (temp_raw - 1000) : temp_raw) * 0.1f;
 
@@ -510,31 +794,29 @@ DecodeStatus WeatherSensor::decodeBresser6In1Payload(const uint8_t *msg, uint8_t
         }
 
         sensor[slot].w.temp_c = temp;
-        sensor[slot].w.humidity = (msg[14] >> 4) * 10 + (msg[14] & 0x0f);
+        sensor[slot].w.humidity = bcd_value(msg[14]);
 
         // apparently ff01 or 0000 if not available, ???0 if valid, inverted BCD
-        uv_ok = ((~msg[15] & 0xff) <= 0x99) && ((~msg[16] & 0xf0) <= 0x90);
+        uint32_t uv_bcd = bcd_field(msg, 30, 3, 0xff);
+        uv_ok = bcd_valid(uv_bcd);
         if (uv_ok)
         {
-            int uv_raw = ((~msg[15] & 0xf0) >> 4) * 100 + (~msg[15] & 0x0f) * 10 + ((~msg[16] & 0xf0) >> 4);
-            sensor[slot].w.uv = uv_raw * 0.1f;
+            sensor[slot].w.uv = bcd_value(uv_bcd) * 0.1f;
         }
     }
 
     // int unk_ok  = (msg[16] & 0xf0) == 0xf0;
     // int unk_raw = ((msg[15] & 0xf0) >> 4) * 10 + (msg[15] & 0x0f);
 
-    // invert 3 bytes wind speeds
-    uint8_t _imsg7 = msg[7] ^ 0xff;
-    uint8_t _imsg8 = msg[8] ^ 0xff;
-    uint8_t _imsg9 = msg[9] ^ 0xff;
-
-    wind_ok = (_imsg7 <= 0x99) && (_imsg8 <= 0x99) && (_imsg9 <= 0x99);
+    // wind speeds, inverted 3 bytes BCD
+    uint32_t wind_bcd = bcd_field(msg, 14, 6, 0xff);
+    wind_ok = bcd_valid(wind_bcd);
     if (wind_ok)
     {
-        int gust_raw = (_imsg7 >> 4) * 100 + (_imsg7 & 0x0f) * 10 + (_imsg8 >> 4);
-        int wavg_raw = (_imsg9 >> 4) * 100 + (_imsg9 & 0x0f) * 10 + (_imsg8 & 0x0f);
-        int wind_dir_raw = ((msg[10] & 0xf0) >> 4) * 100 + (msg[10] & 0x0f) * 10 + ((msg[11] & 0xf0) >> 4);
+        // gust: msg[7], msg[8] high nibble / average: msg[9], msg[8] low nibble
+        int gust_raw = bcd_value(wind_bcd >> 12);
+        int wavg_raw = bcd_value(wind_bcd & 0xff) * 10 + ((wind_bcd >> 8) & 0x0f);
+        int wind_dir_raw = bcd_decode(msg, 20, 3);
 
 #ifdef WIND_DATA_FLOATINGPOINT
         sensor[slot].w.wind_gust_meter_sec = gust_raw * 0.1f;
@@ -549,15 +831,12 @@ DecodeStatus WeatherSensor::decodeBresser6In1Payload(const uint8_t *msg, uint8_t
     }
 
     // rain counter, inverted 3 bytes BCD - shared with temp/hum
-    uint8_t _imsg12 = msg[12] ^ 0xff;
-    uint8_t _imsg13 = msg[13] ^ 0xff;
-    uint8_t _imsg14 = msg[14] ^ 0xff;
+    uint32_t rain_bcd = bcd_field(msg, 24, 6, 0xff);
 
-    rain_ok = (flags == 1) && (type_tmp == 1);
+    rain_ok = (flags == 1) && (type_tmp == 1) && bcd_valid(rain_bcd);
     if (rain_ok)
     {
-        int rain_raw = (_imsg12 >> 4) * 100000 + (_imsg12 & 0x0f) * 10000 + (_imsg13 >> 4) * 1000 + (_imsg13 & 0x0f) * 100 + (_imsg14 >> 4) * 10 + (_imsg14 & 0x0f);
-        sensor[slot].w.rain_mm = rain_raw * 0.1f;
+        sensor[slot].w.rain_mm = bcd_value(rain_bcd) * 0.1f;
     }
 
     // Pool / Spa thermometer
@@ -608,7 +887,7 @@ DecodeStatus WeatherSensor::decodeBresser6In1Payload(const uint8_t *msg, uint8_t
 
     const int i = slot;
     log_d("sensor[%d]: v=%d id=0x%08X t=%d c=%d", i, sensor[i].valid, (unsigned int)sensor[i].sensor_id, sensor[i].s_type, sensor[i].complete);
-    return DECODE_OK;
+    return corrected ? DECODE_OK_CORRECTED : DECODE_OK;
 }
 #endif
 
@@ -733,18 +1012,57 @@ DecodeStatus WeatherSensor::decodeBresser7In1Payload(const uint8_t *msg, uint8_t
     // LFSR-16 digest, generator 0x8810 key 0xba95 final xor 0x6df1
     int chkdgst = (msgw[0] << 8) | msgw[1];
     int digest = lfsr_digest16(&msgw[2], 23, 0x8810, 0xba95); // bresser_7in1
+    bool corrected = false;
     if ((chkdgst ^ digest) != 0x6df1)
     { // bresser_7in1
         log_d("Digest check failed - [%04X] vs [%04X] (%04X)", chkdgst, digest, chkdgst ^ digest);
-        return DECODE_DIG_ERR;
+#if DIGEST_CORRECTION_BITS > 0
+        // Try to correct bit errors - the result is validated by BCD plausibility below
+        corrected = correction && Lfsr16Syndrome<0x8810, 0xba95, 23>::correct(msgw, chkdgst ^ digest ^ 0x6df1, DIGEST_CORRECTION_BITS) > 0;
+#endif
+        if (!corrected)
+            return DECODE_DIG_ERR;
     }
 
 #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
     log_message("De-whitened Data", msgw, msgSize);
 #endif
 
+    // STYPE, STARTUP and CH are not whitened - use (possibly corrected) msgw
+    uint8_t msg6 = msgw[6] ^ 0xaa;
     int id_tmp = (msgw[2] << 8) | (msgw[3]);
-    int s_type = msg[6] >> 4; // raw data, no de-whitening
+    int s_type = msg6 >> 4;
+
+    if (corrected)
+    {
+        // Corrected message must contain valid BCD data for its sensor type
+        bool plausible;
+        if ((s_type == SENSOR_TYPE_WEATHER1) || (s_type == SENSOR_TYPE_WEATHER3) || (s_type == SENSOR_TYPE_WEATHER8))
+        {
+            // wind direction, gust, speed, rain, temperature, humidity
+            plausible = bcd_valid(bcd_field(msgw, 8, 3)) && bcd_valid(bcd_field(msgw, 14, 6)) &&
+                        bcd_valid(bcd_field(msgw, 20, 6)) && bcd_valid(bcd_field(msgw, 28, 3)) &&
+                        bcd_valid(msgw[16]);
+        }
+        else if (s_type == SENSOR_TYPE_AIR_PM)
+        {
+            plausible = bcd_valid(bcd_field(msgw, 17, 4)) && bcd_valid(bcd_field(msgw, 21, 4)) &&
+                        bcd_valid(bcd_field(msgw, 25, 4));
+        }
+        else if ((s_type == SENSOR_TYPE_CO2) || (s_type == SENSOR_TYPE_HCHO_VOC))
+        {
+            plausible = bcd_valid(bcd_field(msgw, 8, 4));
+        }
+        else
+        {
+            plausible = false;
+        }
+        if (!plausible)
+        {
+            log_d("Corrected message not plausible");
+            return DECODE_DIG_ERR;
+        }
+    }
 
     DecodeStatus status;
 
@@ -757,10 +1075,16 @@ DecodeStatus WeatherSensor::decodeBresser7In1Payload(const uint8_t *msg, uint8_t
     int flags = (msgw[15] & 0x0f);
     int battery_low = (flags & 0x06) == 0x06;
 
+    // Reset statistics if slot is assigned to another sensor
+    if (sensor[slot].sensor_id != (uint32_t)id_tmp)
+        sensor[slot].rescued = 0;
+    if (corrected)
+        sensor[slot].rescued++;
+
     sensor[slot].sensor_id = id_tmp;
     sensor[slot].s_type = s_type;
-    sensor[slot].startup = (msg[6] & 0x08) == 0x00; // raw data, no de-whitening
-    sensor[slot].chan = msg[6] & 0x07;              // raw data, no de-whitening
+    sensor[slot].startup = (msg6 & 0x08) == 0x00;
+    sensor[slot].chan = msg6 & 0x07;
     sensor[slot].decoder = DECODER_7IN1;
     sensor[slot].battery_ok = !battery_low;
     sensor[slot].valid = true;
@@ -773,31 +1097,40 @@ DecodeStatus WeatherSensor::decodeBresser7In1Payload(const uint8_t *msg, uint8_t
         bool wind_light_ok = (s_type != SENSOR_TYPE_WEATHER3);
 
         sensor[slot].w.tglobe_ok = false;
-        int wdir = (msgw[4] >> 4) * 100 + (msgw[4] & 0x0f) * 10 + (msgw[5] >> 4);
-        int wgst_raw = (msgw[7] >> 4) * 100 + (msgw[7] & 0x0f) * 10 + (msgw[8] >> 4);
-        int wavg_raw = (msgw[8] & 0x0f) * 100 + (msgw[9] >> 4) * 10 + (msgw[9] & 0x0f);
-        int rain_raw = (msgw[10] >> 4) * 100000 + (msgw[10] & 0x0f) * 10000 + (msgw[11] >> 4) * 1000 + (msgw[11] & 0x0f) * 100 + (msgw[12] >> 4) * 10 + (msgw[12] & 0x0f) * 1; // 6 digits
+        uint32_t wdir_bcd = bcd_field(msgw, 8, 3);
+        uint32_t wind_bcd = bcd_field(msgw, 14, 6); // gust (3 digits), average (3 digits)
+        uint32_t rain_bcd = bcd_field(msgw, 20, 6);
+        uint32_t temp_bcd = bcd_field(msgw, 28, 3);
+        uint32_t hum_bcd = msgw[16];
+        uint32_t lght_bcd = bcd_field(msgw, 34, 6);
+        uint32_t uv_bcd = bcd_field(msgw, 40, 3);
+
+        int wdir = bcd_value(wdir_bcd);
+        int wgst_raw = bcd_value(wind_bcd >> 12);
+        int wavg_raw = bcd_value(wind_bcd & 0xfff);
+        int rain_raw = bcd_value(rain_bcd); // 6 digits
         float rain_mm = rain_raw * 0.1f;
-        int temp_raw = (msgw[14] >> 4) * 100 + (msgw[14] & 0x0f) * 10 + (msgw[15] >> 4);
+        int temp_raw = bcd_value(temp_bcd);
         float temp_c = temp_raw * 0.1f;
         if (temp_raw > 600)
             temp_c = (temp_raw - 1000) * 0.1f;
-        int humidity = (msgw[16] >> 4) * 10 + (msgw[16] & 0x0f);
-        int lght_raw = (msgw[17] >> 4) * 100000 + (msgw[17] & 0x0f) * 10000 + (msgw[18] >> 4) * 1000 + (msgw[18] & 0x0f) * 100 + (msgw[19] >> 4) * 10 + (msgw[19] & 0x0f);
-        int uv_raw = (msgw[20] >> 4) * 100 + (msgw[20] & 0x0f) * 10 + (msgw[21] >> 4);
+        int humidity = bcd_value(hum_bcd);
+        int lght_raw = bcd_value(lght_bcd);
+        int uv_raw = bcd_value(uv_bcd);
 
         float light_klx = lght_raw * 0.001f; // TODO: remove this
         float light_lux = lght_raw;
         float uv_index = uv_raw * 0.1f;
 
         // The RTL_433 decoder does not include any field to verify that these data
-        // are ok, so we are assuming that they are ok if the decode status is ok.
-        sensor[slot].w.temp_ok = true;
-        sensor[slot].w.humidity_ok = true;
-        sensor[slot].w.wind_ok = wind_light_ok;
-        sensor[slot].w.rain_ok = true;
-        sensor[slot].w.light_ok = wind_light_ok;
-        sensor[slot].w.uv_ok = wind_light_ok;
+        // are ok, so we are assuming that they are ok if the decode status is ok
+        // and all BCD digits are valid.
+        sensor[slot].w.temp_ok = bcd_valid(temp_bcd);
+        sensor[slot].w.humidity_ok = bcd_valid(hum_bcd);
+        sensor[slot].w.wind_ok = wind_light_ok && bcd_valid(wdir_bcd) && bcd_valid(wind_bcd);
+        sensor[slot].w.rain_ok = bcd_valid(rain_bcd);
+        sensor[slot].w.light_ok = wind_light_ok && bcd_valid(lght_bcd);
+        sensor[slot].w.uv_ok = wind_light_ok && bcd_valid(uv_bcd);
         sensor[slot].w.temp_c = temp_c;
         sensor[slot].w.humidity = humidity;
 #ifdef WIND_DATA_FLOATINGPOINT
@@ -818,35 +1151,34 @@ DecodeStatus WeatherSensor::decodeBresser7In1Payload(const uint8_t *msg, uint8_t
         if (s_type == SENSOR_TYPE_WEATHER8)
         {
             // 8-in-1 sensor
-            if ((msgw[23] >> 4) < 10) {
-                sensor[slot].w.tglobe_ok = true;
-            }
-            sensor[slot].w.tglobe_c = (msgw[22] >> 4) * 10 + (msgw[22] & 0x0f) + (msgw[23] >> 4) * 0.1f;
+            uint32_t tglobe_bcd = bcd_field(msgw, 44, 3);
+            sensor[slot].w.tglobe_ok = bcd_valid(tglobe_bcd);
+            sensor[slot].w.tglobe_c = bcd_value(tglobe_bcd) * 0.1f;
         }
     }
     else if (s_type == SENSOR_TYPE_AIR_PM)
     {
 #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
-        uint16_t pn1 = (msgw[14] & 0x0f) * 1000 + (msgw[15] >> 4) * 100 + (msgw[15] & 0x0f) * 10 + (msgw[16] >> 4);
-        uint16_t pn2 = (msgw[17] >> 4) * 100 + (msgw[17] & 0x0f) * 10 + (msgw[18] >> 4);
-        uint16_t pn3 = (msgw[19] >> 4) * 100 + (msgw[19] & 0x0f) * 10 + (msgw[20] >> 4);
+        uint16_t pn1 = bcd_decode(msgw, 29, 4);
+        uint16_t pn2 = bcd_decode(msgw, 34, 3);
+        uint16_t pn3 = bcd_decode(msgw, 38, 3);
 #endif
         log_d("PN1: %04d PN2: %04d PN3: %04d", pn1, pn2, pn3);
-        sensor[slot].pm.pm_1_0 = (msgw[8] & 0x0f) * 1000 + (msgw[9] >> 4) * 100 + (msgw[9] & 0x0f) * 10 + (msgw[10] >> 4);
-        sensor[slot].pm.pm_2_5 = (msgw[10] & 0x0f) * 1000 + (msgw[11] >> 4) * 100 + (msgw[11] & 0x0f) * 10 + (msgw[12] >> 4);
-        sensor[slot].pm.pm_10 = (msgw[12] & 0x0f) * 1000 + (msgw[13] >> 4) * 100 + (msgw[13] & 0x0f) * 10 + (msgw[14] >> 4);
+        sensor[slot].pm.pm_1_0 = bcd_decode(msgw, 17, 4);
+        sensor[slot].pm.pm_2_5 = bcd_decode(msgw, 21, 4);
+        sensor[slot].pm.pm_10 = bcd_decode(msgw, 25, 4);
         sensor[slot].pm.pm_1_0_init = ((msgw[10] >> 4) & 0x0f) == 0x0f;
         sensor[slot].pm.pm_2_5_init = ((msgw[12] >> 4) & 0x0f) == 0x0f;
         sensor[slot].pm.pm_10_init = ((msgw[14] >> 4) & 0x0f) == 0x0f;
     }
     else if (s_type == SENSOR_TYPE_CO2)
     {
-        sensor[slot].co2.co2_ppm = ((msgw[4] & 0xf0) >> 4) * 1000 + (msgw[4] & 0x0f) * 100 + ((msgw[5] & 0xf0) >> 4) * 10 + (msgw[5] & 0x0f);
+        sensor[slot].co2.co2_ppm = bcd_decode(msgw, 8, 4);
         sensor[slot].co2.co2_init = (msgw[5] & 0x0f) == 0x0f;
     }
     else if (s_type == SENSOR_TYPE_HCHO_VOC)
     {
-        sensor[slot].voc.hcho_ppb = ((msgw[4] & 0xf0) >> 4) * 1000 + (msgw[4] & 0x0f) * 100 + ((msgw[5] & 0xf0) >> 4) * 10 + (msgw[5] & 0x0f);
+        sensor[slot].voc.hcho_ppb = bcd_decode(msgw, 8, 4);
         sensor[slot].voc.voc_level = (msgw[22] & 0x0f);
         sensor[slot].voc.hcho_init = (msgw[5] & 0x0f) == 0x0f;
         sensor[slot].voc.voc_init = msgw[22] == 0x0f;
@@ -855,7 +1187,7 @@ DecodeStatus WeatherSensor::decodeBresser7In1Payload(const uint8_t *msg, uint8_t
     const int i = slot;
     log_d("sensor[%d]: v=%d id=0x%08X t=%d c=%d", i, sensor[i].valid, (unsigned int)sensor[i].sensor_id, sensor[i].s_type, sensor[i].complete);
 
-    return DECODE_OK;
+    return corrected ? DECODE_OK_CORRECTED : DECODE_OK;
 }
 #endif
 
@@ -931,7 +1263,7 @@ DecodeStatus WeatherSensor::decodeBresserLightningPayload(const uint8_t *msg, ui
 
     // Counter encoded as BCD with most significant digit counting up to 15!
     // -> Maximum value: 1599
-    uint16_t ctr = (msgw[4] >> 4) * 100 + (msgw[4] & 0xf) * 10 + (msgw[5] >> 4);
+    uint16_t ctr = bcd_decode(msgw, 8, 3);
     uint8_t battery_low = (msgw[5] & 0x08) == 0x00;
     uint16_t unknown1 = ((msgw[5] & 0x0f) << 8) | msgw[6];
     uint8_t distance_km = msgw[7];
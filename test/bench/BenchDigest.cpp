@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BenchDigest.cpp
+//
+// Host micro-benchmark: bit-by-bit vs. table driven LFSR-16 digest and CRC16
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include "BenchUtils.h"
+#include "DigestUtils.h"
+
+#define ITERATIONS 200000
+#define NUM_FRAMES 64
+
+static uint8_t frames[NUM_FRAMES][27];
+
+int main(void)
+{
+    srand(1);
+    for (int f = 0; f < NUM_FRAMES; f++)
+        for (int i = 0; i < 27; i++)
+            frames[f][i] = rand() & 0xFF;
+
+    bench_header("LFSR-16 digest / CRC16");
+
+    bench_print("lfsr_digest16 7-in-1 (23 bytes)",
+        bench_run(ITERATIONS, [](unsigned i) { return lfsr_digest16_bitwise(&frames[i % NUM_FRAMES][2], 23, 0x8810, 0xba95); }),
+        bench_run(ITERATIONS, [](unsigned i) { return Lfsr16Table<0x8810, 0xba95>::digest(&frames[i % NUM_FRAMES][2], 23); }));
+
+    bench_print("lfsr_digest16 6-in-1 (15 bytes)",
+        bench_run(ITERATIONS, [](unsigned i) { return lfsr_digest16_bitwise(&frames[i % NUM_FRAMES][2], 15, 0x8810, 0x5412); }),
+        bench_run(ITERATIONS, [](unsigned i) { return Lfsr16Table<0x8810, 0x5412>::digest(&frames[i % NUM_FRAMES][2], 15); }));
+
+    bench_print("lfsr_digest16 lightning (8 bytes)",
+        bench_run(ITERATIONS, [](unsigned i) { return lfsr_digest16_bitwise(&frames[i % NUM_FRAMES][2], 8, 0x8810, 0xabf9); }),
+        bench_run(ITERATIONS, [](unsigned i) { return Lfsr16Table<0x8810, 0xabf9>::digest(&frames[i % NUM_FRAMES][2], 8); }));
+
+    // Worst case per received frame: all three digests are calculated
+    bench_print("7-in-1 + 6-in-1 + lightning",
+        bench_run(ITERATIONS, [](unsigned i) {
+            const uint8_t *msg = &frames[i % NUM_FRAMES][2];
+            return lfsr_digest16_bitwise(msg, 23, 0x8810, 0xba95) ^
+                   lfsr_digest16_bitwise(msg, 15, 0x8810, 0x5412) ^
+                   lfsr_digest16_bitwise(msg, 8, 0x8810, 0xabf9); }),
+        bench_run(ITERATIONS, [](unsigned i) {
+            const uint8_t *msg = &frames[i % NUM_FRAMES][2];
+            return Lfsr16Table<0x8810, 0xba95>::digest(msg, 23) ^
+                   Lfsr16Table<0x8810, 0x5412>::digest(msg, 15) ^
+                   Lfsr16Table<0x8810, 0xabf9>::digest(msg, 8); }));
+
+    bench_print("crc16 leakage (5 bytes)",
+        bench_run(ITERATIONS, [](unsigned i) { return crc16_bitwise(&frames[i % NUM_FRAMES][2], 5, 0x1021, 0x0000); }),
+        bench_run(ITERATIONS, [](unsigned i) { return Crc16Table<0x1021>::crc(&frames[i % NUM_FRAMES][2], 5, 0x0000); }));
+
+    return 0;
+}
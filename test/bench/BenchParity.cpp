@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BenchParity.cpp
+//
+// Host micro-benchmark: byte-wise vs. word-wide 5-in-1 parity and checksum check
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include "BenchUtils.h"
+#include "DigestUtils.h"
+
+#define ITERATIONS 200000
+#define NUM_FRAMES 64
+
+static uint8_t valid[NUM_FRAMES][26];
+static uint8_t noise[NUM_FRAMES][26];
+
+// Previous implementation of the 5-in-1 checks (0: o.k., 1: parity error, 2: checksum error)
+static uint32_t check_bytewise(const uint8_t *msg)
+{
+    for (unsigned col = 0; col < 13; ++col)
+    {
+        if ((msg[col] ^ msg[col + 13]) != 0xff)
+            return 1;
+    }
+    uint8_t bitsSet = 0;
+    for (uint8_t p = 14; p < 26; p++)
+    {
+        uint8_t currentByte = msg[p];
+        while (currentByte)
+        {
+            bitsSet += (currentByte & 1);
+            currentByte >>= 1;
+        }
+    }
+    return (bitsSet != msg[13]) ? 2 : 0;
+}
+
+static uint32_t check_wordwide(const uint8_t *msg)
+{
+    if (inverted_copy_check(msg, 13) >= 0)
+        return 1;
+    return (count_bits(&msg[14], 12) != msg[13]) ? 2 : 0;
+}
+
+int main(void)
+{
+    srand(1);
+    for (int f = 0; f < NUM_FRAMES; f++)
+    {
+        for (int i = 0; i < 26; i++)
+            noise[f][i] = rand() & 0xFF;
+
+        for (int i = 14; i < 26; i++)
+            valid[f][i] = rand() & 0xFF;
+        valid[f][13] = count_bits(&valid[f][14], 12);
+        for (int i = 0; i < 13; i++)
+            valid[f][i] = ~valid[f][i + 13];
+    }
+
+    bench_header("5-in-1 parity / checksum");
+
+    bench_print("valid frames",
+        bench_run(ITERATIONS, [](unsigned i) { return check_bytewise(valid[i % NUM_FRAMES]); }),
+        bench_run(ITERATIONS, [](unsigned i) { return check_wordwide(valid[i % NUM_FRAMES]); }));
+
+    // Other sensors' frames fail in the first column with high probability
+    bench_print("invalid frames (random data)",
+        bench_run(ITERATIONS, [](unsigned i) { return check_bytewise(noise[i % NUM_FRAMES]); }),
+        bench_run(ITERATIONS, [](unsigned i) { return check_wordwide(noise[i % NUM_FRAMES]); }));
+
+    return 0;
+}
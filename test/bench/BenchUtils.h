@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BenchUtils.h
+//
+// Helpers for host micro-benchmarks (cycle counter, result output)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BENCHUTILS_H
+#define _BENCHUTILS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+static inline uint64_t bench_now(void)
+{
+    return __rdtsc();
+}
+#else
+#define BENCH_UNIT "ns"
+static inline uint64_t bench_now(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+#endif
+
+// Prevents the compiler from optimizing away benchmarked results
+static volatile uint32_t bench_sink;
+
+/**
+ * Run 'func' 'iterations' times and return the average time per call
+ * (best of 5 runs to reduce noise)
+ */
+template <typename F>
+static double bench_run(unsigned iterations, F func)
+{
+    double best = 1e30;
+    for (int run = 0; run < 5; run++)
+    {
+        uint64_t t0 = bench_now();
+        for (unsigned i = 0; i < iterations; i++)
+        {
+            bench_sink = bench_sink + func(i);
+        }
+        uint64_t t1 = bench_now();
+        double avg = (double)(t1 - t0) / iterations;
+        if (avg < best)
+            best = avg;
+    }
+    return best;
+}
+
+static void bench_print(const char *name, double before, double after)
+{
+    printf("%-36s %10.1f %10.1f  %6.2fx  [" BENCH_UNIT "/frame]\n", name, before, after, before / after);
+}
+
+static void bench_header(const char *title)
+{
+    printf("\n%s\n", title);
+    printf("%-36s %10s %10s  %7s\n", "", "before", "after", "speedup");
+}
+
+#endif // _BENCHUTILS_H
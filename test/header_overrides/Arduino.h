@@ -1,7 +1,30 @@
 #include "WStringMock.h"
+#include <stdint.h>
+#include <stdio.h>
 
 #define RTC_DATA_ATTR static
+#define HEX 16
+
+#define ARDUHAL_LOG_LEVEL_NONE      0
+#define ARDUHAL_LOG_LEVEL_ERROR     1
+#define ARDUHAL_LOG_LEVEL_WARN      2
+#define ARDUHAL_LOG_LEVEL_INFO      3
+#define ARDUHAL_LOG_LEVEL_DEBUG     4
+#define ARDUHAL_LOG_LEVEL_VERBOSE   5
+
 #define log_e(...) { printf(__VA_ARGS__); printf("\n"); }
 #define log_w(...) { printf(__VA_ARGS__); printf("\n"); }
+// CORE_DEBUG_LEVEL can be set by a test makefile to reduce the output
+#if !defined(CORE_DEBUG_LEVEL) || (CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG)
+#define log_i(...) { printf(__VA_ARGS__); printf("\n"); }
 #define log_d(...) { printf(__VA_ARGS__); printf("\n"); }
 #define log_v(...) { printf(__VA_ARGS__); printf("\n"); }
+#else
+#define log_i(...) {}
+#define log_d(...) {}
+#define log_v(...) {}
+#endif
+
+// Simulated time (see mocks/ArduinoMock.cpp)
+uint32_t millis(void);
+void delay(uint32_t ms);
@@ -0,0 +1,131 @@
+#ifndef ARDUINOJSON_MOCK_H
+#define ARDUINOJSON_MOCK_H
+
+#include <Arduino.h>
+#include <vector>
+
+// Minimal replacement of ArduinoJson for host tests
+// Supports only documents with a single array of strings, i.e. {"<key>":["<string>",...]}
+// as used by WeatherSensorConfig.cpp
+
+class JsonString
+{
+public:
+    JsonString(const String &s) : value(s) {}
+
+    template <typename T>
+    T as(void) const
+    {
+        return value;
+    }
+
+private:
+    String value;
+};
+
+class JsonArray
+{
+public:
+    JsonArray(std::vector<String> *items = nullptr) : items(items) {}
+
+    size_t size(void) const
+    {
+        return items ? items->size() : 0;
+    }
+
+    JsonString operator[](size_t i) const
+    {
+        return JsonString((*items)[i]);
+    }
+
+    bool add(const String &s)
+    {
+        items->push_back(s);
+        return true;
+    }
+
+private:
+    std::vector<String> *items;
+};
+
+class JsonDocument;
+
+class JsonMember
+{
+public:
+    JsonMember(JsonDocument &doc, const char *key) : doc(doc), key(key) {}
+
+    template <typename T>
+    T to(void);
+
+    template <typename T>
+    T as(void);
+
+private:
+    JsonDocument &doc;
+    const char *key;
+};
+
+class JsonDocument
+{
+public:
+    JsonMember operator[](const char *k)
+    {
+        return JsonMember(*this, k);
+    }
+
+    String key;
+    std::vector<String> items;
+};
+
+template <typename T>
+T JsonMember::to(void)
+{
+    doc.key = key;
+    doc.items.clear();
+    return JsonArray(&doc.items);
+}
+
+template <typename T>
+T JsonMember::as(void)
+{
+    return (doc.key == key) ? JsonArray(&doc.items) : JsonArray();
+}
+
+inline size_t serializeJson(const JsonDocument &doc, String &json)
+{
+    json = "{\"" + doc.key + "\":[";
+    for (size_t i = 0; i < doc.items.size(); i++)
+    {
+        if (i)
+            json += ",";
+        json += "\"" + doc.items[i] + "\"";
+    }
+    json += "]}";
+    return json.length();
+}
+
+inline int deserializeJson(JsonDocument &doc, const String &json)
+{
+    const char *p = json.c_str();
+    doc.key = "";
+    doc.items.clear();
+
+    // Key
+    const char *q = strchr(p, '"');
+    const char *r = q ? strchr(q + 1, '"') : nullptr;
+    if (!r)
+        return 1;
+    doc.key = json.substring(q - p + 1, r - p);
+
+    // Array of strings
+    const char *s = strchr(r, '[');
+    while (s && (q = strchr(s, '"')) && (r = strchr(q + 1, '"')))
+    {
+        doc.items.push_back(json.substring(q - p + 1, r - p));
+        s = r + 1;
+    }
+    return 0;
+}
+
+#endif // ARDUINOJSON_MOCK_H
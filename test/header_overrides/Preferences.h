@@ -1 +1,203 @@
-// Intentionally left empty
\ No newline at end of file
+#ifndef PREFERENCES_MOCK_H
+#define PREFERENCES_MOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// In-memory replacement of Preferences (ESP32 NVS) for host tests
+// Static storage (no heap - memory leak detection), shared by all namespaces
+class Preferences
+{
+public:
+    bool begin(const char *name, bool readOnly = false, const char *partition_label = NULL)
+    {
+        return true;
+    }
+
+    void end(void) {}
+
+    bool clear(void)
+    {
+        memset(entries(), 0, sizeof(Entry) * MAX_ENTRIES);
+        return true;
+    }
+
+    bool remove(const char *key)
+    {
+        Entry *e = find(key);
+        if (e)
+            e->used = false;
+        return e != NULL;
+    }
+
+    bool isKey(const char *key)
+    {
+        return find(key) != NULL;
+    }
+
+    size_t getBytesLength(const char *key)
+    {
+        Entry *e = find(key);
+        return e ? e->len : 0;
+    }
+
+    size_t getBytes(const char *key, void *buf, size_t maxLen)
+    {
+        Entry *e = find(key);
+        if (!e || (e->len > maxLen))
+            return 0;
+        memcpy(buf, e->data, e->len);
+        return e->len;
+    }
+
+    size_t putBytes(const char *key, const void *value, size_t len)
+    {
+        Entry *e = find(key);
+        if (!e)
+            e = alloc(key);
+        if (!e || (len > MAX_SIZE))
+            return 0;
+        memcpy(e->data, value, len);
+        e->len = len;
+        writes()++;
+        return len;
+    }
+
+    // Number of successful put*() calls (flash writes)
+    static size_t &writes(void)
+    {
+        static size_t count = 0;
+        return count;
+    }
+
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0)
+    {
+        uint8_t value = defaultValue;
+        getBytes(key, &value, sizeof(value));
+        return value;
+    }
+
+    size_t putUChar(const char *key, uint8_t value)
+    {
+        return putBytes(key, &value, sizeof(value));
+    }
+
+    bool getBool(const char *key, bool defaultValue = false)
+    {
+        return getUChar(key, defaultValue ? 1 : 0) != 0;
+    }
+
+    size_t putBool(const char *key, bool value)
+    {
+        return putUChar(key, value ? 1 : 0);
+    }
+
+    int16_t getShort(const char *key, int16_t defaultValue = 0)
+    {
+        int16_t value = defaultValue;
+        getBytes(key, &value, sizeof(value));
+        return value;
+    }
+
+    size_t putShort(const char *key, int16_t value)
+    {
+        return putBytes(key, &value, sizeof(value));
+    }
+
+    uint16_t getUShort(const char *key, uint16_t defaultValue = 0)
+    {
+        uint16_t value = defaultValue;
+        getBytes(key, &value, sizeof(value));
+        return value;
+    }
+
+    size_t putUShort(const char *key, uint16_t value)
+    {
+        return putBytes(key, &value, sizeof(value));
+    }
+
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0)
+    {
+        uint32_t value = defaultValue;
+        getBytes(key, &value, sizeof(value));
+        return value;
+    }
+
+    size_t putUInt(const char *key, uint32_t value)
+    {
+        return putBytes(key, &value, sizeof(value));
+    }
+
+    uint64_t getULong64(const char *key, uint64_t defaultValue = 0)
+    {
+        uint64_t value = defaultValue;
+        getBytes(key, &value, sizeof(value));
+        return value;
+    }
+
+    size_t putULong64(const char *key, uint64_t value)
+    {
+        return putBytes(key, &value, sizeof(value));
+    }
+
+    float getFloat(const char *key, float defaultValue = 0)
+    {
+        float value = defaultValue;
+        getBytes(key, &value, sizeof(value));
+        return value;
+    }
+
+    size_t putFloat(const char *key, float value)
+    {
+        return putBytes(key, &value, sizeof(value));
+    }
+
+private:
+    static const size_t MAX_ENTRIES = 64;
+    static const size_t MAX_SIZE = 1024;
+
+    struct Entry
+    {
+        bool used;
+        char key[16];
+        size_t len;
+        uint8_t data[MAX_SIZE];
+    };
+
+    static Entry *entries(void)
+    {
+        static Entry storage[MAX_ENTRIES];
+        return storage;
+    }
+
+    static Entry *find(const char *key)
+    {
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            Entry &e = entries()[i];
+            if (e.used && (strncmp(e.key, key, sizeof(e.key)) == 0))
+                return &e;
+        }
+        return NULL;
+    }
+
+    static Entry *alloc(const char *key)
+    {
+        for (size_t i = 0; i < MAX_ENTRIES; i++)
+        {
+            Entry &e = entries()[i];
+            if (!e.used)
+            {
+                e.used = true;
+                strncpy(e.key, key, sizeof(e.key) - 1);
+                e.key[sizeof(e.key) - 1] = '\0';
+                e.len = 0;
+                return &e;
+            }
+        }
+        return NULL;
+    }
+};
+
+#endif // PREFERENCES_MOCK_H
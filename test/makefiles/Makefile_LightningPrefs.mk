@@ -0,0 +1,16 @@
+COMPONENT_NAME=LightningPrefs
+
+# Lightning with data stored in Preferences (mock)
+SRC_FILES = \
+  $(PROJECT_SRC_DIR)/RollingCounter.cpp \
+  $(PROJECT_SRC_DIR)/Lightning.cpp
+
+MOCKS_SRC_DIRS = \
+  $(UNITTEST_ROOT)/mocks
+
+TEST_SRC_FILES = \
+  $(UNITTEST_SRC_DIR)/TestLightningPrefs.cpp
+
+CPPUTEST_CPPFLAGS += -DLIGHTNING_USE_PREFS
+
+include $(CPPUTEST_MAKFILE_INFRA)
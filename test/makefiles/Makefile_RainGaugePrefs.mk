@@ -0,0 +1,16 @@
+COMPONENT_NAME=RainGaugePrefs
+
+# RainGauge with data stored in Preferences (mock)
+SRC_FILES = \
+  $(PROJECT_SRC_DIR)/RollingCounter.cpp \
+  $(PROJECT_SRC_DIR)/RainGauge.cpp
+
+MOCKS_SRC_DIRS = \
+  $(UNITTEST_ROOT)/mocks
+
+TEST_SRC_FILES = \
+  $(UNITTEST_SRC_DIR)/TestRainGaugePrefs.cpp
+
+CPPUTEST_CPPFLAGS += -DRAINGAUGE_USE_PREFS
+
+include $(CPPUTEST_MAKFILE_INFRA)
@@ -13,7 +13,17 @@ TEST_SRC_FILES = \
   $(UNITTEST_SRC_DIR)/TestRainGauge.cpp \
   $(UNITTEST_SRC_DIR)/TestLightning.cpp \
   $(UNITTEST_SRC_DIR)/TestWeatherUtils.cpp \
-  $(UNITTEST_SRC_DIR)/TestRollingCounter.cpp
+  $(UNITTEST_SRC_DIR)/TestRollingCounter.cpp \
+  $(UNITTEST_SRC_DIR)/TestDigestUtils.cpp \
+  $(UNITTEST_SRC_DIR)/TestBcdUtils.cpp \
+  $(UNITTEST_SRC_DIR)/TestFrameCombiner.cpp \
+  $(UNITTEST_SRC_DIR)/TestFrameCache.cpp \
+  $(UNITTEST_SRC_DIR)/TestSensorIdIndex.cpp \
+  $(UNITTEST_SRC_DIR)/TestFrameRing.cpp \
+  $(UNITTEST_SRC_DIR)/TestArrivalPredictor.cpp \
+  $(UNITTEST_SRC_DIR)/TestFreqTracker.cpp \
+  $(UNITTEST_SRC_DIR)/TestLinkMonitor.cpp \
+  $(UNITTEST_SRC_DIR)/TestNoiseMonitor.cpp
   #$(UNITTEST_SRC_DIR)/TestRainGaugeReal.cpp  
   
 include $(CPPUTEST_MAKFILE_INFRA)
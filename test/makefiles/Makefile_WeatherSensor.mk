@@ -0,0 +1,27 @@
+COMPONENT_NAME=WeatherSensor
+
+# Receive/decode pipeline with ReplayRadio instead of RadioLib
+SRC_FILES = \
+  $(PROJECT_SRC_DIR)/WeatherSensor.cpp \
+  $(PROJECT_SRC_DIR)/WeatherSensorDecoders.cpp \
+  $(PROJECT_SRC_DIR)/WeatherSensorConfig.cpp
+
+MOCKS_SRC_DIRS = \
+  $(UNITTEST_ROOT)/mocks
+
+TEST_SRC_FILES = \
+  $(UNITTEST_SRC_DIR)/TestWeatherSensorReplay.cpp \
+  $(UNITTEST_SRC_DIR)/TestWeatherSensorDecoders.cpp
+
+# Log output: errors and warnings only
+CPPUTEST_CPPFLAGS += -DCORE_DEBUG_LEVEL=2
+
+# Options disabled by default in WeatherSensorCfg.h
+CPPUTEST_CPPFLAGS += -DDIGEST_CORRECTION_BITS=1
+CPPUTEST_CPPFLAGS += -DPARITY_REPAIR_COLUMNS=4
+CPPUTEST_CPPFLAGS += -DPREDICT_SENSORS=8
+CPPUTEST_CPPFLAGS += -DFREQ_TRACK_THRESHOLD_KHZ=10
+CPPUTEST_CPPFLAGS += -DLINK_STATS_SENSORS=8
+CPPUTEST_CPPFLAGS += -DNOISE_SAMPLE_INTERVAL_MS=250
+
+include $(CPPUTEST_MAKFILE_INFRA)
@@ -0,0 +1,30 @@
+COMPONENT_NAME=WeatherSensorReduced
+
+# Receive/decode pipeline with optional features disabled
+# (checks that other combinations of the options in WeatherSensorCfg.h are compiled)
+SRC_FILES = \
+  $(PROJECT_SRC_DIR)/WeatherSensor.cpp \
+  $(PROJECT_SRC_DIR)/WeatherSensorDecoders.cpp \
+  $(PROJECT_SRC_DIR)/WeatherSensorConfig.cpp
+
+MOCKS_SRC_DIRS = \
+  $(UNITTEST_ROOT)/mocks
+
+TEST_SRC_FILES = \
+  $(UNITTEST_SRC_DIR)/TestWeatherSensorReplay.cpp \
+  $(UNITTEST_SRC_DIR)/TestWeatherSensorDecoders.cpp
+
+# Log output: errors and warnings only
+CPPUTEST_CPPFLAGS += -DCORE_DEBUG_LEVEL=2
+
+# Disabled options
+CPPUTEST_CPPFLAGS += -DDIGEST_CORRECTION_BITS=0
+CPPUTEST_CPPFLAGS += -DPARITY_REPAIR_COLUMNS=0
+CPPUTEST_CPPFLAGS += -DCOMBINE_WINDOW_MS=0
+CPPUTEST_CPPFLAGS += -DDUP_CACHE_WINDOW_MS=0
+CPPUTEST_CPPFLAGS += -DPREDICT_SENSORS=0
+CPPUTEST_CPPFLAGS += -DLINK_STATS_SENSORS=0
+CPPUTEST_CPPFLAGS += -DNOISE_SAMPLE_INTERVAL_MS=0
+CPPUTEST_CPPFLAGS += -DFREQ_TRACK_THRESHOLD_KHZ=0
+
+include $(CPPUTEST_MAKFILE_INFRA)
@@ -0,0 +1,29 @@
+#include "ArduinoMock.h"
+
+static uint32_t now_ms = 0;
+static void (*delay_hook)(void) = nullptr;
+
+uint32_t millis(void)
+{
+    return now_ms;
+}
+
+void delay(uint32_t ms)
+{
+    while (ms--)
+    {
+        now_ms++;
+        if (delay_hook)
+            delay_hook();
+    }
+}
+
+void setMillis(uint32_t ms)
+{
+    now_ms = ms;
+}
+
+void setDelayHook(void (*hook)(void))
+{
+    delay_hook = hook;
+}
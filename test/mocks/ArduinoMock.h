@@ -0,0 +1,14 @@
+#ifndef ARDUINO_MOCK_H
+#define ARDUINO_MOCK_H
+
+#include <stdint.h>
+
+// Simulated time for host tests: millis() only advances in delay() or by setMillis()
+
+// Set current time in ms
+void setMillis(uint32_t ms);
+
+// Set function called after each ms of simulated time in delay() (nullptr: none)
+void setDelayHook(void (*hook)(void));
+
+#endif // ARDUINO_MOCK_H
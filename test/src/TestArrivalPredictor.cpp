@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestArrivalPredictor.cpp
+//
+// CppUTest unit tests for ArrivalPredictor (prediction of sensor transmissions)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include "ArrivalPredictor.h"
+
+#define INTERVAL 12000
+#define GUARD 300
+
+TEST_GROUP(TestArrivalPredictor) {
+  ArrivalPredictor<4> pred;
+
+  void setup() {
+    srand(42);
+    pred.clear();
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Interval and jitter are learned from periodic receptions
+ */
+TEST(TestArrivalPredictor, Test_Learn) {
+  uint32_t t = 5000;
+  for (int i = 0; i < 50; i++) {
+    pred.update(0x1234, 1, t + (rand() % 201) - 100);
+    t += INTERVAL;
+  }
+  const ArrivalPredictor<4>::Entry *e = pred.find(0x1234);
+  CHECK(e != nullptr);
+  CHECK_EQUAL(50, e->count);
+  CHECK_EQUAL(0, e->missed);
+  CHECK_EQUAL(1, e->type);
+  CHECK(e->interval > INTERVAL - 50 && e->interval < INTERVAL + 50);
+  CHECK(e->jitter > 0 && e->jitter < 200);
+
+  uint32_t next, guard;
+  CHECK(ArrivalPredictor<4>::predict(*e, e->last + 1000, GUARD, next, guard));
+  CHECK_EQUAL(e->last + e->interval, next);
+  CHECK(guard >= GUARD + 3 * e->jitter);
+}
+
+/*
+ * No prediction from a single reception
+ */
+TEST(TestArrivalPredictor, Test_Unknown) {
+  uint32_t next, guard;
+  CHECK(pred.find(1) == nullptr);
+  pred.update(1, 0, 1000);
+  const ArrivalPredictor<4>::Entry *e = pred.find(1);
+  CHECK(e != nullptr);
+  CHECK_EQUAL(0, e->interval);
+  CHECK_FALSE(ArrivalPredictor<4>::predict(*e, 2000, GUARD, next, guard));
+}
+
+/*
+ * Repetitions within the burst window belong to the same transmission
+ */
+TEST(TestArrivalPredictor, Test_Burst) {
+  pred.update(1, 0, 1000);
+  pred.update(1, 0, 1500);
+  pred.update(1, 0, 2900);
+  const ArrivalPredictor<4>::Entry *e = pred.find(1);
+  CHECK_EQUAL(1, e->count);
+  CHECK_EQUAL(1000, e->last);
+
+  pred.update(1, 0, 1000 + INTERVAL);
+  pred.update(1, 0, 1200 + INTERVAL);
+  CHECK_EQUAL(2, e->count);
+  CHECK_EQUAL(INTERVAL, e->interval);
+}
+
+/*
+ * Missed transmissions are recognized as multiples of the interval
+ */
+TEST(TestArrivalPredictor, Test_Missed) {
+  pred.update(1, 0, 0);
+  pred.update(1, 0, INTERVAL);
+  pred.update(1, 0, 4 * INTERVAL + 60);
+  const ArrivalPredictor<4>::Entry *e = pred.find(1);
+  CHECK_EQUAL(2, e->missed);
+  CHECK_EQUAL(INTERVAL + 5, e->interval);
+  CHECK_EQUAL(5, e->jitter);
+}
+
+/*
+ * An interval estimate which is a multiple of the real interval is corrected
+ */
+TEST(TestArrivalPredictor, Test_Multiple) {
+  pred.update(1, 0, 0);
+  pred.update(1, 0, 3 * INTERVAL);
+  const ArrivalPredictor<4>::Entry *e = pred.find(1);
+  CHECK_EQUAL(3 * INTERVAL, e->interval);
+  pred.update(1, 0, 4 * INTERVAL);
+  CHECK_EQUAL(INTERVAL, e->interval);
+}
+
+/*
+ * No interval is derived from receptions too far apart
+ */
+TEST(TestArrivalPredictor, Test_MaxInterval) {
+  uint32_t next, guard;
+  pred.update(1, 0, 0, 2000, 120000);
+  pred.update(1, 0, 300000, 2000, 120000);
+  const ArrivalPredictor<4>::Entry *e = pred.find(1);
+  CHECK_EQUAL(2, e->count);
+  CHECK_EQUAL(300000, e->last);
+  CHECK_FALSE(ArrivalPredictor<4>::predict(*e, 301000, GUARD, next, guard));
+
+  // Learned interval is kept across long gaps (e.g. deep sleep)
+  pred.update(1, 0, 300000 + INTERVAL, 2000, 120000);
+  pred.update(1, 0, 300000 + 26 * INTERVAL, 2000, 120000);
+  CHECK_EQUAL(INTERVAL, e->interval);
+  CHECK_EQUAL(24, e->missed);
+  CHECK(ArrivalPredictor<4>::predict(*e, 300000 + 30 * INTERVAL + 500, GUARD, next, guard));
+  CHECK_EQUAL(300000 + 31 * INTERVAL, next);
+}
+
+/*
+ * Window of an overdue transmission stays open until its guard time has expired
+ */
+TEST(TestArrivalPredictor, Test_Window) {
+  uint32_t next, guard;
+  pred.update(1, 0, 0);
+  pred.update(1, 0, INTERVAL);
+  const ArrivalPredictor<4>::Entry *e = pred.find(1);
+
+  CHECK(ArrivalPredictor<4>::predict(*e, 2 * INTERVAL - 1000, GUARD, next, guard));
+  CHECK_EQUAL(2 * INTERVAL, next);
+  CHECK_EQUAL(GUARD, guard);
+
+  CHECK(ArrivalPredictor<4>::predict(*e, 2 * INTERVAL + GUARD - 1, GUARD, next, guard));
+  CHECK_EQUAL(2 * INTERVAL, next);
+
+  CHECK(ArrivalPredictor<4>::predict(*e, 2 * INTERVAL + GUARD + 1, GUARD, next, guard));
+  CHECK_EQUAL(3 * INTERVAL, next);
+
+  // Guard time is limited to half an interval
+  CHECK(ArrivalPredictor<4>::predict(*e, 2 * INTERVAL, 10 * INTERVAL, next, guard));
+  CHECK_EQUAL(INTERVAL / 2, guard);
+}
+
+/*
+ * Sensor is forgotten after consecutive receive windows without reception
+ */
+TEST(TestArrivalPredictor, Test_Miss) {
+  pred.update(1, 0, 0);
+  pred.update(1, 0, INTERVAL);
+  pred.miss(1);
+  CHECK_EQUAL(1, pred.find(1)->lost);
+  pred.update(1, 0, 3 * INTERVAL);
+  CHECK_EQUAL(0, pred.find(1)->lost);
+
+  pred.miss(1);
+  pred.miss(2);
+  CHECK(pred.find(1) != nullptr);
+  pred.miss(1);
+  CHECK(pred.find(1) == nullptr);
+}
+
+/*
+ * Least recently seen sensor is replaced
+ */
+TEST(TestArrivalPredictor, Test_Replace) {
+  for (uint32_t id = 1; id <= 4; id++)
+    pred.update(id, 0, id * 10000);
+  pred.update(1, 0, 50000);
+  pred.update(5, 0, 60000);
+  CHECK(pred.find(1) != nullptr);
+  CHECK(pred.find(2) == nullptr);
+  CHECK(pred.find(3) != nullptr);
+  CHECK(pred.find(5) != nullptr);
+  CHECK_EQUAL(1, pred.find(5)->count);
+
+  pred.clear();
+  for (unsigned i = 0; i < pred.size(); i++)
+    CHECK_EQUAL(0, pred[i].count);
+}
+
+/*
+ * Time wrap-around
+ */
+TEST(TestArrivalPredictor, Test_Wrap) {
+  uint32_t next, guard;
+  uint32_t t = 0xFFFFFFFFUL - INTERVAL - 500;
+  pred.update(1, 0, t);
+  pred.update(1, 0, t + INTERVAL);
+  pred.update(1, 0, t + 2 * INTERVAL);
+  const ArrivalPredictor<4>::Entry *e = pred.find(1);
+  CHECK_EQUAL(INTERVAL, e->interval);
+  CHECK(ArrivalPredictor<4>::predict(*e, t + 2 * INTERVAL + 100, GUARD, next, guard));
+  CHECK_EQUAL((uint32_t)(t + 3 * INTERVAL), next);
+}
@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestBcdUtils.cpp
+//
+// CppUTest unit tests for BcdUtils (packed BCD field extraction, validation and conversion)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include "BcdUtils.h"
+
+// Bresser 6-in-1 message (from rtl_433 bresser_6in1.c)
+static const uint8_t msg6in1[] = {0x5e, 0xaa, 0x18, 0x80, 0x02, 0xc3, 0x18, 0xfa, 0x8f, 0xfb,
+                                  0x27, 0x68, 0x11, 0x84, 0x81, 0xff, 0xf0, 0x72, 0x00};
+
+// Bresser 7-in-1 message (from rtl_433 bresser_7in1.c; whitened)
+static const uint8_t msg7in1[] = {0x63, 0x1d, 0x05, 0xc0, 0x9e, 0x9a, 0x18, 0xab, 0xaa, 0xba,
+                                  0xaa, 0xaa, 0xaa, 0xaa, 0x8a, 0xda, 0xcb, 0xac, 0xff, 0x9c,
+                                  0xaf, 0xca, 0xaa, 0xaa, 0xaa, 0x00};
+
+// Functions are usable in constant expressions
+static constexpr uint8_t constMsg[] = {0x12, 0x34, 0x56};
+static_assert(bcd_field(constMsg, 1, 4) == 0x2345, "bcd_field");
+static_assert(bcd_value(0x12345678) == 12345678, "bcd_value");
+static_assert(bcd_valid(0x99999999) && !bcd_valid(0x0000A000), "bcd_valid");
+static_assert(bcd_decode(constMsg, 0, 6) == 123456, "bcd_decode");
+
+// Reference: extract nibble at index pos
+static uint8_t nibble(const uint8_t *msg, unsigned pos, uint8_t xorMask)
+{
+    uint8_t b = msg[pos >> 1] ^ xorMask;
+    return (pos & 1) ? (b & 0x0f) : (b >> 4);
+}
+
+TEST_GROUP(TestBcdUtils) {
+  void setup() {
+    srand(42);
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test field extraction
+ */
+TEST(TestBcdUtils, Test_Field) {
+  const uint8_t msg[] = {0x12, 0x34, 0x56, 0x78, 0x9A};
+
+  UNSIGNED_LONGS_EQUAL(0x1, bcd_field(msg, 0, 1));
+  UNSIGNED_LONGS_EQUAL(0x2, bcd_field(msg, 1, 1));
+  UNSIGNED_LONGS_EQUAL(0x123, bcd_field(msg, 0, 3));
+  UNSIGNED_LONGS_EQUAL(0x234, bcd_field(msg, 1, 3));
+  UNSIGNED_LONGS_EQUAL(0x2345678, bcd_field(msg, 1, 7));
+  UNSIGNED_LONGS_EQUAL(0x3456789A, bcd_field(msg, 2, 8));
+
+  // Inverted and whitened data
+  UNSIGNED_LONGS_EQUAL(0xEDC, bcd_field(msg, 0, 3, 0xff));
+  UNSIGNED_LONGS_EQUAL(0xB89E, bcd_field(msg, 0, 4, 0xaa));
+}
+
+/*
+ * Test validity check
+ */
+TEST(TestBcdUtils, Test_Valid) {
+  CHECK_TRUE(bcd_valid(0));
+  CHECK_TRUE(bcd_valid(0x99999999));
+  CHECK_TRUE(bcd_valid(0x12345678));
+  CHECK_TRUE(bcd_valid(0x89898989));
+
+  // Each invalid digit value at each position
+  for (unsigned pos = 0; pos < 8; pos++) {
+    for (uint32_t d = 10; d < 16; d++) {
+      CHECK_FALSE(bcd_valid((0x99999999 & ~(0xFUL << (4 * pos))) | (d << (4 * pos))));
+      CHECK_FALSE(bcd_valid(d << (4 * pos)));
+    }
+  }
+}
+
+/*
+ * Test conversion against nibble-wise reference (including invalid digits)
+ */
+TEST(TestBcdUtils, Test_Value_Random) {
+  uint8_t msg[8];
+
+  for (int i = 0; i < 10000; i++) {
+    for (unsigned j = 0; j < sizeof(msg); j++)
+      msg[j] = rand() & 0xff;
+    uint8_t xorMask = (i % 3 == 0) ? 0x00 : (i % 3 == 1) ? 0xff : 0xaa;
+    unsigned pos = rand() % 8;
+    unsigned digits = 1 + rand() % (8 - (pos & 1));
+
+    uint32_t ref = 0;
+    bool refValid = true;
+    for (unsigned k = 0; k < digits; k++) {
+      uint8_t n = nibble(msg, pos + k, xorMask);
+      ref = ref * 10 + n;
+      refValid = refValid && (n <= 9);
+    }
+    UNSIGNED_LONGS_EQUAL(ref, bcd_decode(msg, pos, digits, xorMask));
+    CHECK_EQUAL(refValid, bcd_valid(bcd_field(msg, pos, digits, xorMask)));
+  }
+}
+
+/*
+ * Test 6-in-1 fields (inverted BCD)
+ */
+TEST(TestBcdUtils, Test_6in1) {
+  // Temperature 11.8 degC, humidity 81%
+  UNSIGNED_LONGS_EQUAL(118, bcd_decode(msg6in1, 24, 3));
+  UNSIGNED_LONGS_EQUAL(81, bcd_value(msg6in1[14]));
+
+  // Wind gust 5.7 m/s, wind speed 4.0 m/s, wind direction 276 deg
+  uint32_t wind_bcd = bcd_field(msg6in1, 14, 6, 0xff);
+  CHECK_TRUE(bcd_valid(wind_bcd));
+  UNSIGNED_LONGS_EQUAL(57, bcd_value(wind_bcd >> 12));
+  UNSIGNED_LONGS_EQUAL(40, bcd_value(wind_bcd & 0xff) * 10 + ((wind_bcd >> 8) & 0x0f));
+  UNSIGNED_LONGS_EQUAL(276, bcd_decode(msg6in1, 20, 3));
+
+  // UV index 0.0
+  CHECK_TRUE(bcd_valid(bcd_field(msg6in1, 30, 3, 0xff)));
+  UNSIGNED_LONGS_EQUAL(0, bcd_decode(msg6in1, 30, 3, 0xff));
+}
+
+/*
+ * Test 7-in-1 fields (whitened BCD)
+ */
+TEST(TestBcdUtils, Test_7in1) {
+  // Temperature 20.7 degC, humidity 61%, wind direction 343 deg
+  UNSIGNED_LONGS_EQUAL(207, bcd_decode(msg7in1, 28, 3, 0xaa));
+  UNSIGNED_LONGS_EQUAL(61, bcd_decode(msg7in1, 32, 2, 0xaa));
+  UNSIGNED_LONGS_EQUAL(343, bcd_decode(msg7in1, 8, 3, 0xaa));
+
+  // Temperature/humidity with flags nibble masked
+  CHECK_TRUE(bcd_valid(bcd_field(msg7in1, 28, 6, 0xaa) & 0xFFF0FF));
+
+  // Same message, not de-whitened
+  CHECK_FALSE(bcd_valid(bcd_field(msg7in1, 28, 6) & 0xFFF0FF));
+}
@@ -0,0 +1,428 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestDigestUtils.cpp
+//
+// CppUTest unit tests for DigestUtils (LFSR-16 digest, CRC16, parity, bit count,
+// error correction)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include <string.h>
+#include "DigestUtils.h"
+
+// Bresser 6-in-1 messages (from rtl_433 bresser_6in1.c; digest in bytes 0..1)
+static const uint8_t msg6in1_a[] = {0x5e, 0xaa, 0x18, 0x80, 0x02, 0xc3, 0x18, 0xfa, 0x8f, 0xfb,
+                                    0x27, 0x68, 0x11, 0x84, 0x81, 0xff, 0xf0, 0x72, 0x00};
+static const uint8_t msg6in1_b[] = {0xcc, 0x93, 0x18, 0x80, 0x02, 0xc3, 0x18, 0xff, 0xff, 0xff,
+                                    0x33, 0x68, 0x03, 0x04, 0x95, 0xff, 0xf0, 0x67, 0x3f};
+
+// Bresser 7-in-1 message (from rtl_433 bresser_7in1.c; whitened)
+static const uint8_t msg7in1[] = {0x63, 0x1d, 0x05, 0xc0, 0x9e, 0x9a, 0x18, 0xab, 0xaa, 0xba,
+                                  0xaa, 0xaa, 0xaa, 0xaa, 0x8a, 0xda, 0xcb, 0xac, 0xff, 0x9c,
+                                  0xaf, 0xca, 0xaa, 0xaa, 0xaa, 0x00};
+
+// Bresser Lightning message (LIGHTNING_TEST_DATA in WeatherSensorDecoders.cpp; whitened)
+static const uint8_t msgLightning[] = {0x73, 0x69, 0xB5, 0x08, 0xAA, 0xA2, 0x90, 0xAA, 0xAA, 0xAA};
+
+// Bresser Water Leakage message (CRC16/XMODEM in bytes 0..1)
+static const uint8_t msgLeakage[] = {0xC7, 0x70, 0x35, 0x97, 0x04, 0x08, 0x57, 0x70};
+
+static void dewhiten(const uint8_t *msg, uint8_t *msgw, unsigned size)
+{
+    for (unsigned i = 0; i < size; i++)
+        msgw[i] = msg[i] ^ 0xaa;
+}
+
+TEST_GROUP(TestLfsrDigest16) {
+  void setup() {
+    srand(42);
+  }
+
+  void teardown() {
+  }
+};
+
+// Build a valid 5-in-1 message from random payload (bytes 14..25)
+static void make5in1(uint8_t *msg)
+{
+    for (unsigned i = 14; i < 26; i++)
+        msg[i] = rand() & 0xFF;
+    unsigned bits = 0;
+    for (unsigned i = 14; i < 26; i++)
+        for (uint8_t b = msg[i]; b; b >>= 1)
+            bits += b & 1;
+    msg[13] = bits;
+    for (unsigned i = 0; i < 13; i++)
+        msg[i] = ~msg[i + 13];
+}
+
+TEST_GROUP(TestSyndrome) {
+  void setup() {
+    srand(42);
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TestParity) {
+  void setup() {
+    srand(42);
+  }
+
+  void teardown() {
+  }
+};
+
+TEST_GROUP(TestCrc16) {
+  void setup() {
+    srand(4711);
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Test 6-in-1 digest (generator 0x8810, key 0x5412)
+ */
+TEST(TestLfsrDigest16, Test_Digest_6in1) {
+  uint16_t exp_a = (msg6in1_a[0] << 8) | msg6in1_a[1];
+  uint16_t exp_b = (msg6in1_b[0] << 8) | msg6in1_b[1];
+
+  CHECK_EQUAL(exp_a, lfsr_digest16_bitwise(&msg6in1_a[2], 15, 0x8810, 0x5412));
+  CHECK_EQUAL(exp_a, (Lfsr16Table<0x8810, 0x5412>::digest(&msg6in1_a[2], 15)));
+  CHECK_EQUAL(exp_b, (Lfsr16Table<0x8810, 0x5412>::digest(&msg6in1_b[2], 15)));
+}
+
+/*
+ * Test 7-in-1 digest (generator 0x8810, key 0xba95, final xor 0x6df1)
+ */
+TEST(TestLfsrDigest16, Test_Digest_7in1) {
+  uint8_t msgw[sizeof(msg7in1)];
+  dewhiten(msg7in1, msgw, sizeof(msg7in1));
+  uint16_t chk = (msgw[0] << 8) | msgw[1];
+
+  CHECK_EQUAL(0x6df1, chk ^ lfsr_digest16_bitwise(&msgw[2], 23, 0x8810, 0xba95));
+  CHECK_EQUAL(0x6df1, chk ^ (Lfsr16Table<0x8810, 0xba95>::digest(&msgw[2], 23)));
+}
+
+/*
+ * Test lightning digest (generator 0x8810, key 0xabf9, final xor 0x899e)
+ */
+TEST(TestLfsrDigest16, Test_Digest_Lightning) {
+  uint8_t msgw[sizeof(msgLightning)];
+  dewhiten(msgLightning, msgw, sizeof(msgLightning));
+  uint16_t chk = (msgw[0] << 8) | msgw[1];
+
+  CHECK_EQUAL(0x899e, chk ^ lfsr_digest16_bitwise(&msgw[2], 8, 0x8810, 0xabf9));
+  CHECK_EQUAL(0x899e, chk ^ (Lfsr16Table<0x8810, 0xabf9>::digest(&msgw[2], 8)));
+}
+
+/*
+ * Table driven digest must match bit-by-bit reference for random data of all message lengths
+ */
+TEST(TestLfsrDigest16, Test_Digest_Random) {
+  uint8_t buf[27];
+
+  for (int n = 0; n < 200; n++) {
+    for (unsigned i = 0; i < sizeof(buf); i++)
+      buf[i] = rand() & 0xFF;
+
+    for (unsigned len = 0; len <= sizeof(buf); len++) {
+      CHECK_EQUAL(lfsr_digest16_bitwise(buf, len, 0x8810, 0x5412), (Lfsr16Table<0x8810, 0x5412>::digest(buf, len)));
+      CHECK_EQUAL(lfsr_digest16_bitwise(buf, len, 0x8810, 0xba95), (Lfsr16Table<0x8810, 0xba95>::digest(buf, len)));
+      CHECK_EQUAL(lfsr_digest16_bitwise(buf, len, 0x8810, 0xabf9), (Lfsr16Table<0x8810, 0xabf9>::digest(buf, len)));
+    }
+  }
+}
+
+/*
+ * Test CRC16/XMODEM of water leakage sensor message
+ */
+TEST(TestCrc16, Test_Crc16_Leakage) {
+  uint16_t exp = (msgLeakage[0] << 8) | msgLeakage[1];
+
+  CHECK_EQUAL(exp, crc16_bitwise(&msgLeakage[2], 5, 0x1021, 0x0000));
+  CHECK_EQUAL(exp, Crc16Table<0x1021>::crc(&msgLeakage[2], 5, 0x0000));
+}
+
+/*
+ * Table driven CRC16 must match bit-by-bit reference for random data and initial values
+ */
+TEST(TestCrc16, Test_Crc16_Random) {
+  uint8_t buf[27];
+
+  for (int n = 0; n < 200; n++) {
+    for (unsigned i = 0; i < sizeof(buf); i++)
+      buf[i] = rand() & 0xFF;
+    uint16_t init = rand() & 0xFFFF;
+
+    for (unsigned len = 0; len <= sizeof(buf); len++) {
+      CHECK_EQUAL(crc16_bitwise(buf, len, 0x1021, init), Crc16Table<0x1021>::crc(buf, len, init));
+      CHECK_EQUAL(crc16_bitwise(buf, len, 0x8005, init), Crc16Table<0x8005>::crc(buf, len, init));
+    }
+  }
+}
+
+/*
+ * Inverted copy check must accept valid 5-in-1 messages and locate the first error
+ */
+TEST(TestParity, Test_InvertedCopy) {
+  uint8_t msg[26];
+
+  for (int n = 0; n < 100; n++) {
+    make5in1(msg);
+    CHECK_EQUAL(-1, inverted_copy_check(msg, 13));
+
+    for (unsigned col = 0; col < 13; col++) {
+      uint8_t bad[26];
+      memcpy(bad, msg, sizeof(bad));
+      bad[col + ((n & 1) ? 13 : 0)] ^= 1 << (rand() % 8);
+      CHECK_EQUAL((int)col, inverted_copy_check(bad, 13));
+    }
+  }
+
+  // Two errors - first one is reported
+  make5in1(msg);
+  msg[11] ^= 0x80;
+  msg[5] ^= 0x01;
+  CHECK_EQUAL(5, inverted_copy_check(msg, 13));
+}
+
+static bool checksum5in1(const uint8_t *msg)
+{
+    return count_bits(&msg[14], 12) == msg[13];
+}
+
+/*
+ * Count of mismatching columns, limited to limit + 1
+ */
+TEST(TestParity, Test_InvertedCopyErrors) {
+  uint8_t msg[26];
+
+  make5in1(msg);
+  CHECK_EQUAL(0, inverted_copy_errors(msg, 13, 4));
+  msg[0] ^= 0x01;
+  msg[20] ^= 0x10;
+  CHECK_EQUAL(2, inverted_copy_errors(msg, 13, 4));
+  msg[1] ^= 0x01;
+  msg[2] ^= 0x01;
+  msg[3] ^= 0x01;
+  msg[4] ^= 0x01;
+  CHECK_EQUAL(5, inverted_copy_errors(msg, 13, 4));
+  CHECK_EQUAL(3, inverted_copy_errors(msg, 13, 2));
+}
+
+/*
+ * A single bit error in any column is repaired
+ */
+TEST(TestParity, Test_Repair_SingleBit) {
+  uint8_t ref[26];
+  uint8_t msg[26];
+
+  for (int n = 0; n < 20; n++) {
+    make5in1(ref);
+    CHECK_EQUAL(0, repair_inverted_copy(msg, 0, 4, checksum5in1));
+
+    for (unsigned pos = 0; pos < 26 * 8; pos++) {
+      memcpy(msg, ref, sizeof(msg));
+      msg[pos / 8] ^= 0x80 >> (pos % 8);
+      CHECK_EQUAL(1, repair_inverted_copy(msg, 13, 4, checksum5in1));
+      MEMCMP_EQUAL(ref, msg, sizeof(msg));
+    }
+  }
+}
+
+/*
+ * Bit errors in several columns are either repaired or the message remains unchanged
+ */
+TEST(TestParity, Test_Repair_MultipleColumns) {
+  uint8_t ref[26];
+  uint8_t msg[26];
+  uint8_t bad[26];
+  unsigned repaired = 0;
+
+  for (int n = 0; n < 2000; n++) {
+    make5in1(ref);
+    memcpy(msg, ref, sizeof(msg));
+    unsigned errors = 2 + rand() % 4;
+    for (unsigned e = 0; e < errors; e++) {
+      unsigned pos = rand() % (26 * 8);
+      msg[pos / 8] ^= 0x80 >> (pos % 8);
+    }
+    memcpy(bad, msg, sizeof(bad));
+
+    unsigned cols = inverted_copy_errors(msg, 13, 13);
+    int res = repair_inverted_copy(msg, 13, 4, checksum5in1);
+    if (cols > 4) {
+      CHECK_EQUAL(-1, res);
+    }
+    if (res <= 0) {
+      // Not repairable or no mismatching column at all
+      MEMCMP_EQUAL(bad, msg, sizeof(msg));
+    } else {
+      CHECK_EQUAL(-1, inverted_copy_check(msg, 13));
+      CHECK_TRUE(checksum5in1(msg));
+      if (memcmp(ref, msg, sizeof(msg)) == 0)
+        repaired++;
+    }
+  }
+  // Checksum only - many combinations of errors are ambiguous
+  CHECK(repaired > 400);
+}
+
+/*
+ * Bit count must match bit-by-bit reference
+ */
+TEST(TestParity, Test_CountBits) {
+  uint8_t buf[27];
+
+  for (int n = 0; n < 200; n++) {
+    for (unsigned i = 0; i < sizeof(buf); i++)
+      buf[i] = rand() & 0xFF;
+
+    for (unsigned len = 0; len <= sizeof(buf); len++) {
+      unsigned exp = 0;
+      for (unsigned i = 0; i < len; i++)
+        for (uint8_t b = buf[i]; b; b >>= 1)
+          exp += b & 1;
+      UNSIGNED_LONGS_EQUAL(exp, count_bits(buf, len));
+    }
+  }
+  UNSIGNED_LONGS_EQUAL(32, popcount32(0xFFFFFFFFUL));
+  UNSIGNED_LONGS_EQUAL(0, popcount32(0));
+
+  // 5-in-1 checksum
+  uint8_t msg[26];
+  make5in1(msg);
+  UNSIGNED_LONGS_EQUAL(msg[13], count_bits(&msg[14], 12));
+}
+
+typedef Lfsr16Syndrome<0x8810, 0x5412, 15> Syndrome6in1;
+typedef Lfsr16Syndrome<0x8810, 0xba95, 23> Syndrome7in1;
+
+static uint16_t syndrome6in1(const uint8_t *msg)
+{
+    return ((msg[0] << 8) | msg[1]) ^ Lfsr16Table<0x8810, 0x5412>::digest(&msg[2], 15);
+}
+
+static uint16_t syndrome7in1(const uint8_t *msgw)
+{
+    return ((msgw[0] << 8) | msgw[1]) ^ Lfsr16Table<0x8810, 0xba95>::digest(&msgw[2], 23) ^ 0x6df1;
+}
+
+/*
+ * Every single bit error in a 6-in-1 message (check word and data) is corrected
+ */
+TEST(TestSyndrome, Test_6in1_SingleBit) {
+  uint8_t msg[sizeof(msg6in1_a)];
+
+  CHECK_EQUAL(0, syndrome6in1(msg6in1_a));
+  CHECK_EQUAL(0, Syndrome6in1::correct(msg, 0, 1));
+
+  for (unsigned pos = 0; pos < Syndrome6in1::BITS; pos++) {
+    memcpy(msg, msg6in1_a, sizeof(msg));
+    msg[pos / 8] ^= 0x80 >> (pos % 8);
+    CHECK_EQUAL(1, Syndrome6in1::correct(msg, syndrome6in1(msg), 1));
+    MEMCMP_EQUAL(msg6in1_a, msg, sizeof(msg));
+  }
+}
+
+/*
+ * Single bit errors in a 7-in-1 message are corrected unless the syndrome is ambiguous
+ */
+TEST(TestSyndrome, Test_7in1_SingleBit) {
+  uint8_t ref[sizeof(msg7in1)];
+  uint8_t msgw[sizeof(msg7in1)];
+  unsigned corrected = 0;
+
+  dewhiten(msg7in1, ref, sizeof(ref));
+  CHECK_EQUAL(0, syndrome7in1(ref));
+
+  for (unsigned pos = 0; pos < Syndrome7in1::BITS; pos++) {
+    memcpy(msgw, ref, sizeof(msgw));
+    msgw[pos / 8] ^= 0x80 >> (pos % 8);
+    unsigned bits = Syndrome7in1::correct(msgw, syndrome7in1(msgw), 1);
+    if (bits == 1) {
+      MEMCMP_EQUAL(ref, msgw, sizeof(msgw));
+      corrected++;
+    } else {
+      CHECK_EQUAL(0, bits);
+    }
+  }
+  // 200 bit positions, 8 pairs of positions share their syndrome
+  CHECK_EQUAL(184, corrected);
+}
+
+/*
+ * Two bit errors are either corrected properly, not corrected at all or
+ * mistaken for a single bit error (to be caught by checksum/plausibility check)
+ */
+TEST(TestSyndrome, Test_6in1_TwoBits) {
+  uint8_t msg[sizeof(msg6in1_a)];
+  unsigned corrected = 0;
+
+  for (int n = 0; n < 2000; n++) {
+    unsigned a = rand() % Syndrome6in1::BITS;
+    unsigned b = rand() % Syndrome6in1::BITS;
+    if (a == b)
+      continue;
+    memcpy(msg, msg6in1_a, sizeof(msg));
+    msg[a / 8] ^= 0x80 >> (a % 8);
+    msg[b / 8] ^= 0x80 >> (b % 8);
+
+    // Not corrected if limited to single bit
+    uint8_t tmp[sizeof(msg)];
+    memcpy(tmp, msg, sizeof(tmp));
+    unsigned bits1 = Syndrome6in1::correct(tmp, syndrome6in1(tmp), 1);
+    CHECK(bits1 == 0 || memcmp(tmp, msg6in1_a, sizeof(tmp)) != 0);
+
+    unsigned bits = Syndrome6in1::correct(msg, syndrome6in1(msg), 2);
+    if (bits == 2) {
+      MEMCMP_EQUAL(msg6in1_a, msg, sizeof(msg));
+      corrected++;
+    }
+    // Digest always matches after correction
+    if (bits > 0) {
+      CHECK_EQUAL(0, syndrome6in1(msg));
+    }
+  }
+  CHECK(corrected > 1000);
+}
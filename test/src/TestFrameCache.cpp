@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestFrameCache.cpp
+//
+// CppUTest unit tests for FrameCache (suppression of duplicate frames)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include "FrameCache.h"
+
+#define FRAME_SIZE 26
+
+TEST_GROUP(TestFrameCache) {
+  FrameCache<4> *cache;
+  uint8_t frame[FRAME_SIZE];
+
+  void setup() {
+    srand(42);
+    cache = new FrameCache<4>(1000);
+    for (int i = 0; i < FRAME_SIZE; i++)
+      frame[i] = rand() & 0xFF;
+  }
+
+  void teardown() {
+    delete cache;
+  }
+};
+
+/*
+ * Test FNV-1a hash against known values
+ */
+TEST(TestFrameCache, Test_Hash) {
+  CHECK_EQUAL(0x811C9DC5UL, FrameCache<>::hash(frame, 0));
+  CHECK_EQUAL(0xE40C292CUL, FrameCache<>::hash((const uint8_t *)"a", 1));
+  CHECK_EQUAL(0xBF9CF968UL, FrameCache<>::hash((const uint8_t *)"foobar", 6));
+}
+
+/*
+ * Single bit changes always change the hash
+ */
+TEST(TestFrameCache, Test_Hash_SingleBit) {
+  uint32_t h = FrameCache<>::hash(frame, FRAME_SIZE);
+  for (int bit = 0; bit < FRAME_SIZE * 8; bit++) {
+    frame[bit / 8] ^= 0x80 >> (bit % 8);
+    CHECK(h != FrameCache<>::hash(frame, FRAME_SIZE));
+    frame[bit / 8] ^= 0x80 >> (bit % 8);
+  }
+}
+
+/*
+ * Identical frame is found within the time window
+ */
+TEST(TestFrameCache, Test_Find) {
+  uint32_t id = 0;
+  uint32_t h = FrameCache<>::hash(frame, FRAME_SIZE);
+
+  CHECK_EQUAL(-1, cache->find(h, 1000, id));
+  cache->insert(h, 1000, 3, 0x12345678);
+  CHECK_EQUAL(3, cache->find(h, 1500, id));
+  CHECK_EQUAL(0x12345678, id);
+  CHECK_EQUAL(3, cache->find(h, 2000, id));
+  CHECK_EQUAL(-1, cache->find(h + 1, 1500, id));
+
+  // Expired
+  CHECK_EQUAL(-1, cache->find(h, 2001, id));
+
+  // millis() wrap-around
+  cache->insert(h, 0xFFFFFF00UL, 1, 0x1111);
+  CHECK_EQUAL(1, cache->find(h, 0x00000100UL, id));
+
+  cache->clear();
+  CHECK_EQUAL(-1, cache->find(h, 0x00000100UL, id));
+}
+
+/*
+ * Oldest entry is replaced if the cache is full
+ */
+TEST(TestFrameCache, Test_Replace) {
+  uint32_t id;
+
+  for (uint32_t i = 0; i < 4; i++)
+    cache->insert(100 + i, 1000 + i, i, i);
+  for (uint32_t i = 0; i < 4; i++)
+    CHECK_EQUAL((int)i, cache->find(100 + i, 1010, id));
+
+  cache->insert(200, 1020, 9, 9);
+  CHECK_EQUAL(-1, cache->find(100, 1030, id));
+  CHECK_EQUAL(9, cache->find(200, 1030, id));
+  CHECK_EQUAL(1, cache->find(101, 1030, id));
+
+  cache->insert(201, 1040, 8, 8);
+  CHECK_EQUAL(-1, cache->find(101, 1050, id));
+  CHECK_EQUAL(2, cache->find(102, 1050, id));
+}
@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestFrameCombiner.cpp
+//
+// CppUTest unit tests for FrameCombiner (combining of repeated transmissions)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include "FrameCombiner.h"
+
+#define FRAME_SIZE 26
+
+// Bresser 7-in-1 message (from rtl_433 bresser_7in1.c; de-whitened)
+static const uint8_t msg7in1[FRAME_SIZE] = {0xc9, 0xb7, 0xaf, 0x6a, 0x34, 0x30, 0xb2, 0x01, 0x00, 0x10,
+                                            0x00, 0x00, 0x00, 0x00, 0x20, 0x70, 0x61, 0x06, 0x55, 0x36,
+                                            0x05, 0x60, 0x00, 0x00, 0x00, 0xaa};
+
+static bool digestOk(const uint8_t *msg)
+{
+    uint16_t chk = (msg[0] << 8) | msg[1];
+    return (chk ^ Lfsr16Table<0x8810, 0xba95>::digest(&msg[2], 23)) == 0x6df1;
+}
+
+static void flipBit(uint8_t *msg, unsigned bit)
+{
+    msg[bit / 8] ^= 0x80 >> (bit % 8);
+}
+
+TEST_GROUP(TestFrameCombiner) {
+  FrameCombiner<FRAME_SIZE> *combiner;
+  uint8_t out[FRAME_SIZE];
+  uint8_t diff[FRAME_SIZE];
+
+  void setup() {
+    srand(42);
+    combiner = new FrameCombiner<FRAME_SIZE>(500, 24);
+  }
+
+  void teardown() {
+    delete combiner;
+  }
+};
+
+/*
+ * Test reference message
+ */
+TEST(TestFrameCombiner, Test_Reference) {
+  CHECK_TRUE(digestOk(msg7in1));
+}
+
+/*
+ * Three copies with different bit errors - majority vote restores the message
+ */
+TEST(TestFrameCombiner, Test_Majority) {
+  for (int n = 0; n < 100; n++) {
+    uint8_t copy[3][FRAME_SIZE];
+    combiner->clear();
+    for (int c = 0; c < 3; c++) {
+      memcpy(copy[c], msg7in1, FRAME_SIZE);
+      // Error positions are distinct in each copy
+      for (int e = 0; e < 3; e++)
+        flipBit(copy[c], (rand() % 69) * 3 + c);
+    }
+    CHECK_EQUAL(0, combiner->add(copy[0], FRAME_SIZE, -90.0, 1000, out, diff));
+    CHECK_EQUAL(2, combiner->add(copy[1], FRAME_SIZE, -90.0, 1100, out, diff));
+    CHECK_EQUAL(3, combiner->add(copy[2], FRAME_SIZE, -90.0, 1200, out, diff));
+    MEMCMP_EQUAL(msg7in1, out, FRAME_SIZE);
+    CHECK_TRUE(digestOk(out));
+    for (int j = 0; j < FRAME_SIZE; j++)
+      CHECK_EQUAL(0, diff[j]);
+  }
+}
+
+/*
+ * Two copies - base frame is the one with higher RSSI, one candidate restores the message
+ */
+TEST(TestFrameCombiner, Test_TwoCopies) {
+  uint8_t a[FRAME_SIZE];
+  uint8_t b[FRAME_SIZE];
+  uint8_t cand[FRAME_SIZE];
+
+  memcpy(a, msg7in1, FRAME_SIZE);
+  memcpy(b, msg7in1, FRAME_SIZE);
+  flipBit(a, 20);
+  flipBit(a, 100);
+  flipBit(b, 150);
+
+  CHECK_EQUAL(0, combiner->add(a, FRAME_SIZE, -95.0, 1000, out, diff));
+  CHECK_EQUAL(2, combiner->add(b, FRAME_SIZE, -80.0, 1100, out, diff));
+  MEMCMP_EQUAL(b, out, FRAME_SIZE);
+  CHECK_EQUAL(3, count_bits(diff, FRAME_SIZE));
+
+  // Exactly one of the 2^3 candidates has a valid digest
+  int found = 0;
+  for (uint32_t i = 0; i < 8; i++) {
+    FrameCombiner<FRAME_SIZE>::candidate(out, diff, FRAME_SIZE, i, cand);
+    if (digestOk(cand)) {
+      MEMCMP_EQUAL(msg7in1, cand, FRAME_SIZE);
+      found++;
+    }
+  }
+  CHECK_EQUAL(1, found);
+
+  // Lower RSSI of new frame - stored frame is base
+  combiner->clear();
+  combiner->add(b, FRAME_SIZE, -80.0, 1000, out, diff);
+  CHECK_EQUAL(2, combiner->add(a, FRAME_SIZE, -95.0, 1100, out, diff));
+  MEMCMP_EQUAL(b, out, FRAME_SIZE);
+}
+
+/*
+ * Candidate index maps to the set bits of diff, MSB of first byte first
+ */
+TEST(TestFrameCombiner, Test_Candidate) {
+  uint8_t base[3] = {0x00, 0x00, 0x00};
+  uint8_t mask[3] = {0x81, 0x00, 0x10};
+  uint8_t cand[3];
+
+  FrameCombiner<3>::candidate(base, mask, 3, 0, cand);
+  CHECK_EQUAL(0x00, cand[0]);
+  CHECK_EQUAL(0x00, cand[2]);
+  FrameCombiner<3>::candidate(base, mask, 3, 1, cand);
+  CHECK_EQUAL(0x80, cand[0]);
+  FrameCombiner<3>::candidate(base, mask, 3, 2, cand);
+  CHECK_EQUAL(0x01, cand[0]);
+  FrameCombiner<3>::candidate(base, mask, 3, 4, cand);
+  CHECK_EQUAL(0x00, cand[0]);
+  CHECK_EQUAL(0x10, cand[2]);
+  FrameCombiner<3>::candidate(base, mask, 3, 7, cand);
+  CHECK_EQUAL(0x81, cand[0]);
+  CHECK_EQUAL(0x00, cand[1]);
+  CHECK_EQUAL(0x10, cand[2]);
+}
+
+/*
+ * Frames older than the time window are not combined (incl. millis() wrap-around)
+ */
+TEST(TestFrameCombiner, Test_Window) {
+  uint8_t a[FRAME_SIZE];
+  memcpy(a, msg7in1, FRAME_SIZE);
+  flipBit(a, 33);
+
+  CHECK_EQUAL(0, combiner->add(msg7in1, FRAME_SIZE, -90.0, 1000, out, diff));
+  CHECK_EQUAL(0, combiner->add(a, FRAME_SIZE, -90.0, 1501, out, diff));
+  CHECK_EQUAL(2, combiner->add(msg7in1, FRAME_SIZE, -90.0, 2001, out, diff));
+
+  combiner->clear();
+  CHECK_EQUAL(0, combiner->add(msg7in1, FRAME_SIZE, -90.0, 0xFFFFFF00UL, out, diff));
+  CHECK_EQUAL(2, combiner->add(a, FRAME_SIZE, -90.0, 0x00000010UL, out, diff));
+}
+
+/*
+ * Frames with too many differing bits or different length are not combined
+ */
+TEST(TestFrameCombiner, Test_Mismatch) {
+  uint8_t a[FRAME_SIZE];
+  memcpy(a, msg7in1, FRAME_SIZE);
+  for (unsigned bit = 0; bit < 25; bit++)
+    flipBit(a, bit * 8);
+
+  CHECK_EQUAL(0, combiner->add(msg7in1, FRAME_SIZE, -90.0, 1000, out, diff));
+  CHECK_EQUAL(0, combiner->add(a, FRAME_SIZE, -90.0, 1100, out, diff));
+  CHECK_EQUAL(0, combiner->add(msg7in1, FRAME_SIZE - 1, -90.0, 1200, out, diff));
+  CHECK_EQUAL(0, combiner->add(msg7in1, FRAME_SIZE + 1, -90.0, 1300, out, diff));
+
+  // Identical copy of the first frame
+  CHECK_EQUAL(2, combiner->add(msg7in1, FRAME_SIZE, -90.0, 1400, out, diff));
+}
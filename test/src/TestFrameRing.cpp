@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestFrameRing.cpp
+//
+// CppUTest unit tests for FrameRing (receive ring buffer)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include "FrameRing.h"
+
+#define FRAME_SIZE 27
+
+TEST_GROUP(TestFrameRing) {
+  FrameRing<4, FRAME_SIZE> *ring;
+  uint8_t frame[FRAME_SIZE];
+
+  void setup() {
+    ring = new FrameRing<4, FRAME_SIZE>;
+    for (int i = 0; i < FRAME_SIZE; i++)
+      frame[i] = i;
+  }
+
+  void teardown() {
+    delete ring;
+  }
+};
+
+/*
+ * Empty buffer
+ */
+TEST(TestFrameRing, Test_Empty) {
+  POINTERS_EQUAL(nullptr, ring->peek());
+  CHECK_EQUAL(0, ring->available());
+  CHECK_EQUAL(0, ring->overruns());
+}
+
+/*
+ * Frames are returned in order with RSSI and time
+ */
+TEST(TestFrameRing, Test_Fifo) {
+  for (int n = 0; n < 3; n++) {
+    frame[0] = n;
+    CHECK_TRUE(ring->push(frame, -80.0 - n, 1000 + n));
+  }
+  CHECK_EQUAL(3, ring->available());
+
+  for (int n = 0; n < 3; n++) {
+    const FrameRing<4, FRAME_SIZE>::Entry *e = ring->peek();
+    CHECK(e != nullptr);
+    CHECK_EQUAL(n, e->data[0]);
+    CHECK_EQUAL(26, e->data[26]);
+    DOUBLES_EQUAL(-80.0 - n, e->rssi, 0.001);
+    CHECK_EQUAL(1000 + n, e->time);
+    ring->pop();
+  }
+  POINTERS_EQUAL(nullptr, ring->peek());
+}
+
+/*
+ * Full buffer - new frames are dropped and counted
+ */
+TEST(TestFrameRing, Test_Overrun) {
+  for (int n = 0; n < 4; n++) {
+    frame[0] = n;
+    CHECK_TRUE(ring->push(frame, -80.0, n));
+  }
+  CHECK_FALSE(ring->push(frame, -80.0, 4));
+  CHECK_FALSE(ring->push(frame, -80.0, 5));
+  POINTERS_EQUAL(nullptr, ring->reserve());
+  CHECK_EQUAL(3, ring->overruns());
+  CHECK_EQUAL(4, ring->available());
+
+  // Oldest frame is still available
+  CHECK_EQUAL(0, ring->peek()->data[0]);
+  ring->pop();
+  CHECK_TRUE(ring->push(frame, -80.0, 6));
+  CHECK_EQUAL(4, ring->available());
+}
+
+/*
+ * Index wrap-around over many cycles; reserve()/commit() interface
+ */
+TEST(TestFrameRing, Test_WrapAround) {
+  for (unsigned n = 0; n < 1000; n++) {
+    FrameRing<4, FRAME_SIZE>::Entry *e = ring->reserve();
+    CHECK(e != nullptr);
+    e->data[0] = n & 0xFF;
+    e->time = n;
+    ring->commit();
+    if (n & 1) {
+      CHECK_EQUAL(2, ring->available());
+      CHECK_EQUAL(n - 1, ring->peek()->time);
+      ring->pop();
+      CHECK_EQUAL(n, ring->peek()->time);
+      CHECK_EQUAL(n & 0xFF, ring->peek()->data[0]);
+      ring->pop();
+    }
+  }
+  CHECK_EQUAL(0, ring->overruns());
+}
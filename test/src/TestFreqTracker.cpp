@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestFreqTracker.cpp
+//
+// CppUTest unit tests for FreqTracker (automatic frequency correction)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include "FreqTracker.h"
+
+#define THRESHOLD 10
+#define STEP 5
+#define MAX 50
+
+TEST_GROUP(TestFreqTracker) {
+  FreqTracker *trk;
+
+  void setup() {
+    srand(42);
+    trk = new FreqTracker(THRESHOLD, STEP, MAX, 4);
+  }
+
+  void teardown() {
+    delete trk;
+  }
+};
+
+/*
+ * Initial correction (e.g. from Preferences) is limited
+ */
+TEST(TestFreqTracker, Test_Begin) {
+  DOUBLES_EQUAL(0, trk->getCorrection(), 0.001);
+  trk->begin(12.5);
+  DOUBLES_EQUAL(12.5, trk->getCorrection(), 0.001);
+  trk->begin(-80);
+  DOUBLES_EQUAL(-MAX, trk->getCorrection(), 0.001);
+  CHECK_EQUAL(0, trk->getRetunes());
+}
+
+/*
+ * Errors below the threshold and noise do not cause a retune
+ */
+TEST(TestFreqTracker, Test_Noise) {
+  for (int i = 0; i < 200; i++) {
+    CHECK_FALSE(trk->update(7));
+  }
+  for (int i = 0; i < 200; i++) {
+    CHECK_FALSE(trk->update((rand() % 31) - 15));
+  }
+  DOUBLES_EQUAL(0, trk->getCorrection(), 0.001);
+}
+
+/*
+ * No retune before min_samples frames have been received
+ */
+TEST(TestFreqTracker, Test_MinSamples) {
+  CHECK_FALSE(trk->update(30));
+  CHECK_FALSE(trk->update(30));
+  CHECK_FALSE(trk->update(30));
+  CHECK(trk->update(30));
+  DOUBLES_EQUAL(STEP, trk->getCorrection(), 0.001);
+
+  // Average is reduced by the applied step
+  DOUBLES_EQUAL(30 - STEP, trk->getError(), 0.001);
+  CHECK_FALSE(trk->update(25));
+  CHECK_FALSE(trk->update(25));
+  CHECK_FALSE(trk->update(25));
+  CHECK(trk->update(25));
+  DOUBLES_EQUAL(2 * STEP, trk->getCorrection(), 0.001);
+}
+
+/*
+ * Correction converges in steps to the offset of the transmitter
+ */
+TEST(TestFreqTracker, Test_Converge) {
+  const float offset = -23.0;
+  for (int i = 0; i < 100; i++) {
+    float error = offset - trk->getCorrection() + ((rand() % 5) - 2);
+    trk->update(error);
+  }
+  CHECK(trk->getCorrection() < offset + THRESHOLD);
+  CHECK(trk->getCorrection() > offset - THRESHOLD);
+  CHECK(trk->getRetunes() >= 2 && trk->getRetunes() <= 5);
+
+  // Stable after convergence
+  unsigned retunes = trk->getRetunes();
+  for (int i = 0; i < 100; i++) {
+    trk->update(offset - trk->getCorrection());
+  }
+  CHECK_EQUAL(retunes, trk->getRetunes());
+}
+
+/*
+ * Correction is limited to +/-max
+ */
+TEST(TestFreqTracker, Test_Limit) {
+  for (int i = 0; i < 200; i++) {
+    trk->update(100 - trk->getCorrection());
+  }
+  DOUBLES_EQUAL(MAX, trk->getCorrection(), 0.001);
+  CHECK_FALSE(trk->update(100 - MAX));
+}
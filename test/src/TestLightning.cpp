@@ -36,6 +36,8 @@
 // 20230722 Created
 // 20250324 Updated tests for modified pastHour() return values
 // 20250325 Added tests for changing update rate (effective history buffer size) at run-time
+// 20261016 Added test for pastMinutes()
+//          Added test of lastCycle() after ignored update
 //
 // ToDo: 
 // -
@@ -186,6 +188,11 @@ TEST(TG_LightningBasic, Test_LightningBasic) {
   CHECK_EQUAL(30, res_distance);
   CHECK_EQUAL(5, lightning.lastCycle());
 
+  // Time set back - ignored
+  setTime("2023-07-22 8:00", tm, ts);
+  lightning.update(ts, 57, 30);
+  CHECK_EQUAL(-1, lightning.lastCycle());
+
   // Step 4
   // Reset
   setTime("2023-07-22 8:24", tm, ts);
@@ -946,3 +953,47 @@ TEST(TG_LightningUpdateRate, Test_LightningSetUpdateRateInvalid) {
   // rate=6: valid (default)
   CHECK_TRUE(lightning.setUpdateRate(6));
 }
+
+TEST_GROUP(TG_LightningPastMinutes) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Number of events during past minutes
+ */
+TEST(TG_LightningPastMinutes, Test_LightningPastMinutes) {
+  Lightning lightning;
+  lightning.reset();
+
+  tm        tm;
+  time_t    ts;
+  bool      val;
+  int       nbins;
+
+  printf("< LightningPastMinutes >\n");
+
+  // 2 events every 6 minutes from 18:06 to 18:30
+  for (int i = 0; i <= 5; i++) {
+    char buf[20];
+    snprintf(buf, sizeof(buf), "2023-07-22 18:%02d", i * 6);
+    setTime(buf, tm, ts);
+    lightning.update(ts, 100 + i * 2, 7);
+  }
+
+  CHECK_EQUAL(2, lightning.pastMinutes(6, &val, &nbins));
+  CHECK_TRUE(val);
+  CHECK_EQUAL(1, nbins);
+  CHECK_EQUAL(4, lightning.pastMinutes(12));
+  CHECK_EQUAL(10, lightning.pastMinutes(30, &val, &nbins));
+  CHECK_EQUAL(5, nbins);
+  CHECK_EQUAL(lightning.pastHour(), lightning.pastMinutes(60, &val, &nbins));
+  CHECK_FALSE(val);
+  CHECK_EQUAL(6, nbins);
+
+  CHECK_EQUAL(0, lightning.pastMinutes(61, &val));
+  CHECK_FALSE(val);
+}
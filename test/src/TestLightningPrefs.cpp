@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestLightningPrefs.cpp
+//
+// CppUTest unit tests for Lightning with data stored in Preferences (LIGHTNING_USE_PREFS)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "CppUTest/TestHarness.h"
+
+#include "Lightning.h"
+
+static time_t ts(const char *time)
+{
+  struct tm tm = {0};
+  strptime(time, "%Y-%m-%d %H:%M", &tm);
+  tm.tm_isdst = -1;
+  return mktime(&tm);
+}
+
+TEST_GROUP(TestLightningPrefs) {
+  Preferences prefs;
+
+  void setup() {
+    prefs.clear();
+    Preferences::writes() = 0;
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Thunderstorm: update() for each message (every 20 s), data written every 5 minutes
+ */
+TEST(TestLightningPrefs, Test_Storm) {
+  time_t t0 = ts("2026-10-16 18:00");
+  time_t t = t0;
+  {
+    Lightning lightning;
+    lightning.setFlushInterval(300);
+    for (int i = 0; i < 30; i++) {
+      t = t0 + i * 20;
+      lightning.update(t, 100 + i * 3, 10 + i % 5);
+    }
+    // Writes at t0 and t0 + 300 s
+    CHECK_EQUAL(2, Preferences::writes());
+    lightning.flush();
+    CHECK_EQUAL(3, Preferences::writes());
+    lightning.flush();
+    CHECK_EQUAL(3, Preferences::writes());
+  }
+
+  // Restored
+  Lightning lightning;
+  time_t timestamp;
+  int events;
+  uint8_t distance;
+  CHECK_TRUE(lightning.lastEvent(timestamp, events, distance));
+  CHECK_EQUAL(t, timestamp);
+  CHECK_EQUAL(3, events);
+  CHECK_EQUAL(14, distance);
+  CHECK_EQUAL(3, Preferences::writes());
+
+  lightning.update(t + 20, 100 + 30 * 3, 7);
+  CHECK_EQUAL(3, lightning.lastCycle());
+  CHECK_EQUAL(90, lightning.pastHour());
+  CHECK_EQUAL(4, Preferences::writes());
+
+  // Time set back - update is ignored, but written without flush interval
+  lightning.update(t0 - 60, 100 + 31 * 3, 7);
+  CHECK_EQUAL(-1, lightning.lastCycle());
+  CHECK_EQUAL(5, Preferences::writes());
+}
+
+/*
+ * Reset is stored
+ */
+TEST(TestLightningPrefs, Test_Reset) {
+  {
+    Lightning lightning;
+    lightning.update(ts("2026-10-16 18:00"), 100, 10);
+    lightning.update(ts("2026-10-16 18:06"), 105, 8);
+  }
+  {
+    Lightning lightning;
+    time_t timestamp;
+    int events;
+    uint8_t distance;
+    CHECK_TRUE(lightning.lastEvent(timestamp, events, distance));
+    CHECK_EQUAL(5, events);
+    lightning.reset();
+  }
+  Lightning lightning;
+  time_t timestamp;
+  int events;
+  uint8_t distance;
+  CHECK_FALSE(lightning.lastEvent(timestamp, events, distance));
+}
+
+/*
+ * A corrupted record is discarded
+ */
+TEST(TestLightningPrefs, Test_Invalid) {
+  {
+    Lightning lightning;
+    lightning.update(ts("2026-10-16 18:00"), 100, 10);
+    lightning.update(ts("2026-10-16 18:06"), 105, 8);
+  }
+  uint8_t buf[PrefsBlob<nvLightning_t>::RECORD_SIZE];
+  CHECK_EQUAL(sizeof(buf), prefs.getBytes("nvLightning", buf, sizeof(buf)));
+  buf[sizeof(buf) - 1] ^= 0x80;
+  prefs.putBytes("nvLightning", buf, sizeof(buf));
+
+  Lightning lightning;
+  time_t timestamp;
+  int events;
+  uint8_t distance;
+  CHECK_FALSE(lightning.lastEvent(timestamp, events, distance));
+}
+
+/*
+ * Data stored in the previous layout (one key per member) is converted
+ */
+TEST(TestLightningPrefs, Test_Migration) {
+  time_t t = ts("2026-10-16 18:54");
+  time_t t_event = ts("2026-10-16 18:30");
+
+  prefs.putULong64("lastUpdate", t);
+  prefs.putBool("startupPrev", false);
+  prefs.putShort("preStCount", 120);
+  prefs.putUInt("accCount", 0);
+  prefs.putUShort("prevCount", 120);
+  prefs.putUShort("events", 4);
+  prefs.putUChar("distance", 12);
+  prefs.putULong64("timestamp", t_event);
+  prefs.putUChar("updateRate", 6);
+  for (int i = 0; i < LIGHTNING_HIST_SIZE; i++) {
+    char buf[7];
+    snprintf(buf, sizeof(buf), "hist%02d", i);
+    prefs.putShort(buf, i == 5 ? 4 : 0);
+  }
+
+  Lightning lightning;
+  time_t timestamp;
+  int events;
+  uint8_t distance;
+  CHECK_TRUE(lightning.lastEvent(timestamp, events, distance));
+  CHECK_EQUAL(t_event, timestamp);
+  CHECK_EQUAL(4, events);
+  CHECK_EQUAL(12, distance);
+
+  lightning.update(ts("2026-10-16 19:00"), 122, 9);
+  CHECK_EQUAL(2, lightning.lastCycle());
+  CHECK_EQUAL(6, lightning.pastHour());
+
+  // Old keys removed
+  CHECK_TRUE(prefs.isKey("nvLightning"));
+  CHECK_FALSE(prefs.isKey("prevCount"));
+  CHECK_FALSE(prefs.isKey("timestamp"));
+  CHECK_FALSE(prefs.isKey("hist09"));
+}
@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestLinkMonitor.cpp
+//
+// CppUTest unit tests for LinkMonitor (link quality statistics)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "CppUTest/TestHarness.h"
+#include "LinkMonitor.h"
+
+#define N 4
+
+TEST_GROUP(TestLinkMonitor) {
+  LinkMonitor<N> *mon;
+
+  void setup() {
+    mon = new LinkMonitor<N>(0.125f);
+  }
+
+  void teardown() {
+    delete mon;
+  }
+};
+
+/*
+ * First frame creates an entry
+ */
+TEST(TestLinkMonitor, Test_First) {
+  POINTERS_EQUAL(nullptr, mon->find(0x1234));
+  mon->update(0x1234, -70, 1000, 12000);
+  const LinkStats *e = mon->find(0x1234);
+  CHECK(e != nullptr);
+  DOUBLES_EQUAL(-70, e->rssi_mean, 0.001);
+  DOUBLES_EQUAL(0, e->rssi_var, 0.001);
+  CHECK_EQUAL(1, e->frames);
+  CHECK_EQUAL(1, e->received);
+  CHECK_EQUAL(1, e->expected);
+  DOUBLES_EQUAL(0, e->loss(), 0.001);
+}
+
+/*
+ * RSSI mean and variance
+ */
+TEST(TestLinkMonitor, Test_Rssi) {
+  for (uint32_t i = 0; i < 200; i++) {
+    mon->update(1, (i & 1) ? -68 : -72, 1000 + i * 12000, 12000);
+  }
+  const LinkStats *e = mon->find(1);
+  DOUBLES_EQUAL(-70, e->rssi_mean, 0.3);
+  DOUBLES_EQUAL(2, e->rssiStd(), 0.3);
+
+  // Constant RSSI - variance decays
+  for (uint32_t i = 200; i < 300; i++) {
+    mon->update(1, -60, 1000 + i * 12000, 12000);
+  }
+  DOUBLES_EQUAL(-60, e->rssi_mean, 0.01);
+  DOUBLES_EQUAL(0, e->rssiStd(), 0.1);
+}
+
+/*
+ * Repetitions within a burst count as one transmission
+ */
+TEST(TestLinkMonitor, Test_Burst) {
+  mon->update(1, -70, 1000, 12000);
+  mon->update(1, -70, 1100, 12000);
+  mon->update(1, -70, 13000, 12000);
+  mon->update(1, -70, 13100, 12000);
+  const LinkStats *e = mon->find(1);
+  CHECK_EQUAL(4, e->frames);
+  CHECK_EQUAL(2, e->received);
+  CHECK_EQUAL(2, e->expected);
+}
+
+/*
+ * Missed transmissions are derived from the interval
+ */
+TEST(TestLinkMonitor, Test_Loss) {
+  mon->update(1, -70, 1000, 12000);
+  mon->update(1, -70, 13050, 12000);
+  mon->update(1, -70, 48900, 12000);  // 2 missed
+  mon->update(1, -70, 61000, 12000);
+  const LinkStats *e = mon->find(1);
+  CHECK_EQUAL(4, e->received);
+  CHECK_EQUAL(6, e->expected);
+  DOUBLES_EQUAL(100.0 * 2 / 6, e->loss(), 0.01);
+
+  // Interval unknown
+  mon->update(1, -70, 200000, 0);
+  CHECK_EQUAL(5, e->received);
+  CHECK_EQUAL(7, e->expected);
+}
+
+/*
+ * Errors are only attributed to known sensors
+ */
+TEST(TestLinkMonitor, Test_Error) {
+  CHECK_FALSE(mon->error(1, LinkStats::ERR_DIGEST));
+  mon->update(1, -70, 1000);
+  CHECK(mon->error(1, LinkStats::ERR_PARITY));
+  CHECK(mon->error(1, LinkStats::ERR_CHECKSUM));
+  CHECK(mon->error(1, LinkStats::ERR_CHECKSUM));
+  CHECK(mon->error(1, LinkStats::ERR_DIGEST));
+  const LinkStats *e = mon->find(1);
+  CHECK_EQUAL(1, e->par_err);
+  CHECK_EQUAL(2, e->chk_err);
+  CHECK_EQUAL(1, e->dig_err);
+  CHECK_EQUAL(1, e->frames);
+}
+
+/*
+ * Least recently seen sensor is replaced
+ */
+TEST(TestLinkMonitor, Test_Replace) {
+  for (uint32_t id = 1; id <= N; id++) {
+    mon->update(id, -70, id * 1000);
+  }
+  mon->update(1, -70, 10000);
+  mon->update(10, -70, 11000);
+  CHECK(mon->find(1) != nullptr);
+  POINTERS_EQUAL(nullptr, mon->find(2));
+  CHECK(mon->find(10) != nullptr);
+  CHECK_EQUAL(N, mon->size());
+
+  mon->clear();
+  POINTERS_EQUAL(nullptr, mon->find(1));
+}
@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestNoiseMonitor.cpp
+//
+// CppUTest unit tests for NoiseMonitor (noise floor and interference)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include "NoiseMonitor.h"
+
+#define WINDOW 60000
+
+TEST_GROUP(TestNoiseMonitor) {
+  NoiseMonitor *mon;
+
+  void setup() {
+    srand(42);
+    mon = new NoiseMonitor(10, WINDOW, 50);
+  }
+
+  void teardown() {
+    delete mon;
+  }
+
+  // Samples every 250 ms, -110 dBm +/- 2 dB
+  uint32_t noise(uint32_t t, uint32_t duration, int level = -110) {
+    for (uint32_t end = t + duration; t < end; t += 250)
+      mon->sample(level + (rand() % 5) - 2, t);
+    return t;
+  }
+};
+
+/*
+ * No estimate before enough samples
+ */
+TEST(TestNoiseMonitor, Test_Empty) {
+  CHECK_EQUAL(-128, mon->getStats().floor_dbm);
+  noise(0, 2000);
+  CHECK_EQUAL(-128, mon->getStats().floor_dbm);
+  CHECK_EQUAL(7, mon->getStats().samples);
+  noise(2000, 3000);
+  CHECK(mon->getStats().floor_dbm >= -112 && mon->getStats().floor_dbm <= -110);
+}
+
+/*
+ * Interference bursts
+ */
+TEST(TestNoiseMonitor, Test_Burst) {
+  uint32_t t = noise(0, 10000);
+  t = noise(t, 2000, -80);
+  CHECK(mon->interference(t));
+  CHECK(mon->getStats().interference);
+  t = noise(t, 10000);
+  t = noise(t, 1000, -70);
+  t = noise(t, 10000);
+  const NoiseStats &stats = mon->getStats();
+  CHECK_EQUAL(2, stats.bursts);
+  CHECK_EQUAL(3000, stats.burst_ms);
+  CHECK(stats.peak_dbm >= -70 && stats.peak_dbm <= -68);
+  CHECK_FALSE(stats.interference);
+  CHECK_FALSE(mon->interference(t));
+  CHECK(mon->interference(t - 9000, 1000));
+
+  // Short interference does not raise the noise floor
+  CHECK(stats.floor_dbm >= -112 && stats.floor_dbm <= -110);
+}
+
+/*
+ * Samples taken while a frame was in flight are discarded
+ */
+TEST(TestNoiseMonitor, Test_Frame) {
+  uint32_t t = noise(0, 10000);
+  uint32_t samples = mon->getStats().samples;
+  mon->sample(-70, t);
+  mon->frame(t + 30);
+  t = noise(t + 250, 1000);
+  CHECK_EQUAL(0, mon->getStats().bursts);
+  CHECK_EQUAL(samples + 4, mon->getStats().samples);
+
+  // Frame received later - sample is kept
+  mon->sample(-70, t);
+  mon->frame(t + 200);
+  noise(t + 250, 1000);
+  CHECK_EQUAL(1, mon->getStats().bursts);
+}
+
+/*
+ * Old samples age out of the histogram
+ */
+TEST(TestNoiseMonitor, Test_Rolling) {
+  uint32_t t = noise(0, WINDOW);
+  t = noise(t, 2 * WINDOW, -104);
+  const NoiseStats &stats = mon->getStats();
+  CHECK(stats.floor_dbm >= -106 && stats.floor_dbm <= -104);
+  CHECK_EQUAL(0, stats.bursts);
+
+  mon->clear();
+  CHECK_EQUAL(0, stats.samples);
+  CHECK_EQUAL(-128, stats.floor_dbm);
+}
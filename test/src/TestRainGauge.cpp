@@ -37,6 +37,8 @@
 // 20240124 Fixed setTime(), fixed test cases / adjusted test cases to new algorithm
 // 20250323 Added tests for changing update rate (effective history buffer size) at run-time
 //          Updated tests for modified pastHour() return values
+// 20261016 Added test for pastMinutes()
+//          Added test for lastCycle(), ignored update
 //
 // ToDo: 
 // -
@@ -1924,3 +1926,98 @@ TEST(TestRainGaugeSetUpdateRate, Test_SetUpdateRateInvalid) {
   // rate=6: valid (default)
   CHECK_TRUE(rainGauge.setUpdateRate(6));
 }
+
+TEST_GROUP(TestRainGaugePastMinutes) {
+  void setup() {
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Rainfall during past minutes - hourly history (<= 60 min) and 24-hour history
+ */
+TEST(TestRainGaugePastMinutes, Test_PastMinutes) {
+  RainGauge rainGauge;
+  rainGauge.reset();
+
+  tm        tm;
+  time_t    ts;
+  bool      val;
+  int       nbins;
+  float     qual;
+
+  printf("< PastMinutes >\n");
+
+  DOUBLES_EQUAL(0, rainGauge.pastMinutes(60, &val, &nbins), TOLERANCE);
+  CHECK_FALSE(val);
+  CHECK_EQUAL(0, nbins);
+
+  // 0.1 mm every 6 minutes from 8:06 to 10:00
+  for (int i = 0; i <= 20; i++) {
+    char buf[20];
+    snprintf(buf, sizeof(buf), "2022-09-06 %d:%02d", 8 + i / 10, (i % 10) * 6);
+    setTime(buf, tm, ts);
+    rainGauge.update(ts, 10.0 + i * 0.1);
+  }
+
+  DOUBLES_EQUAL(0.1, rainGauge.pastMinutes(6, &val, &nbins), TOLERANCE);
+  CHECK_TRUE(val);
+  CHECK_EQUAL(1, nbins);
+  DOUBLES_EQUAL(0.2, rainGauge.pastMinutes(12), TOLERANCE);
+  DOUBLES_EQUAL(0.3, rainGauge.pastMinutes(13), TOLERANCE);
+  DOUBLES_EQUAL(rainGauge.pastHour(), rainGauge.pastMinutes(60), TOLERANCE);
+  DOUBLES_EQUAL(1.0, rainGauge.pastMinutes(60), TOLERANCE);
+
+  // 24-hour history: 8:00 -> 0.9, 9:00 -> 1.0, 10:00 -> 0.1
+  DOUBLES_EQUAL(1.1, rainGauge.pastMinutes(120, &val, &nbins), TOLERANCE);
+  CHECK_TRUE(val);
+  CHECK_EQUAL(2, nbins);
+  DOUBLES_EQUAL(2.0, rainGauge.pastMinutes(180), TOLERANCE);
+  DOUBLES_EQUAL(2.0, rainGauge.pastMinutes(240, &val, &nbins, &qual), TOLERANCE);
+  CHECK_FALSE(val);
+  CHECK_EQUAL(3, nbins);
+  DOUBLES_EQUAL(0.75, qual, TOLERANCE_QUAL);
+  DOUBLES_EQUAL(rainGauge.past24Hours(), rainGauge.pastMinutes(24 * 60), TOLERANCE);
+
+  DOUBLES_EQUAL(0, rainGauge.pastMinutes(0, &val), TOLERANCE);
+  CHECK_FALSE(val);
+  DOUBLES_EQUAL(0, rainGauge.pastMinutes(24 * 60 + 1, &val), TOLERANCE);
+  CHECK_FALSE(val);
+}
+
+/*
+ * Rainfall during last update cycle
+ */
+TEST(TestRainGaugePastMinutes, Test_LastCycle) {
+  RainGauge rainGauge;
+  rainGauge.reset();
+
+  tm        tm;
+  time_t    ts;
+
+  printf("< LastCycle >\n");
+
+  DOUBLES_EQUAL(-1, rainGauge.lastCycle(), TOLERANCE);
+
+  setTime("2022-09-06 8:00", tm, ts);
+  rainGauge.update(ts, 10.0);
+  DOUBLES_EQUAL(0, rainGauge.lastCycle(), TOLERANCE);
+
+  setTime("2022-09-06 8:06", tm, ts);
+  rainGauge.update(ts, 10.3);
+  DOUBLES_EQUAL(0.3, rainGauge.lastCycle(), TOLERANCE);
+
+  // Time set back - ignored
+  setTime("2022-09-06 8:00", tm, ts);
+  rainGauge.update(ts, 10.5);
+  DOUBLES_EQUAL(-1, rainGauge.lastCycle(), TOLERANCE);
+
+  setTime("2022-09-06 8:12", tm, ts);
+  rainGauge.update(ts, 10.6);
+  DOUBLES_EQUAL(0.3, rainGauge.lastCycle(), TOLERANCE);
+
+  rainGauge.reset();
+  DOUBLES_EQUAL(-1, rainGauge.lastCycle(), TOLERANCE);
+}
@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestRainGaugePrefs.cpp
+//
+// CppUTest unit tests for RainGauge with data stored in Preferences (RAINGAUGE_USE_PREFS)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#include "CppUTest/TestHarness.h"
+
+#define TOLERANCE 0.1
+#include "../mocks/log_w_mock.h"
+#include "RainGauge.h"
+
+static time_t ts(const char *time)
+{
+  struct tm tm = {0};
+  strptime(time, "%Y-%m-%d %H:%M", &tm);
+  tm.tm_isdst = -1;
+  return mktime(&tm);
+}
+
+TEST_GROUP(TestRainGaugePrefs) {
+  Preferences prefs;
+
+  void setup() {
+    prefs.clear();
+    Preferences::writes() = 0;
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Data is written once per update() by default,
+ * with a flush interval only if the interval has expired or flush() is called
+ */
+TEST(TestRainGaugePrefs, Test_WriteCoalescing) {
+  RainGauge rainGauge;
+
+  rainGauge.update(ts("2026-10-16 08:00"), 10.0);
+  rainGauge.update(ts("2026-10-16 08:06"), 10.2);
+  CHECK_EQUAL(2, Preferences::writes());
+
+  // Not modified - nothing to write
+  rainGauge.flush();
+  CHECK_EQUAL(2, Preferences::writes());
+
+  rainGauge.setFlushInterval(3600);
+  for (int min = 12; min < 60; min += 6) {
+    char buf[20];
+    snprintf(buf, sizeof(buf), "2026-10-16 08:%02d", min);
+    rainGauge.update(ts(buf), 10.2 + min / 60.0);
+  }
+  CHECK_EQUAL(2, Preferences::writes());
+
+  // Interval expired
+  rainGauge.update(ts("2026-10-16 09:06"), 11.5);
+  CHECK_EQUAL(3, Preferences::writes());
+
+  rainGauge.update(ts("2026-10-16 09:12"), 11.6);
+  CHECK_EQUAL(3, Preferences::writes());
+  rainGauge.flush();
+  CHECK_EQUAL(4, Preferences::writes());
+  rainGauge.flush();
+  CHECK_EQUAL(4, Preferences::writes());
+
+  // Unchanged update rate is not written
+  CHECK(rainGauge.setUpdateRate(6));
+  CHECK_EQUAL(4, Preferences::writes());
+  CHECK(rainGauge.setUpdateRate(12));
+  CHECK_EQUAL(5, Preferences::writes());
+
+  // Time set back - update is ignored, but flush interval is checked
+  rainGauge.update(ts("2026-10-16 09:30"), 11.7);
+  CHECK_EQUAL(5, Preferences::writes());
+  rainGauge.update(ts("2026-10-16 08:00"), 11.8);
+  DOUBLES_EQUAL(-1, rainGauge.lastCycle(), TOLERANCE);
+  CHECK_EQUAL(6, Preferences::writes());
+}
+
+/*
+ * A new instance (e.g. after a restart) continues with the stored data
+ */
+TEST(TestRainGaugePrefs, Test_Restore) {
+  RainGauge *rainGauge = new RainGauge;
+  rainGauge->setFlushInterval(3600);
+  float rain = 10.0;
+  for (int min = 0; min < 60; min += 6) {
+    char buf[20];
+    snprintf(buf, sizeof(buf), "2026-10-16 08:%02d", min);
+    rainGauge->update(ts(buf), rain);
+    rain += 0.3;
+  }
+  // Written before deep sleep
+  rainGauge->flush();
+  rainGauge->update(ts("2026-10-16 09:00"), rain);
+  float pastHour = rainGauge->pastHour();
+  float currentDay = rainGauge->currentDay();
+  float currentMonth = rainGauge->currentMonth();
+  delete rainGauge;
+
+  // Last update was lost
+  RainGauge restored;
+  restored.update(ts("2026-10-16 09:00"), rain);
+  DOUBLES_EQUAL(pastHour, restored.pastHour(), TOLERANCE);
+  DOUBLES_EQUAL(currentDay, restored.currentDay(), TOLERANCE);
+  DOUBLES_EQUAL(currentMonth, restored.currentMonth(), TOLERANCE);
+  DOUBLES_EQUAL(3.0, restored.pastHour(), TOLERANCE);
+}
+
+/*
+ * A corrupted record or a record with a different version is discarded
+ */
+TEST(TestRainGaugePrefs, Test_Invalid) {
+  {
+    RainGauge rainGauge;
+    rainGauge.update(ts("2026-10-16 08:00"), 10.0);
+    rainGauge.update(ts("2026-10-16 08:06"), 11.0);
+  }
+  uint8_t buf[PrefsBlob<nvData_t>::RECORD_SIZE];
+  CHECK_EQUAL(sizeof(buf), prefs.getBytes("nvData", buf, sizeof(buf)));
+
+  // Restored
+  {
+    RainGauge rainGauge;
+    rainGauge.update(ts("2026-10-16 08:12"), 11.5);
+    DOUBLES_EQUAL(1.5, rainGauge.pastHour(), TOLERANCE);
+  }
+
+  // Data modified
+  buf[10] ^= 0x01;
+  prefs.putBytes("nvData", buf, sizeof(buf));
+  {
+    RainGauge rainGauge;
+    rainGauge.update(ts("2026-10-16 08:12"), 11.5);
+    DOUBLES_EQUAL(0, rainGauge.pastHour(), TOLERANCE);
+  }
+
+  // Version changed (CRC valid)
+  nvData_t data;
+  CHECK(PrefsBlob<nvData_t>::load(prefs, "nvData", RAINGAUGE_NVDATA_VERSION, data) == PrefsBlob<nvData_t>::BLOB_OK);
+  CHECK(PrefsBlob<nvData_t>::save(prefs, "nvData", RAINGAUGE_NVDATA_VERSION + 1, data));
+  CHECK(PrefsBlob<nvData_t>::load(prefs, "nvData", RAINGAUGE_NVDATA_VERSION, data) == PrefsBlob<nvData_t>::BLOB_INVALID);
+  {
+    RainGauge rainGauge;
+    rainGauge.update(ts("2026-10-16 08:18"), 12.0);
+    DOUBLES_EQUAL(0, rainGauge.pastHour(), TOLERANCE);
+  }
+}
+
+/*
+ * Data stored in the previous layout (one key per member) is converted
+ */
+TEST(TestRainGaugePrefs, Test_Migration) {
+  time_t t = ts("2026-10-16 08:54");
+  struct tm tm;
+  localtime_r(&t, &tm);
+
+  prefs.putULong64("lastUpdate", t);
+  for (int i = 0; i < RAIN_HIST_SIZE; i++) {
+    char buf[7];
+    snprintf(buf, sizeof(buf), "hist%02d", i);
+    prefs.putShort(buf, 10);
+  }
+  for (int i = 0; i < RAIN_HIST_SIZE_24H; i++) {
+    char buf[10];
+    snprintf(buf, sizeof(buf), "h24h%02d", i);
+    prefs.putShort(buf, -1);
+  }
+  prefs.putBool("startupPrev", false);
+  prefs.putFloat("rainPreStartup", 10.0);
+  prefs.putUChar("tsDayBegin", tm.tm_wday);
+  prefs.putFloat("rainDayBegin", 8.0);
+  prefs.putUChar("tsWeekBegin", 1);
+  prefs.putFloat("rainWeekBegin", 7.0);
+  prefs.putUChar("wdayPrev", tm.tm_wday);
+  prefs.putUChar("tsMonthBegin", tm.tm_mon);
+  prefs.putFloat("rainMonthBegin", 5.0);
+  prefs.putFloat("rainPrev", 10.0);
+  prefs.putFloat("rainAcc", 0);
+  prefs.putUChar("updateRate", 6);
+
+  RainGauge rainGauge;
+  rainGauge.update(ts("2026-10-16 09:00"), 10.5);
+  DOUBLES_EQUAL(1.4, rainGauge.pastHour(), TOLERANCE);
+  DOUBLES_EQUAL(2.5, rainGauge.currentDay(), TOLERANCE);
+  DOUBLES_EQUAL(3.5, rainGauge.currentWeek(), TOLERANCE);
+  DOUBLES_EQUAL(5.5, rainGauge.currentMonth(), TOLERANCE);
+
+  // Old keys removed
+  CHECK_TRUE(prefs.isKey("nvData"));
+  CHECK_FALSE(prefs.isKey("rainPrev"));
+  CHECK_FALSE(prefs.isKey("hist00"));
+  CHECK_FALSE(prefs.isKey("h24h23"));
+  CHECK_FALSE(prefs.isKey("updateRate"));
+}
@@ -5,6 +5,7 @@
 #include "RollingCounter.h"
 #include <ctime>
 #include <cstring>
+#include <cstdlib>
 
 // Dummy subclass to access protected members and implement pure virtuals
 class TestableRollingCounter : public RollingCounter {
@@ -14,6 +15,9 @@ public:
     using RollingCounter::sumHistory;
     using RollingCounter::getLastUpdate;
     using RollingCounter::getUpdateRate;
+    using RollingCounter::History;
+    using RollingCounter::updateHistoryBufferCore;
+    using RollingCounter::sumRecent;
     TestableRollingCounter(float q = DEFAULT_QUALITY_THRESHOLD) : RollingCounter(q) {}
     void hist_init(int16_t value = -1) override {}
     float getQualityThreshold() const { return qualityThreshold; }
@@ -31,6 +35,7 @@ public:
         History h{ph.hist, ph.size, ph.updateRate};
         return sumHistory(h, valid, nbins, quality, scale);
     }
+    static bool expired(UpdateResult res) { return res == UPDATE_EXPIRED; }
 };
 
 TEST_GROUP(RollingCounterBasics) {
@@ -177,3 +182,212 @@ TEST(RollingCounterBasics, SumHistoryEffectiveBinsZero) {
     CHECK_EQUAL(0, nbins);
     DOUBLES_EQUAL(0.0f, quality, 0.0001);
 }
+
+/*
+ * Reference: markMissedEntries() with localtime_r() for each missed entry
+ */
+static void markMissedEntriesRef(int16_t* hist, size_t size, time_t lastUpdate,
+                                 time_t timestamp, uint8_t rate)
+{
+    for (time_t ts = lastUpdate + (rate * 60); ts < timestamp; ts += rate * 60) {
+        struct tm timeinfo;
+        localtime_r(&ts, &timeinfo);
+        int idx = (rate >= 60) ? timeinfo.tm_hour : timeinfo.tm_min / rate;
+        if (idx >= 0 && static_cast<size_t>(idx) < size)
+            hist[idx] = -1;
+    }
+}
+
+static uint32_t rand32(void)
+{
+    return (static_cast<uint32_t>(rand()) << 16) ^ static_cast<uint32_t>(rand());
+}
+
+static const char *const timeZones[] = {
+    "CET-1CEST,M3.5.0,M10.5.0/3",               // Central Europe
+    "EST5EDT,M3.2.0,M11.1.0",                   // US Eastern
+    "AEST-10AEDT,M10.1.0,M4.1.0/3",             // Australia Eastern (southern hemisphere)
+    "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0",     // Lord Howe Island (30 minutes DST)
+    "<+0545>-5:45",                             // Nepal
+    "UTC0"
+};
+
+static const uint8_t rates[] = {1, 2, 3, 4, 5, 6, 10, 12, 15, 20, 30, 60};
+
+TEST_GROUP(RollingCounterUtcOffset) {
+    char tzPrev[64];
+    bool tzSet;
+
+    void setup() {
+        const char *tz = getenv("TZ");
+        tzSet = (tz != nullptr);
+        if (tzSet) {
+            strncpy(tzPrev, tz, sizeof(tzPrev) - 1);
+            tzPrev[sizeof(tzPrev) - 1] = '\0';
+        }
+        srand(42);
+    }
+
+    void teardown() {
+        if (tzSet)
+            setenv("TZ", tzPrev, 1);
+        else
+            unsetenv("TZ");
+        tzset();
+    }
+};
+
+/*
+ * calculateIndex(time_t) with cached UTC offset vs. localtime_r()
+ * at random timestamps (2020...2030) in random order
+ */
+TEST(RollingCounterUtcOffset, CalculateIndexRandom) {
+    for (const char *tz : timeZones) {
+        setenv("TZ", tz, 1);
+        tzset();
+        TestableRollingCounter rc;
+        for (int i = 0; i < 5000; i++) {
+            time_t t = 1577836800 + static_cast<time_t>(rand32() % 315532800UL);
+            uint8_t rate = rates[rand() % sizeof(rates)];
+            struct tm tm;
+            localtime_r(&t, &tm);
+            CHECK_EQUAL_TEXT(rc.calculateIndex(tm, rate), rc.calculateIndex(t, rate), tz);
+
+            // Neighbourhood (cache hits)
+            t += rand() % 7200;
+            localtime_r(&t, &tm);
+            CHECK_EQUAL_TEXT(rc.calculateIndex(tm, rate), rc.calculateIndex(t, rate), tz);
+        }
+    }
+}
+
+/*
+ * Cached UTC offset is invalidated after the time zone has been changed
+ */
+TEST(RollingCounterUtcOffset, TimezoneChanged) {
+    setenv("TZ", "UTC0", 1);
+    tzset();
+    TestableRollingCounter rc;
+    time_t t = 1760000000; // 2025-10-09 08:53:20 UTC
+    CHECK_EQUAL(8, rc.calculateIndex(t, 60));
+
+    // Cache still valid for the previous time zone
+    setenv("TZ", "<+0545>-5:45", 1);
+    tzset();
+    CHECK_EQUAL(8, rc.calculateIndex(t + 60, 60));
+
+    rc.timezoneChanged();
+    struct tm tm;
+    localtime_r(&t, &tm);
+    CHECK_EQUAL(14, rc.calculateIndex(t, 60));
+    CHECK_EQUAL(rc.calculateIndex(tm, 6), rc.calculateIndex(t, 6));
+}
+
+/*
+ * markMissedEntries() vs. reference implementation for a sequence of
+ * updates with random intervals over one year (including DST transitions)
+ */
+TEST(RollingCounterUtcOffset, MarkMissedEntriesDifferential) {
+    for (const char *tz : timeZones) {
+        setenv("TZ", tz, 1);
+        tzset();
+        TestableRollingCounter rc;
+        time_t t = 1735689600 + rand() % 86400; // 2025-01-01
+        time_t end = t + 366 * 86400;
+        while (t < end) {
+            uint8_t rate = rates[rand() % sizeof(rates)];
+            size_t size = (rate >= 60) ? 24 : 60 / rate;
+            time_t next = t + 1 + rand() % (size * rate * 60);
+            int16_t hist[60];
+            int16_t ref[60];
+            for (size_t i = 0; i < 60; i++)
+                hist[i] = ref[i] = static_cast<int16_t>(i);
+            rc.markMissedEntries(hist, size, t, next, rate);
+            markMissedEntriesRef(ref, size, t, next, rate);
+            MEMCMP_EQUAL(ref, hist, sizeof(hist));
+            t = next;
+        }
+    }
+}
+
+/*
+ * Running sums (HistorySums) vs. summing up all bins
+ * for random sequences of updates (including missed updates and expiry)
+ */
+TEST(RollingCounterBasics, RunningSumsRandom) {
+    static const uint8_t rates[] = {6, 12, 60};
+    srand(4711);
+    for (uint8_t rate : rates) {
+        const size_t size = (rate == 60) ? 24 : 10;
+        TestableRollingCounter rc;
+        HistorySums sums;
+        int16_t hist[24];
+        for (size_t i = 0; i < size; i++)
+            hist[i] = -1;
+        TestableRollingCounter::History h = {hist, size, rate, &sums};
+        TestableRollingCounter::History ref = {hist, size, rate, nullptr};
+
+        time_t t = 1760000000;
+        for (int i = 0; i < 2000; i++) {
+            time_t next = t + rand() % (rate * 60 * ((rand() % 4 == 0) ? size + 2 : 2));
+            struct tm tm;
+            localtime_r(&next, &tm);
+            int idx = rc.calculateIndex(tm, rate);
+            int16_t delta = rand() % 50;
+            if (TestableRollingCounter::expired(
+                    rc.updateHistoryBufferCore(hist, size, idx, delta, next - t, next, t, rate, &sums))) {
+                for (size_t j = 0; j < size; j++)
+                    hist[j] = -1;
+                sums.valid = false;
+            }
+            t = next;
+
+            bool valid, validRef;
+            int nbins, nbinsRef;
+            float quality, qualityRef;
+            float res = rc.sumHistory(h, &valid, &nbins, &quality);
+            float resRef = rc.sumHistory(ref, &validRef, &nbinsRef, &qualityRef);
+            DOUBLES_EQUAL(resRef, res, 0.001);
+            CHECK_EQUAL(nbinsRef, nbins);
+            CHECK_EQUAL(validRef, valid);
+            DOUBLES_EQUAL(qualityRef, quality, 0.0001);
+
+            size_t bins = 1 + rand() % size;
+            res = rc.sumRecent(h, bins, idx, &valid, &nbins, &quality);
+            resRef = rc.sumRecent(ref, bins, idx, &validRef, &nbinsRef, &qualityRef);
+            DOUBLES_EQUAL(resRef, res, 0.001);
+            CHECK_EQUAL(nbinsRef, nbins);
+            CHECK_EQUAL(validRef, valid);
+            DOUBLES_EQUAL(qualityRef, quality, 0.0001);
+        }
+    }
+}
+
+/*
+ * sumRecent() - most recent bins, wrapping around
+ */
+TEST(RollingCounterBasics, SumRecent) {
+    TestableRollingCounter rc;
+    HistorySums sums;
+    int16_t hist[10] = {1, 2, -1, 4, 5, 6, 7, 8, 9, 10};
+    TestableRollingCounter::History h = {hist, 10, 6, &sums};
+    int nbins;
+    float quality;
+    DOUBLES_EQUAL(9.0, rc.sumRecent(h, 2, 4, nullptr, &nbins), 0.001);     // 4 + 5
+    CHECK_EQUAL(2, nbins);
+    DOUBLES_EQUAL(6.0, rc.sumRecent(h, 3, 3, nullptr, &nbins, &quality), 0.001);    // 2 + 4
+    CHECK_EQUAL(2, nbins);
+    DOUBLES_EQUAL(2.0 / 3, quality, 0.0001);
+    DOUBLES_EQUAL(22.0, rc.sumRecent(h, 4, 1, nullptr, &nbins), 0.001);    // 9 + 10 + 1 + 2
+    CHECK_EQUAL(4, nbins);
+    DOUBLES_EQUAL(52.0, rc.sumRecent(h, 20, 1, nullptr, &nbins), 0.001);   // limited to 10 bins
+    CHECK_EQUAL(9, nbins);
+
+    // Update rate 12 minutes: 5 bins
+    h.updateRate = 12;
+    sums.valid = false;
+    DOUBLES_EQUAL(12.0, rc.sumRecent(h, 5, 4, nullptr, &nbins), 0.001);
+    CHECK_EQUAL(4, nbins);
+    DOUBLES_EQUAL(0.0, rc.sumRecent(h, 1, 7, nullptr, &nbins), 0.001);    // out of bounds
+    CHECK_EQUAL(0, nbins);
+}
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestSensorIdIndex.cpp
+//
+// CppUTest unit tests for SensorIdIndex (sensor ID -> slot mapping)
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include <stdlib.h>
+#include "SensorIdIndex.h"
+
+TEST_GROUP(TestSensorIdIndex) {
+  SensorIdIndex index;
+
+  void setup() {
+    srand(42);
+  }
+
+  void teardown() {
+  }
+};
+
+/*
+ * Empty (not yet sized) index
+ */
+TEST(TestSensorIdIndex, Test_Empty) {
+  CHECK_EQUAL(-1, index.find(0x12345678));
+  CHECK_FALSE(index.insert(0x12345678, 0));
+}
+
+/*
+ * Insert, update and find
+ */
+TEST(TestSensorIdIndex, Test_InsertFind) {
+  index.resize(8);
+  CHECK_TRUE(index.insert(0x39582376, 0));
+  CHECK_TRUE(index.insert(0x00000001, 1));
+  CHECK_TRUE(index.insert(0xFFFFFFFF, 2));
+  CHECK_EQUAL(0, index.find(0x39582376));
+  CHECK_EQUAL(1, index.find(0x00000001));
+  CHECK_EQUAL(2, index.find(0xFFFFFFFF));
+  CHECK_EQUAL(-1, index.find(0x00000002));
+
+  // Update
+  CHECK_TRUE(index.insert(0x00000001, 5));
+  CHECK_EQUAL(5, index.find(0x00000001));
+
+  index.clear();
+  CHECK_EQUAL(-1, index.find(0x39582376));
+}
+
+/*
+ * Insertion fails if the table is more than half full; all entries are found until then
+ */
+TEST(TestSensorIdIndex, Test_Capacity) {
+  for (unsigned slots = 1; slots < 100; slots++) {
+    index.resize(slots);
+    uint32_t ids[256];
+    unsigned n = 0;
+    while (true) {
+      uint32_t id = ((uint32_t)rand() << 16) ^ rand();
+      if (!index.insert(id, n))
+        break;
+      ids[n++] = id;
+    }
+    CHECK(n >= slots);
+    CHECK(n <= 2 * slots + 2);
+    for (unsigned i = 0; i < n; i++)
+      CHECK_EQUAL((int)i, index.find(ids[i]));
+  }
+}
+
+/*
+ * Sequential IDs (e.g. 5-in-1 / 7-in-1 sensors with small ID range) do not cluster
+ */
+TEST(TestSensorIdIndex, Test_SequentialIds) {
+  index.resize(64);
+  for (uint32_t id = 0; id < 64; id++)
+    CHECK_TRUE(index.insert(id, id));
+  for (uint32_t id = 0; id < 64; id++)
+    CHECK_EQUAL((int)id, index.find(id));
+  CHECK_EQUAL(-1, index.find(64));
+}
@@ -0,0 +1,332 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestWeatherSensorDecoders.cpp
+//
+// CppUTest tests of the WeatherSensor message classifier and decoders
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include "WeatherSensor.h"
+#include "ReplayRadio.h"
+#include "DigestUtils.h"
+
+// Test messages (see examples/BresserWeatherSensorTest)
+static const uint8_t msg5in1[MSG_BUF_SIZE - 1] = {
+    0xEA, 0xEC, 0x7F, 0xEB, 0x5F, 0xEE, 0xEF, 0xFA, 0xFE, 0x76, 0xBB, 0xFA, 0xFF, 0x15, 0x13, 0x80, 0x14, 0xA0, 0x11,
+    0x10, 0x05, 0x01, 0x89, 0x44, 0x05, 0x00};
+
+// 6-in-1 Sensor - Wind, Battery, Temperature, Humidity, UV (type 1)
+static const uint8_t msg6in1[MSG_BUF_SIZE - 1] = {
+    0x54, 0x1B, 0x21, 0x10, 0x34, 0x27, 0x18, 0xFF, 0x88, 0xFF, 0x29, 0x28, 0x06, 0x42, 0x87, 0xFF, 0xF0, 0xC6, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+// High Precision Thermo Hygro Sensor (6-in-1 protocol, type 2)
+static const uint8_t msg6in1Hygro[MSG_BUF_SIZE - 1] = {
+    0x58, 0x8F, 0x65, 0x60, 0x96, 0x01, 0x2F, 0xBB, 0xBB, 0xBB, 0xBB, 0xB0, 0x24, 0x06, 0x42, 0xBB, 0xB0, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+// Pool Thermometer (6-in-1 protocol, type 3)
+static const uint8_t msg6in1Pool[MSG_BUF_SIZE - 1] = {
+    0x5D, 0x37, 0x22, 0x40, 0x08, 0x73, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x86, 0x00, 0x00, 0x00, 0x3C, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+// Soil Temperature/Moisture (6-in-1 protocol, type 4)
+static const uint8_t msg6in1Soil[MSG_BUF_SIZE - 1] = {
+    0xA1, 0x30, 0x74, 0x50, 0x85, 0x86, 0x49, 0xBB, 0xBB, 0xBB, 0xBB, 0xB0, 0x20, 0x56, 0x08, 0xBB, 0xB0, 0x62, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+// 7-in-1 Weather Sensor (type 1)
+static const uint8_t msg7in1[MSG_BUF_SIZE - 1] = {
+    0xC4, 0xD6, 0x3A, 0xC5, 0xBD, 0xFA, 0x18, 0xAA, 0xAA, 0xAA, 0xAA, 0xAB, 0xFC, 0xAA, 0x98, 0xDA, 0x89, 0xA3, 0x2F,
+    0xEC, 0xAF, 0x9A, 0xAA, 0xAA, 0xAA, 0x00};
+
+static const uint8_t msgLightning[MSG_BUF_SIZE - 1] = {
+    0x73, 0x69, 0xB5, 0x08, 0xAA, 0xA2, 0x90, 0xAA, 0xAA, 0xAA, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+static const uint8_t msgLeakage[MSG_BUF_SIZE - 1] = {
+    0xB3, 0xDA, 0x55, 0x57, 0x17, 0x40, 0x53, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB};
+
+TEST_GROUP(TestWeatherSensorDecoders) {
+  ReplayRadio *replay;
+  WeatherSensor *ws;
+
+  void setup() {
+    Preferences prefs;
+    prefs.clear();
+    replay = new ReplayRadio();
+    ws = new WeatherSensor();
+    ws->setRadio(replay);
+    CHECK_EQUAL(0, ws->begin(8));
+  }
+
+  void teardown() {
+    delete ws;
+    delete replay;
+  }
+
+  // Message is routed to exactly one decoder and decoded
+  void checkSingle(const uint8_t *msg, uint32_t id, uint8_t decoder) {
+    WeatherSensor::ClassifierStats prev = ws->classStats;
+    CHECK_EQUAL(DECODE_OK, ws->decodeMessage(msg, MSG_BUF_SIZE - 1));
+    CHECK_EQUAL(prev.single + 1, ws->classStats.single);
+    CHECK_EQUAL(prev.fallback, ws->classStats.fallback);
+    CHECK_EQUAL(prev.rejected, ws->classStats.rejected);
+    int slot = ws->findId(id);
+    CHECK(slot >= 0);
+    CHECK_EQUAL(decoder, ws->sensor[slot].decoder);
+  }
+};
+
+/*
+ * Each message type has exactly one candidate decoder
+ */
+TEST(TestWeatherSensorDecoders, Test_ClassifySingle) {
+  checkSingle(msg5in1, 0x13, DECODER_5IN1);
+  checkSingle(msg6in1, 0x21103427, DECODER_6IN1);
+  checkSingle(msg6in1Hygro, 0x65609601, DECODER_6IN1);
+  checkSingle(msg6in1Pool, 0x22400873, DECODER_6IN1);
+  checkSingle(msg6in1Soil, 0x74508586, DECODER_6IN1);
+  checkSingle(msg7in1, 0x906F, DECODER_7IN1);
+  checkSingle(msgLightning, 0x1FA2, DECODER_LIGHTNING);
+  checkSingle(msgLeakage, 0x55571740, DECODER_LEAKAGE);
+  CHECK_EQUAL(8, ws->classStats.single);
+}
+
+/*
+ * Type 1 is used by 6-in-1 and 7-in-1 sensors: the 7-in-1 candidate is only kept if
+ * its temperature/humidity fields are valid BCD
+ */
+TEST(TestWeatherSensorDecoders, Test_ClassifyType1) {
+  uint8_t msg[MSG_BUF_SIZE - 1];
+
+  // 6-in-1 checksum valid, 7-in-1 BCD fields valid - both decoders are tried
+  memcpy(msg, msg7in1, sizeof(msg));
+  uint8_t sum = 0;
+  for (int i = 2; i < 17; i++)
+    sum += msg[i];
+  msg[17] = 0xff - sum;
+  CHECK(DECODE_OK != ws->decodeMessage(msg, sizeof(msg)));
+  CHECK_EQUAL(1, ws->classStats.fallback);
+  CHECK_EQUAL(0, ws->classStats.single);
+
+  // 6-in-1 message: 7-in-1 BCD fields invalid - 6-in-1 decoder only
+  CHECK_EQUAL(DECODE_OK, ws->decodeMessage(msg6in1, sizeof(msg6in1)));
+  CHECK_EQUAL(1, ws->classStats.fallback);
+  CHECK_EQUAL(1, ws->classStats.single);
+
+  // 7-in-1 message with type 1 and valid BCD fields
+  CHECK_EQUAL(DECODE_OK, ws->decodeMessage(msg7in1, sizeof(msg7in1)));
+  CHECK_EQUAL(1, ws->classStats.fallback);
+  CHECK_EQUAL(2, ws->classStats.single);
+}
+
+/*
+ * Message without any matching signature is rejected (checksum error)
+ */
+TEST(TestWeatherSensorDecoders, Test_ClassifyRejected) {
+  uint8_t msg[MSG_BUF_SIZE - 1];
+
+  // Leakage sensor type, but ALARM == NALARM; 6-in-1 checksum not correctable
+  memcpy(msg, msgLeakage, sizeof(msg));
+  msg[7] = 0x30;
+  msg[17] ^= 0x11;
+  CHECK_EQUAL(DECODE_CHK_ERR, ws->decodeMessage(msg, sizeof(msg)));
+  CHECK_EQUAL(1, ws->classStats.rejected);
+  CHECK_EQUAL(0, ws->classStats.single);
+  CHECK_EQUAL(0, ws->classStats.fallback);
+  CHECK_EQUAL(-1, ws->findId(0x55571740));
+}
+
+/*
+ * Valid message for a disabled decoder is rejected, but not an error
+ */
+TEST(TestWeatherSensorDecoders, Test_ClassifyDisabled) {
+  ws->enDecoders = DECODER_5IN1 | DECODER_7IN1 | DECODER_LIGHTNING;
+  CHECK_EQUAL(DECODE_INVALID, ws->decodeMessage(msgLeakage, sizeof(msgLeakage)));
+  CHECK_EQUAL(DECODE_INVALID, ws->decodeMessage(msg6in1Hygro, sizeof(msg6in1Hygro)));
+  CHECK_EQUAL(2, ws->classStats.rejected);
+  CHECK_EQUAL(-1, ws->findId(0x55571740));
+}
+
+#if DIGEST_CORRECTION_BITS > 0
+/*
+ * 6-in-1: single bit error corrected, values identical to undamaged message
+ */
+TEST(TestWeatherSensorDecoders, Test_Correct6in1) {
+  uint8_t msg[MSG_BUF_SIZE - 1];
+  memcpy(msg, msg6in1, sizeof(msg));
+  msg[12] ^= 0x10;
+
+  CHECK_EQUAL(DECODE_OK_CORRECTED, ws->decodeMessage(msg, sizeof(msg)));
+  int slot = ws->findId(0x21103427);
+  CHECK(slot >= 0);
+  CHECK_EQUAL(1, ws->sensor[slot].rescued);
+  WeatherSensor::Weather w = ws->sensor[slot].w;
+  CHECK(w.temp_ok);
+
+  CHECK_EQUAL(DECODE_OK, ws->decodeMessage(msg6in1, sizeof(msg6in1)));
+  CHECK_EQUAL(1, ws->sensor[slot].rescued);
+  DOUBLES_EQUAL(ws->sensor[slot].w.temp_c, w.temp_c, 0.001);
+  CHECK_EQUAL(ws->sensor[slot].w.humidity, w.humidity);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_gust_meter_sec, w.wind_gust_meter_sec, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_avg_meter_sec, w.wind_avg_meter_sec, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_direction_deg, w.wind_direction_deg, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.uv, w.uv, 0.001);
+}
+
+/*
+ * 6-in-1: "corrected" message fails the checksum
+ */
+TEST(TestWeatherSensorDecoders, Test_Correct6in1Checksum) {
+  uint8_t msg[MSG_BUF_SIZE - 1];
+  memcpy(msg, msg6in1, sizeof(msg));
+  msg[5] ^= 0x01;
+
+  // Checksum (not covered by digest) deviates by a power of two - classified as 6-in-1
+  uint8_t sum = 0;
+  for (int i = 2; i < 17; i++)
+    sum += msg[i];
+  msg[17] = 0xff - 4 - sum;
+
+  CHECK_EQUAL(DECODE_DIG_ERR, ws->decodeMessage(msg, sizeof(msg)));
+  CHECK_EQUAL(1, ws->classStats.single);
+  CHECK_EQUAL(-1, ws->findId(0x21103427));
+}
+
+/*
+ * 7-in-1: single bit error corrected, values identical to undamaged message
+ */
+TEST(TestWeatherSensorDecoders, Test_Correct7in1) {
+  uint8_t msg[MSG_BUF_SIZE - 1];
+  memcpy(msg, msg7in1, sizeof(msg));
+  msg[11] ^= 0x02;
+
+  CHECK_EQUAL(DECODE_OK_CORRECTED, ws->decodeMessage(msg, sizeof(msg)));
+  int slot = ws->findId(0x906F);
+  CHECK(slot >= 0);
+  CHECK_EQUAL(1, ws->sensor[slot].rescued);
+  WeatherSensor::Weather w = ws->sensor[slot].w;
+  CHECK(w.temp_ok && w.rain_ok && w.wind_ok);
+
+  CHECK_EQUAL(DECODE_OK, ws->decodeMessage(msg7in1, sizeof(msg7in1)));
+  DOUBLES_EQUAL(ws->sensor[slot].w.temp_c, w.temp_c, 0.001);
+  CHECK_EQUAL(ws->sensor[slot].w.humidity, w.humidity);
+  DOUBLES_EQUAL(ws->sensor[slot].w.rain_mm, w.rain_mm, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_gust_meter_sec, w.wind_gust_meter_sec, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_avg_meter_sec, w.wind_avg_meter_sec, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_direction_deg, w.wind_direction_deg, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.light_lux, w.light_lux, 0.001);
+}
+
+/*
+ * 7-in-1: "corrected" message fails the BCD plausibility check
+ */
+TEST(TestWeatherSensorDecoders, Test_Correct7in1Plausibility) {
+  uint8_t msg[MSG_BUF_SIZE - 1];
+  uint8_t msgw[MSG_BUF_SIZE - 1];
+  for (size_t i = 0; i < sizeof(msg); i++)
+    msgw[i] = msg7in1[i] ^ 0xaa;
+
+  // Invalid rain BCD digit, valid digest
+  msgw[11] = (msgw[11] & 0x0f) | 0xa0;
+  uint16_t digest = lfsr_digest16_bitwise(&msgw[2], 23, 0x8810, 0xba95) ^ 0x6df1;
+  msgw[0] = digest >> 8;
+  msgw[1] = digest & 0xff;
+  for (size_t i = 0; i < sizeof(msg); i++)
+    msg[i] = msgw[i] ^ 0xaa;
+
+  msg[12] ^= 0x04;
+  CHECK_EQUAL(DECODE_DIG_ERR, ws->decodeMessage(msg, sizeof(msg)));
+  CHECK_EQUAL(-1, ws->findId(0x906F));
+
+  // Without bit error - no plausibility check
+  msg[12] ^= 0x04;
+  CHECK_EQUAL(DECODE_OK, ws->decodeMessage(msg, sizeof(msg)));
+  int slot = ws->findId(0x906F);
+  CHECK(slot >= 0);
+  CHECK_FALSE(ws->sensor[slot].w.rain_ok);
+  CHECK_EQUAL(0, ws->sensor[slot].rescued);
+}
+
+#endif
+
+#if PARITY_REPAIR_COLUMNS > 0
+/*
+ * 5-in-1: mismatching columns repaired, values identical to undamaged message
+ */
+TEST(TestWeatherSensorDecoders, Test_Repair5in1) {
+  uint8_t msg[MSG_BUF_SIZE - 1];
+  memcpy(msg, msg5in1, sizeof(msg));
+  msg[3] ^= 0x01;   // inverted copy of wind gust
+  msg[20] ^= 0x30;  // temperature
+  msg[22] ^= 0x70;  // humidity
+
+  CHECK_EQUAL(DECODE_OK_CORRECTED, ws->decodeMessage(msg, sizeof(msg)));
+  int slot = ws->findId(0x13);
+  CHECK(slot >= 0);
+  CHECK_EQUAL(1, ws->sensor[slot].rescued);
+  WeatherSensor::Weather w = ws->sensor[slot].w;
+  CHECK(w.temp_ok && w.humidity_ok && w.rain_ok && w.wind_ok);
+
+  CHECK_EQUAL(DECODE_OK, ws->decodeMessage(msg5in1, sizeof(msg5in1)));
+  CHECK_EQUAL(1, ws->sensor[slot].rescued);
+  DOUBLES_EQUAL(ws->sensor[slot].w.temp_c, w.temp_c, 0.001);
+  CHECK_EQUAL(ws->sensor[slot].w.humidity, w.humidity);
+  DOUBLES_EQUAL(ws->sensor[slot].w.rain_mm, w.rain_mm, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_gust_meter_sec, w.wind_gust_meter_sec, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_avg_meter_sec, w.wind_avg_meter_sec, 0.001);
+  DOUBLES_EQUAL(ws->sensor[slot].w.wind_direction_deg, w.wind_direction_deg, 0.001);
+}
+
+#endif
+
+/*
+ * 5-in-1: more than PARITY_REPAIR_COLUMNS mismatching columns - parity error
+ */
+TEST(TestWeatherSensorDecoders, Test_Repair5in1Limit) {
+  uint8_t msg[MSG_BUF_SIZE - 1];
+  memcpy(msg, msg5in1, sizeof(msg));
+  for (int i = 0; i <= PARITY_REPAIR_COLUMNS; i++)
+    msg[14 + i * 2] ^= 0x01;
+
+  CHECK_EQUAL(DECODE_PAR_ERR, ws->decodeMessage(msg, sizeof(msg)));
+  CHECK_EQUAL(1, ws->classStats.single);
+  CHECK_EQUAL(-1, ws->findId(0x13));
+}
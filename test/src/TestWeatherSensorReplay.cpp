@@ -0,0 +1,737 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestWeatherSensorReplay.cpp
+//
+// CppUTest tests of the WeatherSensor receive pipeline with ReplayRadio
+//
+// https://github.com/matthias-bs/BresserWeatherSensorReceiver
+//
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo: 
+// -
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CppUTest/TestHarness.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "WeatherSensor.h"
+#include "ReplayRadio.h"
+#include "DigestUtils.h"
+#include "ArduinoMock.h"
+
+// Bresser 6-in-1 messages (from rtl_433 bresser_6in1.c)
+static const uint8_t msg6in1_a[] = {0x5e, 0xaa, 0x18, 0x80, 0x02, 0xc3, 0x18, 0xfa, 0x8f, 0xfb,
+                                    0x27, 0x68, 0x11, 0x84, 0x81, 0xff, 0xf0, 0x72, 0x00};
+static const uint8_t msg6in1_b[] = {0xcc, 0x93, 0x18, 0x80, 0x02, 0xc3, 0x18, 0xff, 0xff, 0xff,
+                                    0x33, 0x68, 0x03, 0x04, 0x95, 0xff, 0xf0, 0x67, 0x3f};
+
+// 6-in-1 rain counter message (flags = 1) derived from msg6in1_b,
+// checksum and digest recalculated
+static void make6in1Rain(uint8_t *msg, uint32_t id = 0x188002C3UL)
+{
+  memcpy(msg, msg6in1_b, sizeof(msg6in1_b));
+  msg[2] = id >> 24;
+  msg[3] = (id >> 16) & 0xff;
+  msg[4] = (id >> 8) & 0xff;
+  msg[5] = id & 0xff;
+  msg[12] = 0xff;     // rain: 12.3 mm (inverted BCD)
+  msg[13] = 0xfe;
+  msg[14] = 0xdc;
+  msg[16] = 0xf1;     // flags
+  uint8_t sum = 0;
+  for (int i = 2; i < 17; i++)
+    sum += msg[i];
+  msg[17] = 0xff - sum;
+  uint16_t digest = lfsr_digest16_bitwise(&msg[2], 15, 0x8810, 0x5412);
+  msg[0] = digest >> 8;
+  msg[1] = digest & 0xff;
+}
+
+static ReplayRadio *replay;
+static ReplayRadio *replay2;
+
+// Replay is driven by simulated time (delay())
+static void pollReplay(void)
+{
+  replay->poll();
+  replay2->poll();
+}
+
+// Frame as read from the transceiver: last sync byte and message
+static void addFrame(uint32_t time, float rssi, const uint8_t *msg, size_t size, ReplayRadio *radio = nullptr,
+                     double carrier = 0)
+{
+  uint8_t frame[MSG_BUF_SIZE] = {0xD4};
+  memcpy(&frame[1], msg, size);
+  CHECK((radio ? radio : replay)->add(time, rssi, frame, MSG_BUF_SIZE, carrier));
+}
+
+TEST_GROUP(TestWeatherSensorReplay) {
+  WeatherSensor *ws;
+
+  void setup() {
+    Preferences prefs;
+    prefs.clear();
+    srand(42);
+    replay = new ReplayRadio();
+    replay2 = new ReplayRadio();
+    setDelayHook(pollReplay);
+    ws = new WeatherSensor();
+    ws->setRadio(replay);
+  }
+
+  void teardown() {
+    setDelayHook(nullptr);
+    delete ws;
+    delete replay;
+    delete replay2;
+  }
+};
+
+/*
+ * Frames are loaded from a file
+ */
+TEST(TestWeatherSensorReplay, Test_Load) {
+  char path[] = "/tmp/TestReplayXXXXXX";
+  int fd = mkstemp(path);
+  CHECK(fd >= 0);
+  FILE *fp = fdopen(fd, "w");
+  fprintf(fp, "# time rssi data\n");
+  fprintf(fp, "1000 -65.5 D4 5E AA 18 80 02 C3 18 FA 8F FB 27 68 11 84 81 FF F0 72 00\n");
+  fprintf(fp, "\n");
+  uint8_t msg[sizeof(msg6in1_b)];
+  make6in1Rain(msg);
+  fprintf(fp, "13000 -70 d4");
+  for (size_t i = 0; i < sizeof(msg); i++)
+    fprintf(fp, (i == 7) ? "%02x " : "%02x", msg[i]);
+  fprintf(fp, "  # comment\n");
+  fprintf(fp, "invalid line\n");
+  fclose(fp);
+
+  CHECK_EQUAL(2, replay->load(path));
+  CHECK_EQUAL(-1, replay->load("/nonexistent/replay.txt"));
+  unlink(path);
+
+  CHECK_EQUAL(1000, replay->nextTime());
+  CHECK_EQUAL(0, ws->begin());
+  DOUBLES_EQUAL(868.3, replay->getFrequency(), 0.001);
+
+  CHECK(ws->getData(30000, DATA_COMPLETE));
+  CHECK_EQUAL(0x188002C3UL, ws->sensor[0].sensor_id);
+  CHECK(ws->sensor[0].complete);
+  DOUBLES_EQUAL(12.3, ws->sensor[0].w.rain_mm, 0.01);
+  DOUBLES_EQUAL(-70.0, ws->sensor[0].rssi, 0.01);
+  CHECK(replay->done());
+}
+
+/*
+ * Frames are received and decoded by getData()
+ */
+TEST(TestWeatherSensorReplay, Test_GetData) {
+  uint8_t msg[sizeof(msg6in1_b)];
+  make6in1Rain(msg);
+  addFrame(1000, -65.5, msg6in1_a, sizeof(msg6in1_a));
+  addFrame(13000, -70, msg, sizeof(msg));
+  CHECK_EQUAL(0, ws->begin());
+
+  uint32_t ts = millis();
+  CHECK(ws->getData(5000));
+  CHECK(ws->sensor[0].valid);
+  CHECK_FALSE(ws->sensor[0].complete);
+  CHECK(millis() - ts >= 1000 && millis() - ts < 1100);
+
+  CHECK(ws->getData(30000, DATA_COMPLETE));
+  CHECK(ws->sensor[0].complete);
+  CHECK_EQUAL(2, replay->delivered);
+  CHECK_EQUAL(0, ws->getRxOverruns());
+  CHECK(ReplayRadio::MODE_STANDBY == replay->getMode());
+}
+
+/*
+ * Frames are lost while the receiver sleeps
+ */
+TEST(TestWeatherSensorReplay, Test_Sleep) {
+  addFrame(1000, -65.5, msg6in1_a, sizeof(msg6in1_a));
+  addFrame(2000, -65.5, msg6in1_b, sizeof(msg6in1_b));
+  CHECK_EQUAL(0, ws->begin());
+  ws->sleep();
+  CHECK(ReplayRadio::MODE_SLEEP == replay->getMode());
+
+  delay(3000);
+  CHECK_EQUAL(0, replay->delivered);
+  CHECK_EQUAL(2, replay->dropped);
+  CHECK_FALSE(ws->getData(1000));
+}
+
+/*
+ * One hour of sensor messages mixed with noise
+ */
+TEST(TestWeatherSensorReplay, Test_LoadTest) {
+  const uint32_t duration = 3600000UL;
+  uint8_t noise[MSG_BUF_SIZE - 1];
+  uint8_t msg[sizeof(msg6in1_b)];
+  make6in1Rain(msg);
+  for (uint32_t t = 1000; t < duration; t += 500) {
+    if (t % 12000 == 1000) {
+      addFrame(t, -70, ((t / 12000) & 1) ? msg : msg6in1_a, sizeof(msg));
+    } else if (t % 5000 == 3500) {
+      for (size_t i = 0; i < sizeof(noise); i++)
+        noise[i] = rand() & 0xFF;
+      addFrame(t, -95, noise, sizeof(noise));
+    }
+  }
+  CHECK_EQUAL(0, ws->begin());
+
+  unsigned calls = 0;
+  while (!replay->done()) {
+    ws->clearSlots();
+    if (!ws->getData(30000, DATA_COMPLETE))
+      break;
+    calls++;
+  }
+  CHECK(replay->done());
+  CHECK(calls >= duration / 24000 - 1);
+  CHECK_EQUAL(0, ws->getRxOverruns());
+  CHECK_EQUAL(0, replay->dropped);
+}
+
+#if PREDICT_SENSORS > 0
+/*
+ * Receive windows of getDataScheduled() around the learned transmissions,
+ * the receiver sleeps between calls
+ */
+TEST(TestWeatherSensorReplay, Test_Scheduled) {
+  const uint32_t duration = 1800000UL;
+  for (uint32_t t = 5300; t < duration; t += 12000 + (rand() % 41) - 20)
+    addFrame(t, -70, msg6in1_a, sizeof(msg6in1_a));
+  CHECK_EQUAL(0, ws->begin());
+
+  unsigned calls = 0;
+  while (replay->nextTime() < duration - 120000) {
+    ws->clearSlots();
+    CHECK(ws->getDataScheduled(60000));
+    calls++;
+    delay(50000);
+  }
+  CHECK(calls > 20);
+  CHECK(ws->schedStats.windows >= calls);
+  CHECK(ws->schedStats.rx_on_ms * 5 < ws->schedStats.total_ms);
+}
+
+#endif
+
+/*
+ * Two transceivers feeding the same sensor data slots (spatial diversity)
+ */
+TEST(TestWeatherSensorReplay, Test_SharedSlots) {
+  uint8_t msg[sizeof(msg6in1_b)];
+  make6in1Rain(msg, 0x18800321UL);
+  addFrame(1000, -92, msg6in1_a, sizeof(msg6in1_a));
+  addFrame(1010, -71, msg6in1_a, sizeof(msg6in1_a), replay2);
+  addFrame(3000, -75, msg, sizeof(msg), replay2);
+  CHECK(ws->addRadio(replay2));
+  CHECK_FALSE(ws->addRadio(replay2));
+  CHECK_EQUAL(0, ws->begin(2));
+  CHECK(ReplayRadio::MODE_RX == replay2->getMode());
+
+  CHECK(ws->getData(5000));
+#if DUP_CACHE_WINDOW_MS == 0
+  // Second copy decoded again
+  CHECK(ws->getData(5000));
+#endif
+  CHECK(ws->getData(5000));
+  CHECK_EQUAL(0x188002C3UL, ws->sensor[0].sensor_id);
+  CHECK_EQUAL(0x18800321UL, ws->sensor[1].sensor_id);
+  DOUBLES_EQUAL(12.3, ws->sensor[1].w.rain_mm, 0.01);
+#if DUP_CACHE_WINDOW_MS > 0
+  CHECK_EQUAL(1, ws->dupStats.hit);
+#endif
+  DOUBLES_EQUAL(-71.0, ws->sensor[0].rssi, 0.01);
+  CHECK_EQUAL(0, ws->getRxOverruns());
+  CHECK(replay->done());
+  CHECK(replay2->done());
+  CHECK(ReplayRadio::MODE_STANDBY == replay2->getMode());
+}
+
+/*
+ * Two independent instances with separate transceivers and sensor data slots
+ */
+TEST(TestWeatherSensorReplay, Test_TwoInstances) {
+  uint8_t msg[sizeof(msg6in1_b)];
+  make6in1Rain(msg, 0x18800321UL);
+  addFrame(1000, -70, msg6in1_a, sizeof(msg6in1_a));
+  addFrame(2000, -75, msg, sizeof(msg), replay2);
+
+  WeatherSensor ws2;
+  ws2.setRadio(replay2);
+  CHECK_EQUAL(0, ws->begin());
+  CHECK_EQUAL(0, ws2.begin());
+
+  // All interrupt handlers in use
+  ReplayRadio replay3;
+  WeatherSensor ws3;
+  ws3.setRadio(&replay3);
+  CHECK(ws3.begin() != 0);
+
+  // Frame received by the second instance's transceiver while the first one is waiting
+  CHECK(ws->getData(5000));
+  CHECK_FALSE(ws->getData(2000));
+  CHECK(ws2.getData(1000));
+  CHECK_EQUAL(0x188002C3UL, ws->sensor[0].sensor_id);
+  CHECK_EQUAL(0x18800321UL, ws2.sensor[0].sensor_id);
+  DOUBLES_EQUAL(12.3, ws2.sensor[0].w.rain_mm, 0.01);
+  CHECK_EQUAL(0, ws->getRxOverruns());
+  CHECK_EQUAL(0, ws2.getRxOverruns());
+}
+
+#if FREQ_TRACK_THRESHOLD_KHZ > 0
+/*
+ * Frequency correction is learned from the frequency error of received frames,
+ * stored in Preferences and restored by begin()
+ */
+TEST(TestWeatherSensorReplay, Test_FreqTracking) {
+  uint8_t msg[sizeof(msg6in1_b)];
+  make6in1Rain(msg);
+  const double carrier = 868.3 + 0.022;
+  for (uint32_t t = 1000; t < 600000; t += 12000)
+    addFrame(t, -70, (t / 12000) & 1 ? msg : msg6in1_a, sizeof(msg), nullptr, carrier);
+  CHECK_EQUAL(0, ws->begin());
+  DOUBLES_EQUAL(868.3, replay->getFrequency(), 0.0001);
+
+  while (!replay->done()) {
+    ws->clearSlots();
+    CHECK(ws->getData(15000));
+  }
+  float correction = ws->getFreqCorrection();
+  CHECK(correction > 22 - FREQ_TRACK_THRESHOLD_KHZ && correction <= 22);
+  DOUBLES_EQUAL(868.3 + correction / 1000, replay->getFrequency(), 0.0001);
+  DOUBLES_EQUAL(0, ws->getFreqCorrection(1), 0.001);
+
+  // Restored from Preferences, added to frequency offset
+  delete ws;
+  ws = new WeatherSensor();
+  ws->setRadio(replay);
+  CHECK_EQUAL(0, ws->begin(1, true, 0.1));
+  DOUBLES_EQUAL(correction, ws->getFreqCorrection(), 0.001);
+  DOUBLES_EQUAL(868.4 + correction / 1000, replay->getFrequency(), 0.0001);
+
+  ws->clearFreqCorrection();
+  DOUBLES_EQUAL(0, ws->getFreqCorrection(), 0.001);
+  DOUBLES_EQUAL(868.4, replay->getFrequency(), 0.0001);
+}
+
+#endif
+
+/*
+ * Frequency sweep with adaptive dwell time
+ */
+TEST(TestWeatherSensorReplay, Test_Sweep) {
+  const double carrier = 868.3 + 0.045;
+  for (uint32_t t = 1000; t < 1200000; t += 4000)
+    addFrame(t, -70, msg6in1_a, sizeof(msg6in1_a), nullptr, carrier);
+  replay->bandwidth = 100;
+  CHECK_EQUAL(0, ws->begin());
+
+  WeatherSensor::SweepResult res[16];
+  uint32_t ts = millis();
+  int count = ws->sweepFrequency(res, 16, -100, 150, 25, 60000, 3);
+  CHECK_EQUAL(11, count);
+  CHECK_EQUAL(-100, res[0].offset_khz);
+  CHECK_EQUAL(150, res[10].offset_khz);
+
+  // No reception: max. dwell time
+  CHECK_EQUAL(0, res[0].decoded);
+  CHECK_EQUAL(0, res[0].errors);
+  CHECK(res[0].dwell_ms >= 60000);
+  DOUBLES_EQUAL(-200, res[0].rssi_avg, 0.01);
+
+  // Edge of the receiver bandwidth: digest errors
+  CHECK_EQUAL(0, res[4].decoded);
+  CHECK(res[4].errors > 0);
+
+  // Reception: dwell until min_decoded frames
+  for (int i = 5; i <= 7; i++) {
+    CHECK_EQUAL(3, res[i].decoded);
+    CHECK(res[i].dwell_ms < 15000);
+    DOUBLES_EQUAL(-70, res[i].rssi_avg, 0.01);
+    DOUBLES_EQUAL(-70, res[i].rssi_max, 0.01);
+  }
+  CHECK_EQUAL(0, res[9].decoded);
+  CHECK(millis() - ts < 11 * 60000);
+
+  int best;
+  CHECK(WeatherSensor::sweepBest(res, count, best));
+  CHECK_EQUAL(50, best);
+  CHECK_FALSE(WeatherSensor::sweepBest(res, 4, best));
+
+  // Previous frequency restored
+  DOUBLES_EQUAL(868.3, replay->getFrequency(), 0.0001);
+  DOUBLES_EQUAL(0, ws->getFreqCorrection(), 0.001);
+  CHECK(ReplayRadio::MODE_STANDBY == replay->getMode());
+}
+
+#if (LINK_STATS_SENSORS > 0) && (PREDICT_SENSORS > 0)
+/*
+ * Link quality statistics: RSSI, lost transmissions and errors attributed by sensor ID
+ */
+TEST(TestWeatherSensorReplay, Test_LinkStats) {
+  // Sensor ID not used in other tests - transmit intervals are retained by the library
+  uint8_t msg[sizeof(msg6in1_b)];
+  for (uint32_t i = 0; i < 50; i++) {
+    if (i % 5 == 4)
+      continue;
+    make6in1Rain(msg, 0x18800456UL);
+    if (i % 7 == 6) {
+      // Digest damaged
+      msg[0] ^= 0x5A;
+      msg[1] ^= 0xA5;
+    }
+    addFrame(1000 + i * 12000, (i & 1) ? -68 : -72, msg, sizeof(msg));
+  }
+  // Unknown sensor
+  make6in1Rain(msg, 0x11223344UL);
+  msg[1] ^= 0xA5;
+  addFrame(1000 + 50 * 12000, -80, msg, sizeof(msg));
+  CHECK_EQUAL(0, ws->begin());
+
+  while (!replay->done()) {
+    ws->clearSlots();
+    ws->getData(30000);
+  }
+
+  POINTERS_EQUAL(nullptr, ws->getLinkStats(0x11223344UL));
+  const LinkStats *e = ws->getLinkStats(0x18800456UL);
+  CHECK(e != nullptr);
+  DOUBLES_EQUAL(-70, e->rssi_mean, 0.5);
+  DOUBLES_EQUAL(2, e->rssiStd(), 0.5);
+  CHECK_EQUAL(34, e->received);
+  CHECK_EQUAL(48, e->expected);
+  CHECK_EQUAL(6, e->dig_err);
+  CHECK_EQUAL(0, e->par_err);
+  CHECK_EQUAL(0, e->chk_err);
+  CHECK_EQUAL(7, ws->errStats.dig);
+  CHECK_EQUAL(1, ws->errStats.unattributed);
+}
+
+#endif
+
+#if NOISE_SAMPLE_INTERVAL_MS > 0
+/*
+ * Noise floor and interference bursts sampled while waiting for messages
+ */
+TEST(TestWeatherSensorReplay, Test_Noise) {
+  for (uint32_t t = 1000; t < 180000; t += 12000)
+    addFrame(t, -70, msg6in1_a, sizeof(msg6in1_a));
+  replay->addInterference(60000, 5000, -85);
+  CHECK_EQUAL(0, ws->begin());
+
+  while (!replay->done()) {
+    ws->clearSlots();
+    ws->getData(30000);
+  }
+
+  NoiseStats stats = ws->getNoiseStats();
+  CHECK(stats.samples > 500);
+  CHECK(stats.floor_dbm >= -114 && stats.floor_dbm <= -110);
+  CHECK(stats.p90_dbm >= -110 && stats.p90_dbm <= -106);
+  CHECK_EQUAL(1, stats.bursts);
+  CHECK(stats.burst_ms >= 4500 && stats.burst_ms <= 5000);
+  CHECK_EQUAL(-85, stats.peak_dbm);
+  CHECK_FALSE(stats.interference);
+
+  // Frame received during interference
+  CHECK_EQUAL(1, ws->errStats.dig);
+  CHECK_EQUAL(1, ws->errStats.interference);
+
+  // Not available
+  CHECK_EQUAL(0, ws->getNoiseStats(1).samples);
+}
+
+#endif
+
+#if COMBINE_WINDOW_MS > 0
+// Copy of msg6in1_a with two bit errors
+static void damage6in1(uint8_t *msg, unsigned pos1, uint8_t mask1, unsigned pos2, uint8_t mask2)
+{
+  memcpy(msg, msg6in1_a, sizeof(msg6in1_a));
+  msg[pos1] ^= mask1;
+  msg[pos2] ^= mask2;
+}
+
+/*
+ * Three damaged copies of a transmission are combined by majority vote
+ */
+TEST(TestWeatherSensorReplay, Test_Combine3) {
+  // Four bit errors per copy - the first two copies differ in more than COMBINE_MAX_BITS
+  uint8_t msg[3][sizeof(msg6in1_a)];
+  damage6in1(msg[0], 8, 0x03, 10, 0x30);
+  damage6in1(msg[1], 9, 0x0C, 12, 0xC0);
+  damage6in1(msg[2], 11, 0x06, 13, 0x18);
+  for (int i = 0; i < 3; i++)
+    addFrame(1000 + i * 100, -70, msg[i], sizeof(msg[i]));
+  CHECK_EQUAL(0, ws->begin());
+
+  CHECK(ws->getData(5000));
+  CHECK_EQUAL(0x188002C3UL, ws->sensor[0].sensor_id);
+  DOUBLES_EQUAL(11.8, ws->sensor[0].w.temp_c, 0.01);
+  CHECK_EQUAL(81, ws->sensor[0].w.humidity);
+  CHECK_EQUAL(1, ws->combined);
+  CHECK_EQUAL(2, ws->errStats.dig + ws->errStats.chk);
+  CHECK(replay->done());
+  CHECK_EQUAL(3, ws->classStats.single + ws->classStats.fallback + ws->classStats.rejected);
+}
+
+/*
+ * Two damaged copies of a transmission - combinations of the differing bits are tried
+ */
+TEST(TestWeatherSensorReplay, Test_Combine2) {
+  uint8_t msg[2][sizeof(msg6in1_a)];
+  damage6in1(msg[0], 8, 0x01, 10, 0x10);
+  damage6in1(msg[1], 9, 0x04, 12, 0x40);
+  addFrame(1000, -70, msg[0], sizeof(msg[0]));
+  addFrame(1100, -75, msg[1], sizeof(msg[1]));
+  CHECK_EQUAL(0, ws->begin());
+
+  CHECK(ws->getData(5000));
+  CHECK_EQUAL(0x188002C3UL, ws->sensor[0].sensor_id);
+  DOUBLES_EQUAL(11.8, ws->sensor[0].w.temp_c, 0.01);
+  CHECK_EQUAL(81, ws->sensor[0].w.humidity);
+  CHECK_EQUAL(1, ws->combined);
+  CHECK_EQUAL(1, ws->errStats.dig + ws->errStats.chk);
+
+  // Candidates are not counted by the classifier statistics
+  CHECK_EQUAL(2, ws->classStats.single + ws->classStats.fallback + ws->classStats.rejected);
+}
+
+/*
+ * Two damaged copies of a transmission from an excluded sensor - the first valid
+ * candidate is accepted (DECODE_SKIP)
+ */
+TEST(TestWeatherSensorReplay, Test_CombineSkip) {
+  uint8_t msg[2][sizeof(msg6in1_a)];
+  damage6in1(msg[0], 8, 0x01, 10, 0x10);
+  damage6in1(msg[1], 9, 0x04, 12, 0x40);
+  addFrame(1000, -70, msg[0], sizeof(msg[0]));
+  addFrame(1100, -75, msg[1], sizeof(msg[1]));
+  CHECK_EQUAL(0, ws->begin());
+  uint8_t exc[] = {0x18, 0x80, 0x02, 0xC3};
+  ws->setSensorsExc(exc, sizeof(exc));
+
+  CHECK_FALSE(ws->getData(5000));
+  CHECK(replay->done());
+  CHECK_EQUAL(0, ws->combined);
+  CHECK_EQUAL(1, ws->errStats.dig + ws->errStats.chk);
+  CHECK_FALSE(ws->sensor[0].valid);
+}
+
+/*
+ * Buffered copies are combined by capture time, not by decoding time
+ */
+TEST(TestWeatherSensorReplay, Test_CombineBuffered) {
+  uint8_t msg[2][sizeof(msg6in1_a)];
+  damage6in1(msg[0], 8, 0x01, 10, 0x10);
+  damage6in1(msg[1], 9, 0x04, 12, 0x40);
+  // Second copy outside of the time window
+  addFrame(1000, -70, msg[0], sizeof(msg[0]));
+  addFrame(1000 + COMBINE_WINDOW_MS + 100, -70, msg[1], sizeof(msg[1]));
+  CHECK_EQUAL(0, ws->begin());
+
+  // Frames are stored in the receive buffer, but not decoded yet
+  for (int i = 0; i < 2; i++) {
+    while (!ws->receiveFrame())
+      delay(10);
+  }
+  CHECK(replay->done());
+
+  CHECK_FALSE(ws->getData(100));
+  CHECK_EQUAL(0, ws->combined);
+  CHECK_EQUAL(2, ws->errStats.dig + ws->errStats.chk);
+  CHECK_FALSE(ws->sensor[0].valid);
+}
+
+#endif
+
+/*
+ * Sensor include/exclude lists from JSON strings
+ */
+TEST(TestWeatherSensorReplay, Test_SensorsJson) {
+  CHECK_EQUAL(0, ws->begin());
+  uint8_t buf[8];
+
+  ws->setSensorsExcJson("{\"ids\": [\"0x188002C3\", \"0x00001234\"]}");
+  CHECK_EQUAL(8, ws->getSensorsExc(buf));
+  CHECK_EQUAL(0x00, buf[0]);
+  CHECK_EQUAL(0x34, buf[3]);
+  CHECK_EQUAL(0x18, buf[4]);
+  CHECK_EQUAL(0xC3, buf[7]);
+
+  // Empty list
+  ws->setSensorsExcJson("{\"ids\": []}");
+  CHECK_EQUAL(0, ws->getSensorsExc(buf));
+
+  // Lists are restored from Preferences
+  ws->setSensorsIncJson("{\"ids\": [\"0xDEADBEEF\"]}");
+  CHECK_EQUAL(0, ws->begin());
+  CHECK_EQUAL(4, ws->getSensorsInc(buf));
+  CHECK_EQUAL(0xDE, buf[0]);
+  CHECK_EQUAL(0xEF, buf[3]);
+}
+
+// Check if sensor with given ID is stored
+static bool isStored(WeatherSensor *ws, uint32_t id)
+{
+  for (size_t i = 0; i < ws->sensor.size(); i++) {
+    if (ws->sensor[i].valid && (ws->sensor[i].sensor_id == id))
+      return true;
+  }
+  return false;
+}
+
+/*
+ * Slot eviction disabled (default) - new sensor is rejected if all slots are in use
+ */
+TEST(TestWeatherSensorReplay, Test_EvictNever) {
+  uint8_t msg[sizeof(msg6in1_b)];
+  make6in1Rain(msg, 0x18800601UL);
+  addFrame(1000, -60, msg, sizeof(msg));
+  make6in1Rain(msg, 0x18800602UL);
+  addFrame(13000, -50, msg, sizeof(msg));
+  CHECK_EQUAL(0, ws->begin(1));
+  CHECK_EQUAL(SLOT_EVICT_NEVER, ws->evictionPolicy);
+
+  while (!replay->done())
+    ws->getData(5000);
+
+  CHECK(isStored(ws, 0x18800601UL));
+  CHECK_FALSE(isStored(ws, 0x18800602UL));
+  CHECK_EQUAL(0, ws->slotStats.evicted);
+  CHECK_EQUAL(1, ws->slotStats.rejected);
+}
+
+/*
+ * Least recently received sensor is evicted
+ */
+TEST(TestWeatherSensorReplay, Test_EvictLru) {
+  uint8_t msg[3][sizeof(msg6in1_b)];
+  make6in1Rain(msg[0], 0x18800611UL);
+  make6in1Rain(msg[1], 0x18800612UL);
+  make6in1Rain(msg[2], 0x18800613UL);
+  addFrame(1000, -60, msg[0], sizeof(msg[0]));
+  addFrame(13000, -80, msg[1], sizeof(msg[1]));
+  // First sensor received again - second sensor is the least recently received
+  addFrame(25000, -60, msg[0], sizeof(msg[0]));
+  addFrame(37000, -70, msg[2], sizeof(msg[2]));
+  CHECK_EQUAL(0, ws->begin(2));
+  ws->evictionPolicy = SLOT_EVICT_LRU;
+
+  while (!replay->done())
+    ws->getData(5000);
+
+  CHECK(isStored(ws, 0x18800611UL));
+  CHECK_FALSE(isStored(ws, 0x18800612UL));
+  CHECK(isStored(ws, 0x18800613UL));
+  CHECK_EQUAL(0x18800613UL, ws->sensor[1].sensor_id);
+  CHECK_EQUAL(1, ws->slotStats.evicted);
+  CHECK_EQUAL(0, ws->slotStats.rejected);
+}
+
+/*
+ * Sensor with lowest RSSI is evicted if the new sensor's RSSI is higher
+ */
+TEST(TestWeatherSensorReplay, Test_EvictRssi) {
+  uint8_t msg[4][sizeof(msg6in1_b)];
+  make6in1Rain(msg[0], 0x18800621UL);
+  make6in1Rain(msg[1], 0x18800622UL);
+  make6in1Rain(msg[2], 0x18800623UL);
+  make6in1Rain(msg[3], 0x18800624UL);
+  addFrame(1000, -80, msg[0], sizeof(msg[0]));
+  addFrame(13000, -60, msg[1], sizeof(msg[1]));
+  // RSSI not higher than lowest RSSI in slots - rejected
+  addFrame(25000, -80, msg[2], sizeof(msg[2]));
+  addFrame(37000, -70, msg[3], sizeof(msg[3]));
+  CHECK_EQUAL(0, ws->begin(2));
+  ws->evictionPolicy = SLOT_EVICT_RSSI;
+
+  CHECK(ws->getData(5000));
+  CHECK(ws->getData(15000));
+  CHECK_FALSE(ws->getData(15000));
+  CHECK_EQUAL(0, ws->slotStats.evicted);
+  CHECK_EQUAL(1, ws->slotStats.rejected);
+  CHECK_FALSE(isStored(ws, 0x18800623UL));
+
+  CHECK(ws->getData(15000));
+  CHECK_FALSE(isStored(ws, 0x18800621UL));
+  CHECK(isStored(ws, 0x18800622UL));
+  CHECK_EQUAL(0x18800624UL, ws->sensor[0].sensor_id);
+  DOUBLES_EQUAL(-70, ws->sensor[0].rssi, 0.01);
+  CHECK_EQUAL(1, ws->slotStats.evicted);
+  CHECK(replay->done());
+}
+
+/*
+ * Sensors from the include list are never evicted
+ */
+TEST(TestWeatherSensorReplay, Test_EvictPinned) {
+  uint8_t msg[3][sizeof(msg6in1_b)];
+  make6in1Rain(msg[0], 0x18800631UL);
+  make6in1Rain(msg[1], 0x18800632UL);
+  make6in1Rain(msg[2], 0x18800633UL);
+  addFrame(1000, -60, msg[0], sizeof(msg[0]));
+  addFrame(13000, -60, msg[1], sizeof(msg[1]));
+  addFrame(25000, -60, msg[2], sizeof(msg[2]));
+  CHECK_EQUAL(0, ws->begin(2));
+  ws->evictionPolicy = SLOT_EVICT_LRU;
+
+  CHECK(ws->getData(5000));
+  CHECK(ws->getData(15000));
+
+  // Least recently received sensor is pinned - the other one is evicted
+  uint8_t inc[] = {0x18, 0x80, 0x06, 0x31, 0x18, 0x80, 0x06, 0x33};
+  ws->setSensorsInc(inc, sizeof(inc));
+  CHECK(ws->getData(15000));
+  CHECK(isStored(ws, 0x18800631UL));
+  CHECK_FALSE(isStored(ws, 0x18800632UL));
+  CHECK(isStored(ws, 0x18800633UL));
+  CHECK_EQUAL(1, ws->slotStats.evicted);
+
+  // All slots pinned - new sensor from include list is rejected
+  uint8_t inc2[] = {0x18, 0x80, 0x06, 0x31, 0x18, 0x80, 0x06, 0x33, 0x18, 0x80, 0x06, 0x34};
+  ws->setSensorsInc(inc2, sizeof(inc2));
+  make6in1Rain(msg[0], 0x18800634UL);
+  addFrame(37000, -50, msg[0], sizeof(msg[0]));
+  CHECK_FALSE(ws->getData(15000));
+  CHECK(isStored(ws, 0x18800631UL));
+  CHECK(isStored(ws, 0x18800633UL));
+  CHECK_EQUAL(1, ws->slotStats.evicted);
+  CHECK_EQUAL(1, ws->slotStats.rejected);
+}